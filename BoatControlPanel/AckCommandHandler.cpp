@@ -2,8 +2,8 @@
 
 const char AckCommand[] = "ACK";
 
-AckCommandHandler::AckCommandHandler(SerialCommandManager* computerCommandManager, NextionControl* nextionControl, WarningManager* warningManager)
-    : BaseBoatCommandHandler(computerCommandManager, nextionControl, warningManager)
+AckCommandHandler::AckCommandHandler(SerialCommandManager* computerCommandManager, WarningManager* warningManager)
+    : BaseBoatCommandHandler(computerCommandManager, warningManager)
 {
 }
 
@@ -13,14 +13,9 @@ bool AckCommandHandler::processHeartbeatAck(SerialCommandManager* sender, const
     if (key != SystemHeartbeatCommand || !value.equalsIgnoreCase(AckSuccess))
         return false;
 
-    if (_warningManager)
-    {
-        // Notify the warning manager to update heartbeat timestamp
-        _warningManager->notifyHeartbeatAck();
-	}
-
-    // Notify the current page about the heartbeat acknowledgement
-    notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::HeartbeatAck), nullptr);
+    // Notify subscribers (WarningManager updates its heartbeat timestamp)
+    HeartbeatAckEvent event = { millis() };
+    publishEvent(event);
 
     if (sender)
     {
@@ -79,8 +74,8 @@ bool AckCommandHandler::handleCommand(SerialCommandManager* sender, const String
             uint8_t relayIndex = params[1].key.toInt();
             bool isOn = parseBooleanValue(params[1].value);
             
-            RelayStateUpdate update = { relayIndex, isOn };
-            notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::RelayState), &update);
+            RelayStateEvent event = { relayIndex, isOn };
+            publishEvent(event);
         }
     }
     else if (key == RelayStatusGet && val.equalsIgnoreCase(AckSuccess))
@@ -90,8 +85,8 @@ bool AckCommandHandler::handleCommand(SerialCommandManager* sender, const String
             uint8_t relayIndex = params[1].key.toInt();
             bool isOn = parseBooleanValue(params[1].value);
 
-            RelayStateUpdate update = { relayIndex, isOn };
-            notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::RelayState), &update);
+            RelayStateEvent event = { relayIndex, isOn };
+            publishEvent(event);
         }
         else
         {
@@ -100,16 +95,18 @@ bool AckCommandHandler::handleCommand(SerialCommandManager* sender, const String
     }
     else if (key == SoundSignalActive && val.equalsIgnoreCase(AckSuccess))
     {
-        if (paramCount == 1)
+        // Format: ACK:H1=ok:<SoundType>=<SoundState>
+        if (paramCount >= 2 && isAllDigits(params[1].key) && isAllDigits(params[1].value))
         {
-            bool isOn = parseBooleanValue(params[1].value);
+            uint8_t soundType = params[1].key.toInt();
+            uint8_t soundState = params[1].value.toInt();
 
-            BoolStateUpdate update = { isOn };
-            notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::SoundSignal), &update);
+            SoundSignalEvent event = { soundType, soundState, soundType != 0 };
+            publishEvent(event);
         }
         else
         {
-            sendDebugMessage("Invalid R4 ACK format: paramCount=" + String(paramCount), AckCommand);
+            sendDebugMessage("Invalid H1 ACK format: paramCount=" + String(paramCount), AckCommand);
         }
     }
 	else
@@ -8,8 +8,8 @@
 class AckCommandHandler : public BaseBoatCommandHandler
 {
 public:
-    // Constructor: pass the NextionControl pointer so we can notify the current page
-    explicit AckCommandHandler(SerialCommandManager* computerCommandManager, NextionControl* nextionControl, WarningManager* warningManager);
+    // Constructor: updates are published on the EventBus for any interested subscriber
+    explicit AckCommandHandler(SerialCommandManager* computerCommandManager, WarningManager* warningManager);
 
     bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
     const String* supportedCommands(size_t& count) const override;
@@ -0,0 +1,213 @@
+#include "AsyncI2C.h"
+
+#if defined(__AVR__)
+#include <util/twi.h>
+
+// TWCR values, the interrupt enable bit is left clear while we own the bus
+constexpr uint8_t TwiStart = _BV(TWINT) | _BV(TWSTA) | _BV(TWEN);
+constexpr uint8_t TwiNext = _BV(TWINT) | _BV(TWEN);
+constexpr uint8_t TwiNextAck = _BV(TWINT) | _BV(TWEN) | _BV(TWEA);
+constexpr uint8_t TwiStop = _BV(TWINT) | _BV(TWEN) | _BV(TWSTO);
+
+// Idle state the Wire library expects, interrupt driven and ready to ACK
+constexpr uint8_t TwiWireIdle = _BV(TWEN) | _BV(TWIE) | _BV(TWEA);
+#endif
+
+AsyncI2C::AsyncI2C()
+    :
+#if defined(__AVR__)
+      _step(Step::Start),
+      _address(0),
+      _index(0),
+      _lastProgressUs(0),
+#endif
+      _state(AsyncI2CState::Idle),
+      _buffer(nullptr),
+      _length(0),
+      _errorCount(0)
+{
+}
+
+#if defined(__AVR__)
+
+bool AsyncI2C::startRead(uint8_t address, uint8_t* buffer, uint8_t length)
+{
+    if (_state == AsyncI2CState::Busy || !buffer || length == 0)
+        return false;
+
+    _address = address;
+    _buffer = buffer;
+    _length = length;
+    _index = 0;
+    _step = Step::Start;
+    _state = AsyncI2CState::Busy;
+    _lastProgressUs = micros();
+
+    TWCR = TwiStart;
+    return true;
+}
+
+AsyncI2CState AsyncI2C::poll()
+{
+    if (_state == AsyncI2CState::Busy)
+    {
+        step();
+    }
+
+    if (_state == AsyncI2CState::Busy)
+        return AsyncI2CState::Busy;
+
+    // Report the result once
+    AsyncI2CState result = _state;
+    _state = AsyncI2CState::Idle;
+    return result;
+}
+
+void AsyncI2C::step()
+{
+    unsigned long nowUs = micros();
+
+    if (_step == Step::Stop)
+    {
+        // Hardware clears TWSTO once the stop condition is on the bus
+        if (TWCR & _BV(TWSTO))
+        {
+            if (nowUs - _lastProgressUs >= AsyncI2CTimeoutUs)
+                finish(AsyncI2CState::Error);
+
+            return;
+        }
+
+        TWCR = TwiWireIdle;
+
+        if (_index == _length)
+        {
+            _state = AsyncI2CState::Complete;
+        }
+        else
+        {
+            _state = AsyncI2CState::Error;
+            _errorCount++;
+        }
+        return;
+    }
+
+    if (!(TWCR & _BV(TWINT)))
+    {
+        if (nowUs - _lastProgressUs >= AsyncI2CTimeoutUs)
+            finish(AsyncI2CState::Error);
+
+        return;
+    }
+
+    _lastProgressUs = nowUs;
+    uint8_t status = TW_STATUS;
+
+    switch (_step)
+    {
+    case Step::Start:
+        if (status != TW_START && status != TW_REP_START)
+        {
+            finish(AsyncI2CState::Error);
+            break;
+        }
+
+        TWDR = static_cast<uint8_t>((_address << 1) | TW_READ);
+        TWCR = TwiNext;
+        _step = Step::Address;
+        break;
+
+    case Step::Address:
+        if (status != TW_MR_SLA_ACK)
+        {
+            finish(AsyncI2CState::Error);
+            break;
+        }
+
+        // ACK every byte except the last
+        TWCR = _length > 1 ? TwiNextAck : TwiNext;
+        _step = Step::Data;
+        break;
+
+    case Step::Data:
+        if (status != TW_MR_DATA_ACK && status != TW_MR_DATA_NACK)
+        {
+            finish(AsyncI2CState::Error);
+            break;
+        }
+
+        _buffer[_index++] = TWDR;
+
+        if (status == TW_MR_DATA_NACK || _index >= _length)
+        {
+            TWCR = TwiStop;
+            _step = Step::Stop;
+        }
+        else
+        {
+            TWCR = (_index < _length - 1) ? TwiNextAck : TwiNext;
+        }
+        break;
+
+    case Step::Stop:
+        break;
+    }
+}
+
+void AsyncI2C::finish(AsyncI2CState result)
+{
+    // Release the bus and hand the hardware back to the Wire library
+    TWCR = TwiStop;
+
+    unsigned long startUs = micros();
+    while ((TWCR & _BV(TWSTO)) && (micros() - startUs) < AsyncI2CTimeoutUs)
+    {
+    }
+
+    TWCR = TwiWireIdle;
+
+    if (result == AsyncI2CState::Error)
+        _errorCount++;
+
+    _state = result;
+}
+
+#else
+
+bool AsyncI2C::startRead(uint8_t address, uint8_t* buffer, uint8_t length)
+{
+    if (_state == AsyncI2CState::Busy || !buffer || length == 0)
+        return false;
+
+    _buffer = buffer;
+    _length = length;
+
+    // No TWI state machine on this architecture, read synchronously and
+    // report the result on the next poll
+    uint8_t received = Wire.requestFrom(address, length);
+    for (uint8_t i = 0; i < received && i < length; i++)
+    {
+        _buffer[i] = Wire.read();
+    }
+
+    if (received == length)
+    {
+        _state = AsyncI2CState::Complete;
+    }
+    else
+    {
+        _state = AsyncI2CState::Error;
+        _errorCount++;
+    }
+
+    return true;
+}
+
+AsyncI2CState AsyncI2C::poll()
+{
+    AsyncI2CState result = _state;
+    _state = AsyncI2CState::Idle;
+    return result;
+}
+
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <stdint.h>
+
+// Transaction abandoned if the bus makes no progress for this long
+constexpr unsigned long AsyncI2CTimeoutUs = 5000;
+
+enum class AsyncI2CState : uint8_t {
+    Idle = 0,                       // No transaction started
+    Busy = 1,                       // Transaction in progress
+    Complete = 2,                   // Buffer holds the bytes read
+    Error = 3                       // Address/data not acknowledged, arbitration lost or timed out
+};
+
+/**
+ * @class AsyncI2C
+ * @brief Non-blocking I2C master read.
+ *
+ * On AVR the TWI hardware is driven directly as a polled state machine:
+ * startRead() issues the START condition and returns immediately, each
+ * call to poll() advances by at most one bus event (start sent, address
+ * acknowledged, byte received, stop). Nothing waits on the bus, so the
+ * cost to loop() is a few register accesses whatever the bus clock.
+ *
+ * The Wire library is left configured (clock, pull-ups, pins) and its
+ * interrupt is masked only while a transaction is in flight, then
+ * restored, so other Wire users can share the bus between transactions.
+ * Do not call Wire while isBusy() returns true.
+ *
+ * Other architectures fall back to a synchronous Wire.requestFrom() in
+ * startRead(), with the result reported by the next poll().
+ *
+ * Usage:
+ * @code
+ * uint8_t buffer[7];
+ * bus.startRead(0x5E, buffer, sizeof(buffer));
+ *
+ * void loop() {
+ *     if (bus.poll() == AsyncI2CState::Complete)
+ *         decode(buffer);
+ * }
+ * @endcode
+ */
+class AsyncI2C
+{
+public:
+    AsyncI2C();
+
+    /**
+     * @brief Start reading from a device.
+     * @param address 7-bit device address
+     * @param buffer Receives the bytes, must stay valid until the read completes
+     * @param length Number of bytes to read
+     * @return false if a transaction is already in progress or length is 0
+     */
+    bool startRead(uint8_t address, uint8_t* buffer, uint8_t length);
+
+    /**
+     * @brief Advance the current transaction.
+     *
+     * Complete and Error are reported once, the following call returns Idle.
+     * @return State of the transaction
+     */
+    AsyncI2CState poll();
+
+    bool isBusy() const { return _state == AsyncI2CState::Busy; }
+    uint32_t getErrorCount() const { return _errorCount; }
+
+private:
+#if defined(__AVR__)
+    enum class Step : uint8_t {
+        Start,
+        Address,
+        Data,
+        Stop
+    };
+
+    void step();
+    void finish(AsyncI2CState result);
+
+    Step _step;
+    uint8_t _address;
+    uint8_t _index;
+    unsigned long _lastProgressUs;
+#endif
+
+    AsyncI2CState _state;
+    uint8_t* _buffer;
+    uint8_t _length;
+    uint32_t _errorCount;
+};
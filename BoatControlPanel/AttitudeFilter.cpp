@@ -0,0 +1,106 @@
+#include "AttitudeFilter.h"
+
+AttitudeFilter::AttitudeFilter()
+{
+    reset();
+}
+
+void AttitudeFilter::reset()
+{
+    _q0 = 1.0f;
+    _q1 = _q2 = _q3 = 0.0f;
+    _integralX = _integralY = _integralZ = 0.0f;
+    _initialised = false;
+}
+
+void AttitudeFilter::initialise(float ax, float ay, float az)
+{
+    // Start level with the accelerometer instead of converging from identity
+    float roll = atan2f(ay, az);
+    float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+
+    float cr = cosf(roll * 0.5f);
+    float sr = sinf(roll * 0.5f);
+    float cp = cosf(pitch * 0.5f);
+    float sp = sinf(pitch * 0.5f);
+
+    _q0 = cr * cp;
+    _q1 = sr * cp;
+    _q2 = cr * sp;
+    _q3 = -sr * sp;
+    _integralX = _integralY = _integralZ = 0.0f;
+    _initialised = true;
+}
+
+void AttitudeFilter::update(float gx, float gy, float gz, float ax, float ay, float az, float dt)
+{
+    float norm = ax * ax + ay * ay + az * az;
+    if (norm <= 0.0f)
+    {
+        return;
+    }
+
+    if (!_initialised || dt <= 0.0f || dt > AttitudeFilterMaxDt)
+    {
+        initialise(ax, ay, az);
+        return;
+    }
+
+    norm = 1.0f / sqrtf(norm);
+    ax *= norm;
+    ay *= norm;
+    az *= norm;
+
+    // Gravity direction predicted by the current attitude
+    float vx = 2.0f * (_q1 * _q3 - _q0 * _q2);
+    float vy = 2.0f * (_q0 * _q1 + _q2 * _q3);
+    float vz = _q0 * _q0 - _q1 * _q1 - _q2 * _q2 + _q3 * _q3;
+
+    // Error is the rotation from predicted to measured gravity
+    float ex = ay * vz - az * vy;
+    float ey = az * vx - ax * vz;
+    float ez = ax * vy - ay * vx;
+
+    _integralX += AttitudeFilterKi * ex * dt;
+    _integralY += AttitudeFilterKi * ey * dt;
+    _integralZ += AttitudeFilterKi * ez * dt;
+
+    gx += AttitudeFilterKp * ex + _integralX;
+    gy += AttitudeFilterKp * ey + _integralY;
+    gz += AttitudeFilterKp * ez + _integralZ;
+
+    // Integrate q' = 0.5 * q * (0, g)
+    float halfDt = 0.5f * dt;
+    float q0 = _q0;
+    float q1 = _q1;
+    float q2 = _q2;
+    float q3 = _q3;
+
+    _q0 += (-q1 * gx - q2 * gy - q3 * gz) * halfDt;
+    _q1 += (q0 * gx + q2 * gz - q3 * gy) * halfDt;
+    _q2 += (q0 * gy - q1 * gz + q3 * gx) * halfDt;
+    _q3 += (q0 * gz + q1 * gy - q2 * gx) * halfDt;
+
+    norm = 1.0f / sqrtf(_q0 * _q0 + _q1 * _q1 + _q2 * _q2 + _q3 * _q3);
+    _q0 *= norm;
+    _q1 *= norm;
+    _q2 *= norm;
+    _q3 *= norm;
+}
+
+float AttitudeFilter::getPitch() const
+{
+    float sinPitch = -2.0f * (_q1 * _q3 - _q0 * _q2);
+
+    if (sinPitch > 1.0f)
+        sinPitch = 1.0f;
+    else if (sinPitch < -1.0f)
+        sinPitch = -1.0f;
+
+    return asinf(sinPitch);
+}
+
+float AttitudeFilter::getRoll() const
+{
+    return atan2f(2.0f * (_q0 * _q1 + _q2 * _q3), 1.0f - 2.0f * (_q1 * _q1 + _q2 * _q2));
+}
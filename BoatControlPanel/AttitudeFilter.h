@@ -0,0 +1,56 @@
+#pragma once
+
+#include <math.h>
+
+// Proportional gain, how quickly the accelerometer corrects gyro drift. Kept
+// low so wave motion accelerations do not tilt the estimate
+constexpr float AttitudeFilterKp = 0.5f;
+
+// Integral gain, learns the gyro bias
+constexpr float AttitudeFilterKi = 0.01f;
+
+// Samples further apart than this restart the filter from the accelerometer
+constexpr float AttitudeFilterMaxDt = 0.5f;
+
+/**
+ * @class AttitudeFilter
+ * @brief Mahony complementary filter, gyro integrated attitude corrected
+ * towards the accelerometer gravity vector.
+ *
+ * The gyro carries the attitude through short term motion (rolling in a
+ * seaway), while the accelerometer slowly pulls it back towards gravity so
+ * gyro drift does not accumulate. Attitude is held as a unit quaternion,
+ * each update is a fixed number of float operations and one inverse
+ * square root per vector, no trigonometry except in the getters.
+ *
+ * Axes follow the accelerometer, which reads +1 g on z when level;
+ * gyro rates in rad/s, accelerations in any consistent unit.
+ */
+class AttitudeFilter
+{
+public:
+    AttitudeFilter();
+
+    /**
+     * @brief Restart from the next accelerometer sample.
+     */
+    void reset();
+
+    /**
+     * @brief Fuse one gyro and accelerometer sample.
+     * @param dt Seconds since the previous sample
+     */
+    void update(float gx, float gy, float gz, float ax, float ay, float az, float dt);
+
+    bool isInitialised() const { return _initialised; }
+
+    float getPitch() const;             // radians, nose up positive
+    float getRoll() const;              // radians, starboard down positive
+
+private:
+    void initialise(float ax, float ay, float az);
+
+    float _q0, _q1, _q2, _q3;
+    float _integralX, _integralY, _integralZ;
+    bool _initialised;
+};
@@ -2,28 +2,13 @@
 
 BaseBoatCommandHandler::BaseBoatCommandHandler(
     SerialCommandManager* computerCommandManager,
-    NextionControl* nextionControl,
     WarningManager* warningManager
 )
     : _computerCommandManager(computerCommandManager)
-    , _nextionControl(nextionControl)
     , _warningManager(warningManager)
 {
 }
 
-void BaseBoatCommandHandler::notifyCurrentPage(uint8_t updateType, const void* data)
-{
-    if (!_nextionControl)
-        return;
-
-    BaseDisplayPage* p = _nextionControl->getCurrentPage();
-    
-    if (!p)
-        return;
-
-    p->handleExternalUpdate(updateType, data);
-}
-
 void BaseBoatCommandHandler::sendDebugMessage(const String& message, const String& identifier)
 {
     if (_computerCommandManager)
@@ -2,8 +2,9 @@
 
 #include <Arduino.h>
 #include "BaseCommandHandler.h"
-#include "NextionControl.h"
 #include "WarningManager.h"
+#include "EventBus.h"
+#include "BoatEvents.h"
 
 /**
  * @brief Base class for command handlers that interact with boat-specific systems.
@@ -11,7 +12,7 @@
  * This class extends BaseCommandHandler with common dependencies and helper methods
  * used by command handlers that need to:
  * - Send debug messages to the computer command manager
- * - Notify the current Nextion display page of updates
+ * - Publish typed events (see BoatEvents.h) to pages and other subscribers
  * - Access the warning management system
  * - Parse common data formats (booleans, digits)
  * 
@@ -28,26 +29,13 @@ protected:
      * @brief Constructor with boat-specific dependencies.
      * 
      * @param computerCommandManager Manager for sending debug/error messages to computer
-     * @param nextionControl Controller for interacting with Nextion display
      * @param warningManager Manager for system warnings (can be nullptr if not needed)
      */
     BaseBoatCommandHandler(
         SerialCommandManager* computerCommandManager,
-        NextionControl* nextionControl,
         WarningManager* warningManager = nullptr
     );
 
-    /**
-     * @brief Notify the current display page of an external update.
-     * 
-     * This is a convenience wrapper that safely gets the current page from
-     * NextionControl and calls handleExternalUpdate on it.
-     * 
-     * @param updateType Type of update (cast to uint8_t from PageUpdateType enum)
-     * @param data Optional pointer to update-specific data structure
-     */
-    void notifyCurrentPage(uint8_t updateType, const void* data);
-
     /**
      * @brief Send a debug message to the computer command manager.
      * 
@@ -82,6 +70,5 @@ protected:
 
     // Protected member variables for derived classes to access
     SerialCommandManager* _computerCommandManager;
-    NextionControl* _nextionControl;
     WarningManager* _warningManager;
 };
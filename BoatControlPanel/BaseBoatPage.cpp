@@ -1,11 +1,14 @@
 #include <Arduino.h>
 #include "BaseBoatPage.h"
 
+NextionControl* BaseBoatPage::_nextionControl = nullptr;
+
 BaseBoatPage::BaseBoatPage(Stream* serialPort, 
                            WarningManager* warningMgr,
                            SerialCommandManager* commandMgrLink,
                            SerialCommandManager* commandMgrComputer) 
     : BaseDisplayPage(serialPort), 
+      _serialPort(serialPort),
       _config(nullptr),
       _commandMgrLink(commandMgrLink),
       _commandMgrComputer(commandMgrComputer),
@@ -18,6 +21,141 @@ BaseBoatPage::~BaseBoatPage()
     // Base destructor - no cleanup needed currently
 }
 
+void BaseBoatPage::setNextionControl(NextionControl* nextionControl)
+{
+    _nextionControl = nextionControl;
+}
+
+bool BaseBoatPage::isCurrentPage() const
+{
+    return _nextionControl && _nextionControl->getCurrentPage() == this;
+}
+
+void BaseBoatPage::setGlobalValue(const char* name, int32_t value)
+{
+    writeNumber(name, F(".val="), value);
+}
+
+void BaseBoatPage::beginText(const char* name)
+{
+    if (!_serialPort || !name)
+        return;
+
+    _serialPort->print(name);
+    _serialPort->print(F(".txt=\""));
+}
+
+void BaseBoatPage::appendText(const char* text)
+{
+    if (!_serialPort || !text)
+        return;
+
+    _serialPort->print(text);
+}
+
+void BaseBoatPage::appendTextP(PGM_P text)
+{
+    if (!_serialPort || !text)
+        return;
+
+    _serialPort->print(reinterpret_cast<const __FlashStringHelper*>(text));
+}
+
+void BaseBoatPage::endText()
+{
+    if (!_serialPort)
+        return;
+
+    _serialPort->print('"');
+    endCommand();
+}
+
+void BaseBoatPage::writePicture(const char* name, uint8_t picture)
+{
+    writeNumber(name, F(".pic="), picture);
+}
+
+void BaseBoatPage::writePicture2(const char* name, uint8_t picture)
+{
+    writeNumber(name, F(".pic2="), picture);
+}
+
+void BaseBoatPage::writeText(const char* name, const char* text)
+{
+    beginText(name);
+    appendText(text);
+    endText();
+}
+
+void BaseBoatPage::clearWaveform(uint8_t componentId, uint8_t channel)
+{
+    if (!_serialPort)
+        return;
+
+    _serialPort->print(F("cle "));
+    _serialPort->print(componentId);
+    _serialPort->print(',');
+    _serialPort->print(channel);
+    endCommand();
+}
+
+void BaseBoatPage::addWaveformPoint(uint8_t componentId, uint8_t channel, uint8_t value)
+{
+    if (!_serialPort)
+        return;
+
+    _serialPort->print(F("add "));
+    _serialPort->print(componentId);
+    _serialPort->print(',');
+    _serialPort->print(channel);
+    _serialPort->print(',');
+    _serialPort->print(value);
+    endCommand();
+}
+
+void BaseBoatPage::writeNumber(const char* name, const __FlashStringHelper* attribute, int32_t value)
+{
+    if (!_serialPort || !name)
+        return;
+
+    _serialPort->print(name);
+    _serialPort->print(attribute);
+    _serialPort->print(value);
+    endCommand();
+}
+
+void BaseBoatPage::leavePage(uint8_t pageId)
+{
+    onLeavePage();
+    setPage(pageId);
+}
+
+bool BaseBoatPage::handleComponentTouch(const PageComponent& component, uint8_t eventType)
+{
+    switch (component.role)
+    {
+    case ComponentRole::Navigate:
+        if (eventType == EventRelease)
+            leavePage(component.value);
+        return true;
+
+    case ComponentRole::Command:
+        if (eventType == EventRelease && component.command && _commandMgrLink)
+            _commandMgrLink->sendCommand(component.command, "");
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void BaseBoatPage::endCommand()
+{
+    _serialPort->write(0xFF);
+    _serialPort->write(0xFF);
+    _serialPort->write(0xFF);
+}
+
 void BaseBoatPage::configSet(Config* config)
 {
     _config = config;
@@ -2,54 +2,14 @@
 
 #include <Arduino.h>
 #include <BaseDisplayPage.h>
+#include <NextionControl.h>
 #include <SerialCommandManager.h>
 #include "Config.h"
 #include "WarningManager.h"
 #include "NextionIds.h"
-
-// Update type constants for external updates
-enum class PageUpdateType : uint8_t
-{
-    None = 0x00,
-    Warning = 0x01,
-    RelayState = 0x02,
-    HeartbeatAck = 0x03,
-    Temperature = 0x04,
-    Humidity = 0x05,
-    Bearing = 0x06,
-    Direction = 0x07,
-    Speed = 0x08,
-    CompassTemp = 0x09,
-    WaterLevel = 0x10,
-    WaterPumpActive = 0x0A,
-    SoundSignal = 0x0B,
-};
-
-// Data structure for relay state updates
-struct RelayStateUpdate {
-    uint8_t relayIndex;  // 0-based relay index (0..7)
-    bool isOn;           // true = relay on, false = relay off
-};
-
-struct FloatStateUpdate {
-    float value;
-};
-
-struct IntStateUpdate {
-    int16_t value;
-};
-
-struct BoolStateUpdate {
-    bool value;
-};
-
-// Data structure for string/text updates (e.g., direction like "NNW", "SE")
-// Fixed size to avoid flexible array member issues in C++
-struct CharStateUpdate {
-    static const uint8_t MaxLength = 16; // Sufficient for compass directions, status strings, etc.
-    uint8_t length;           // Actual length of the string (not including null terminator)
-    char value[MaxLength];   // Fixed-size buffer for the string (null-terminated)
-};
+#include "EventBus.h"
+#include "BoatEvents.h"
+#include "PageRegistry.h"
 
 /**
  * @class BaseBoatPage
@@ -58,9 +18,17 @@ struct CharStateUpdate {
  * Provides common functionality and shared state for all pages in the boat
  * control panel application, including warning state management, configuration
  * access, and other shared behaviors.
+ *
+ * Pages receive external state changes by subscribing to typed events on the
+ * EventBus (see BoatEvents.h). Events are delivered to every subscriber, not
+ * just the visible page, so handlers should cache the value and only write to
+ * the display when isCurrentPage() is true.
  */
 class BaseBoatPage : public BaseDisplayPage {
 private:
+    // Nextion serial stream, used for raw writes to global variables
+    Stream* _serialPort;
+
     // Shared configuration pointer
     Config* _config;
 
@@ -71,6 +39,15 @@ private:
     // Warning manager (shared across all pages)
     WarningManager* _warningManager;
 
+    // Display controller, used to determine which page is visible
+    static NextionControl* _nextionControl;
+
+    // Writes the Nextion command terminator (0xFF 0xFF 0xFF)
+    void endCommand();
+
+    // Writes <name>.<attribute>=<value> to the display
+    void writeNumber(const char* name, const __FlashStringHelper* attribute, int32_t value);
+
 protected:
     
     /**
@@ -114,6 +91,110 @@ protected:
      */
     WarningManager* getWarningManager() const { return _warningManager; }
 
+    /**
+     * @brief Check if this page is the page currently shown on the display.
+     * @return true if this page is visible, false otherwise or if no display controller is set
+     */
+    bool isCurrentPage() const;
+
+    /**
+     * @brief Write a value to a Nextion global variable.
+     *
+     * Global variables are readable from any page, so timer events on the
+     * display can animate from them (blinking, progress) without further
+     * serial traffic. Callers should only write when the value changes.
+     * @param name Fully qualified variable name (see NextionIds.h)
+     * @param value Value assigned to the variable's val attribute
+     */
+    void setGlobalValue(const char* name, int32_t value);
+
+    /**
+     * @brief Start streaming a text attribute to the display (<name>.txt=").
+     *
+     * Follow with appendText()/appendTextP() calls and finish with endText().
+     * The text is written straight to the display stream, no String is built.
+     * @param name Component name
+     */
+    void beginText(const char* name);
+
+    /**
+     * @brief Append RAM text to a text attribute started with beginText().
+     * @param text Text to append
+     */
+    void appendText(const char* text);
+
+    /**
+     * @brief Append flash (PROGMEM) text to a text attribute started with beginText().
+     * @param text Pointer to text in flash
+     */
+    void appendTextP(PGM_P text);
+
+    /**
+     * @brief Finish a text attribute started with beginText().
+     */
+    void endText();
+
+    /**
+     * @brief Set the picture of a component without building a String.
+     * @param name Component name
+     * @param picture Nextion picture id
+     */
+    void writePicture(const char* name, uint8_t picture);
+
+    /**
+     * @brief Set the pressed picture (pic2) of a component without building a String.
+     * @param name Component name
+     * @param picture Nextion picture id
+     */
+    void writePicture2(const char* name, uint8_t picture);
+
+    /**
+     * @brief Set the text of a component without building a String.
+     * @param name Component name
+     * @param text Text to display
+     */
+    void writeText(const char* name, const char* text);
+
+    /**
+     * @brief Clear a waveform channel (cle <id>,<channel>).
+     * @param componentId Nextion id of the waveform component
+     * @param channel Channel to clear, 255 clears every channel
+     */
+    void clearWaveform(uint8_t componentId, uint8_t channel);
+
+    /**
+     * @brief Append a point to a waveform channel (add <id>,<channel>,<value>).
+     * @param componentId Nextion id of the waveform component
+     * @param channel Waveform channel
+     * @param value Point height in pixels, 0..255
+     */
+    void addWaveformPoint(uint8_t componentId, uint8_t channel, uint8_t value);
+
+    /**
+     * @brief Handle the touch behaviour shared by all pages for a registered component.
+     *
+     * Navigate and Command components act on release. Other roles are left
+     * to the page.
+     * @param component Registry entry of the touched component
+     * @param eventType EventPress or EventRelease
+     * @return true if the component was handled
+     */
+    bool handleComponentTouch(const PageComponent& component, uint8_t eventType);
+
+    /**
+     * @brief Called before this page switches the display to another page.
+     *
+     * Override to stop anything that must not outlive the page, such as a
+     * hold action that is ended by a release the page will no longer see.
+     */
+    virtual void onLeavePage() {}
+
+    /**
+     * @brief Switch the display to another page, calling onLeavePage() first.
+     * @param pageId Page to show
+     */
+    void leavePage(uint8_t pageId);
+
     /**
 	* @brief Get the appropriate button color based on state.
 	* @return Color index for the button
@@ -121,6 +202,12 @@ protected:
     uint8_t getButtonColor(uint8_t buttonIndex, bool isOn, uint8_t maxButtons);
 
 public:
+
+    /**
+     * @brief Set the display controller shared by all pages.
+     * @param nextionControl Pointer to the NextionControl that owns the pages
+     */
+    static void setNextionControl(NextionControl* nextionControl);
     
     /**
      * @brief Set the configuration pointer for this page.
@@ -1,6 +1,8 @@
 #include <Arduino.h>
 #include <SerialCommandManager.h>
 #include <NextionControl.h>
+#include <TaskScheduler.h>
+#include <RingStats.h>
 
 #include "BoatControlPanelConstants.h"
 
@@ -10,6 +12,7 @@
 #include "SensorCommandHandler.h"
 #include "WarningCommandHandler.h"
 #include "SystemCommandHandler.h"
+#include "CompassBenchmarkCommandHandler.h"
 
 #include "HomePage.h"
 #include "WarningPage.h"
@@ -20,30 +23,71 @@
 #include "SoundManeuveringPage.h"
 #include "SoundEmergencyPage.h"
 #include "SoundOtherPage.h"
+#include "TrendPage.h"
 
 #include "Config.h"
 #include "ConfigManager.h"
 #include "WarningManager.h"
 #include "TLVCompass.h"
+#include "FixedRateSampler.h"
+#include "NmeaParser.h"
+#include "NmeaOutput.h"
+#include "SensorHistory.h"
+#include "EventBus.h"
+#include "BoatEvents.h"
+#include "EventLogger.h"
 
 
 #define COMPUTER_SERIAL Serial
 #define NEXTION_SERIAL Serial1
 #define LINK_SERIAL Serial2
+#define GPS_SERIAL Serial3
 
 
 constexpr unsigned long UpdateIntervalMs = 600;
+constexpr unsigned long CompassHeadingTimeConstantMs = 600;
+constexpr bool CompassI2CFastMode = true;   // 400 kHz bus, false for 100 kHz on long cable runs
 constexpr unsigned long SerialInitTimeoutMs = 300;
 constexpr unsigned long HeartbeatIntervalMs = 1000;
 constexpr unsigned long HeartbeatTimeoutMs = 3000;
+constexpr unsigned long WarningUpdateIntervalMs = 100;
+constexpr unsigned long GpsBaudRate = 38400;
+constexpr unsigned long GpsPollIntervalMs = 1;      // 38400 baud fills the 64 byte RX buffer in ~16ms
+constexpr unsigned long GpsTimeoutMs = 3000;
+constexpr unsigned long NmeaOutputPollIntervalMs = 5;
+constexpr unsigned long HistoryUpdateIntervalMs = 1000;
 
 // forward declares
 void InitializeSerial(HardwareSerial& serialPort, unsigned long baudRate, bool waitForConnection = false);
 void onLinkCommandReceived(SerialCommandManager* mgr);
 void onComputerCommandReceived(SerialCommandManager* mgr);
+void publishSensorEvents(unsigned long now);
+void updateWarnings(unsigned long now);
+void readGps(unsigned long now);
+void writeNmea(unsigned long now);
+void updateHistory(unsigned long now);
 
-// Compass with smoothing filter size 15
-TLVCompass compass(15);
+// Periodic work, run from loop() with per task timing reported by F6
+TaskScheduler scheduler;
+
+// Compass with field smoothing filter size 15 and a 600ms heading time constant,
+// sampled at a fixed rate independent of the UI, the rate is set from config (C14)
+TLVCompass compass(15, CompassHeadingTimeConstantMs);
+FixedRateSampler compassSampler(1000000UL / ConfigCompassMinRateHz);
+
+// GPS receiver on its own UART, sentences are decoded byte by byte as they arrive
+NmeaParser gps;
+unsigned long lastGpsSentence = 0;
+bool gpsReceiving = false;
+
+// Sensor data out as NMEA 0183, port and rate from config (C11)
+NmeaOutput nmeaOutput(&COMPUTER_SERIAL, &GPS_SERIAL);
+
+// Min/max/average per minute for the last hour and per 15 minutes for 24 hours (F8, trend page)
+SensorHistory sensorHistory;
+
+// Sensor temperature averaged over the last few updates so the warning does not chase noise
+RingStats<float, 8> compassTemperatureStats;
 
 // Serial managers
 SerialCommandManager commandMgrComputer(&COMPUTER_SERIAL, onComputerCommandReceived, '\n', ':', '=', 500, 64);
@@ -52,6 +96,9 @@ SerialCommandManager commandMgrLink(&LINK_SERIAL, onLinkCommandReceived, '\n', '
 // Warning manager with heartbeat monitoring
 WarningManager warningManager(&commandMgrLink, HeartbeatIntervalMs, HeartbeatTimeoutMs);
 
+// Debug logging of link events
+EventLogger eventLogger(&commandMgrComputer);
+
 // Nextion display setup
 HomePage homePage(&NEXTION_SERIAL, &warningManager, &commandMgrLink, &commandMgrComputer);
 WarningPage warningPage(&NEXTION_SERIAL, &warningManager, &commandMgrLink, &commandMgrComputer);
@@ -62,26 +109,25 @@ SoundFogPage soundFogPage(&NEXTION_SERIAL, &warningManager, &commandMgrLink, &co
 SoundManeuveringPage soundManeuveringPage(&NEXTION_SERIAL, &warningManager, &commandMgrLink, &commandMgrComputer);
 SoundEmergencyPage soundEmergencyPage(&NEXTION_SERIAL, &warningManager, &commandMgrLink, &commandMgrComputer);
 SoundOtherPage soundOtherPage(&NEXTION_SERIAL, &warningManager, &commandMgrLink, &commandMgrComputer);
+TrendPage trendPage(&NEXTION_SERIAL, &warningManager, &sensorHistory, &commandMgrLink, &commandMgrComputer);
 
 BaseDisplayPage* displayPages[] = { &homePage, &warningPage, &relayPage, &soundSignalsPage, &soundOvertakingPage,
-    &soundFogPage, &soundManeuveringPage, &soundEmergencyPage, &soundOtherPage };
+    &soundFogPage, &soundManeuveringPage, &soundEmergencyPage, &soundOtherPage, &trendPage };
 NextionControl nextion(&NEXTION_SERIAL, displayPages, sizeof(displayPages) / sizeof(displayPages[0]));
 
 // link command handlers
 InterceptDebugHandler interceptDebugHandler(&commandMgrComputer);
-SensorCommandHandler sensorCommandHandler(&commandMgrComputer, &nextion, &warningManager);
-WarningCommandHandler warningCommandHandler(&commandMgrComputer, &nextion, &warningManager);
+SensorCommandHandler sensorCommandHandler(&commandMgrComputer, &warningManager);
+WarningCommandHandler warningCommandHandler(&commandMgrComputer, &warningManager);
 
 // computer command handlers
-ConfigCommandHandler configHandler(&homePage);
+CompassBenchmarkCommandHandler compassBenchmarkHandler(&compass, 1000UL / ConfigCompassMinRateHz);
+ConfigCommandHandler configHandler(&homePage, &compass, &nmeaOutput, &compassSampler, &compassBenchmarkHandler);
 
 // shared command handlers
-AckCommandHandler ackHandler(&commandMgrComputer, &nextion, &warningManager);
-SystemCommandHandler systemCommandHandler(&commandMgrComputer, &commandMgrLink);
-
-// Timers
-unsigned long lastUpdate = 0;
-uint8_t speed = 0;
+AckCommandHandler ackHandler(&commandMgrComputer, &warningManager);
+SystemCommandHandler systemCommandHandler(&commandMgrComputer, &commandMgrLink, &compassSampler, &scheduler, &gps,
+    &sensorHistory);
 
 void setup()
 {
@@ -91,13 +137,14 @@ void setup()
     commandMgrLink.registerHandlers(linkHandlers, linkHandlerCount);
 
     ISerialCommandHandler* computerHandlers[] = { &configHandler, &ackHandler, &sensorCommandHandler, 
-        &warningCommandHandler, &systemCommandHandler };
+        &warningCommandHandler, &systemCommandHandler, &compassBenchmarkHandler };
     size_t computerHandlerCount = sizeof(computerHandlers) / sizeof(computerHandlers[0]);
     commandMgrComputer.registerHandlers(computerHandlers, computerHandlerCount);
 
     InitializeSerial(COMPUTER_SERIAL, 115200, true);
     InitializeSerial(NEXTION_SERIAL, 19200);
     InitializeSerial(LINK_SERIAL, 9600, false);
+    InitializeSerial(GPS_SERIAL, GpsBaudRate, false);
 
     // retrieve config settings
     ConfigManager::begin();
@@ -111,15 +158,26 @@ void setup()
     homePage.configSet(config);
     warningPage.configSet(config);
 	relayPage.configSet(config);
+    compass.configUpdated(config);
+    nmeaOutput.configUpdated(config);
+    configHandler.applyCompassSampleRate(config);
 
+    BaseBoatPage::setNextionControl(&nextion);
     nextion.begin();
 
-    if (!compass.begin())
+    if (!compass.begin(CompassI2CFastMode))
     {
         warningManager.raiseWarning(WarningType::SensorFailure);
         warningManager.raiseWarning(WarningType::CompassFailure);
     }
 
+    scheduler.addPeriodic(updateWarnings, WarningUpdateIntervalMs, "warn");
+    scheduler.addPeriodic(publishSensorEvents, UpdateIntervalMs, "ui");
+    scheduler.addPeriodic(readGps, GpsPollIntervalMs, "gps");
+    scheduler.addPeriodic(writeNmea, NmeaOutputPollIntervalMs, "nmea");
+    scheduler.addPeriodic(updateHistory, HistoryUpdateIntervalMs, "hist");
+    sensorHistory.begin(millis());
+
     commandMgrComputer.sendCommand(SystemInitialized, "");
     commandMgrLink.sendCommand(SystemInitialized, "");
 	nextion.sendCommand(PageOne);
@@ -133,29 +191,107 @@ void loop()
     commandMgrLink.readCommands();
 
     nextion.update(now);
-	warningManager.update(now);
 
-    if (now - lastUpdate >= UpdateIntervalMs)
+    // Live sampling pauses while a recorded trace is replayed through the compass
+    if (!warningManager.isWarningActive(WarningType::CompassFailure) && !compassBenchmarkHandler.isRunning())
     {
-        lastUpdate = now;
+        // Reads complete in the background, loop time does not depend on the bus speed
+        if (compassSampler.isDue(micros()))
+        {
+            compass.requestSample();
+        }
+
+        compass.poll(now);
+    }
+
+    scheduler.run(now);
+}
 
-        if (!warningManager.isWarningActive(WarningType::CompassFailure))
+void updateWarnings(unsigned long now)
+{
+    // Heartbeat send and connection timeout checks
+    warningManager.update(now);
+}
+
+void publishSensorEvents(unsigned long now)
+{
+    if (warningManager.isWarningActive(WarningType::CompassFailure))
+        return;
+
+    publishEvent(BearingEvent{ static_cast<float>(compass.getHeading()) });
+    publishEvent(DirectionEvent{ compass.getDirection() });
+    publishEvent(RateOfTurnEvent{ static_cast<float>(compass.getRateOfTurn()) });
+
+    compassTemperatureStats.push(static_cast<float>(compass.getTemperature()));
+    publishEvent(CompassTemperatureEvent{ compassTemperatureStats.mean() });
+}
+
+void readGps(unsigned long now)
+{
+    while (GPS_SERIAL.available() > 0)
+    {
+        NmeaSentence sentence = gps.feed(static_cast<char>(GPS_SERIAL.read()));
+
+        if (sentence == NmeaSentence::None)
+            continue;
+
+        const NmeaFix& fix = gps.getFix();
+        lastGpsSentence = now;
+        gpsReceiving = true;
+
+        switch (sentence)
         {
-            // Only update HomePage if it's the currently active page
-            if (nextion.getCurrentPage() == &homePage)
-            {
-                if (speed > 40)
-                    speed = 0;
-                else
-					speed += 2;
-
-                homePage.setBearing(compass.getHeading());
-                homePage.setDirection(compass.getDirection());
-                homePage.setSpeed(speed);
-                homePage.setCompassTemperature(compass.getTemperature());
-            }
+            case NmeaSentence::Rmc:
+                publishEvent(SpeedEvent{ fix.valid ? fix.speedKnots : NAN });
+                publishEvent(CourseOverGroundEvent{ fix.valid ? fix.courseDegrees : NAN });
+
+                if (fix.valid)
+                    publishEvent(GpsPositionEvent{ fix.latitudeE7, fix.longitudeE7 });
+
+                publishEvent(GpsFixEvent{ fix.valid, fix.quality, fix.satellites });
+                break;
+
+            case NmeaSentence::Vtg:
+                // RMC and VTG both carry speed, pages only redraw on a change
+                if (fix.valid)
+                {
+                    publishEvent(SpeedEvent{ fix.speedKnots });
+                    publishEvent(CourseOverGroundEvent{ fix.courseDegrees });
+                }
+                break;
+
+            case NmeaSentence::Gga:
+                if (fix.valid)
+                    publishEvent(GpsPositionEvent{ fix.latitudeE7, fix.longitudeE7 });
+
+                publishEvent(GpsFixEvent{ fix.valid, fix.quality, fix.satellites });
+                break;
+
+            default:
+                break;
         }
     }
+
+    // receiver unplugged or silent, clear speed once rather than show a stale value
+    if (gpsReceiving && now - lastGpsSentence >= GpsTimeoutMs)
+    {
+        gpsReceiving = false;
+        publishEvent(SpeedEvent{ NAN });
+        publishEvent(CourseOverGroundEvent{ NAN });
+        publishEvent(GpsFixEvent{ false, 0, 0 });
+    }
+}
+
+void writeNmea(unsigned long now)
+{
+    // Writes only what fits in the transmit buffer, the rest goes on the next run
+    nmeaOutput.update(now);
+}
+
+void updateHistory(unsigned long now)
+{
+    // Samples arrive as SensorReadingEvent, this only closes the buckets that are due
+    sensorHistory.update(now);
 }
 
 void onLinkCommandReceived(SerialCommandManager* mgr)
@@ -3,6 +3,12 @@
 constexpr char SystemHeartbeatCommand[] = "F0";
 constexpr char SystemInitialized[] = "F1";
 constexpr char SystemFreeMemory[] = "F2";
+constexpr char SystemSensorTiming[] = "F3";
+constexpr char SystemCompassBenchmark[] = "F4";
+constexpr char SystemCompassTraceSample[] = "F5";
+constexpr char SystemTaskStats[] = "F6";
+constexpr char SystemGpsStatus[] = "F7";
+constexpr char SystemSensorHistory[] = "F8";
 
 constexpr char RelayRetrieveStates[] = "R2";
 constexpr char RelaySetState[] = "R3";
@@ -21,6 +27,10 @@ constexpr char SoundSignalOvertakePort[] = "H9";
 constexpr char SoundSignalOvertakeConsent[] = "H10";
 constexpr char SoundSignalOvertakeDanger[] = "H11";
 constexpr char SoundSignalTest[] = "H12";
+constexpr char SoundSignalHorn[] = "H13";
+
+// SoundState values reported in H1 by the fuse box
+constexpr uint8_t SoundStateBlastOn = 2;
 
 
 constexpr char AckSuccess[] = "ok";
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdint.h>
+
+//
+// Event types published on the EventBus.
+//
+// Each struct is its own event type; subscribers register for the exact
+// type they need and receive it fully typed. Keep events small, they are
+// passed by reference and only valid for the duration of the publish call.
+//
+
+// Link heartbeat (F0) acknowledged by the fuse box
+struct HeartbeatAckEvent {
+    unsigned long receivedAt;   // millis() when the ACK was processed
+};
+
+// Relay state reported by the fuse box
+struct RelayStateEvent {
+    uint8_t relayIndex;         // 0-based relay index (0..7)
+    bool isOn;                  // true = relay on, false = relay off
+};
+
+// Sound signal (horn) state reported by the fuse box (H1 ACK)
+struct SoundSignalEvent {
+    uint8_t soundType;          // SoundType on the fuse box, 0 = none
+    uint8_t soundState;         // SoundState on the fuse box, 0 = idle
+    bool isActive;              // true if a sound signal is in progress
+};
+
+// Active warnings changed, carries the complete warning bitmap
+struct WarningsChangedEvent {
+    uint32_t activeWarnings;    // bit per WarningType
+};
+
+// Any S<n> sensor decoded through the SensorRegistry, published before the typed event
+struct SensorReadingEvent {
+    uint8_t sensorId;           // SensorId
+    uint8_t channel;            // channel for multi channel sensors, otherwise 0
+    float value;                // scaled value, NAN for text sensors
+};
+
+// Cabin temperature in degrees celsius
+struct TemperatureEvent {
+    float value;
+};
+
+// Cabin relative humidity in percent
+struct HumidityEvent {
+    float value;
+};
+
+// Compass bearing in degrees (0..359)
+struct BearingEvent {
+    float value;
+};
+
+// Compass direction text (N, NNE, NE, ...)
+struct DirectionEvent {
+    const char* value;
+};
+
+// Rate of turn in degrees per minute, positive turning to starboard
+struct RateOfTurnEvent {
+    float value;
+};
+
+// Speed over ground in knots
+struct SpeedEvent {
+    float value;
+};
+
+// Course over ground from the GPS in degrees true, NAN when not moving or no fix
+struct CourseOverGroundEvent {
+    float value;
+};
+
+// GPS position
+struct GpsPositionEvent {
+    int32_t latitudeE7;         // degrees * 1e7, north positive
+    int32_t longitudeE7;        // degrees * 1e7, east positive
+};
+
+// GPS fix state, published on every GGA/RMC and when the receiver goes quiet
+struct GpsFixEvent {
+    bool valid;                 // position can be used
+    uint8_t quality;            // GGA fix quality, 0 = no fix
+    uint8_t satellites;         // satellites used in the fix
+};
+
+// Compass sensor temperature in degrees celsius
+struct CompassTemperatureEvent {
+    float value;
+};
+
+// Bilge water level (raw sensor reading)
+struct WaterLevelEvent {
+    int16_t value;
+};
+
+// House battery voltage from the fuse box
+struct BatteryVoltageEvent {
+    float value;
+};
+
+// Load current through one relay, RMS over the fuse box report window
+struct RelayCurrentEvent {
+    uint8_t relayIndex;         // 0-based relay index (0..7)
+    float amps;
+};
+
+// Bilge pump active state
+struct WaterPumpEvent {
+    bool isActive;
+};
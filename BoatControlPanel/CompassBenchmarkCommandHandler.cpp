@@ -0,0 +1,207 @@
+#include "CompassBenchmarkCommandHandler.h"
+
+constexpr uint8_t BenchmarkStop = 0;
+constexpr uint8_t BenchmarkStart = 1;
+
+// Temperature used for replayed samples, traces carry the magnetometer only
+constexpr double BenchmarkTemperature = 25.0;
+
+CompassBenchmarkCommandHandler::CompassBenchmarkCommandHandler(TLVCompass* compass, unsigned long samplePeriodMs)
+    : _compass(compass),
+      _samplePeriodMs(samplePeriodMs > 0 ? samplePeriodMs : 1),
+      _running(false),
+      _nowMs(0)
+{
+    resetStats();
+}
+
+void CompassBenchmarkCommandHandler::setSamplePeriod(unsigned long samplePeriodMs)
+{
+    _samplePeriodMs = samplePeriodMs > 0 ? samplePeriodMs : 1;
+}
+
+const String* CompassBenchmarkCommandHandler::supportedCommands(size_t& count) const
+{
+    static const String cmds[] = { SystemCompassBenchmark, SystemCompassTraceSample };
+    count = sizeof(cmds) / sizeof(cmds[0]);
+    return cmds;
+}
+
+bool CompassBenchmarkCommandHandler::handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount)
+{
+    String cmd = command;
+    cmd.trim();
+
+    if (!_compass)
+    {
+        sendAckErr(sender, cmd, F("Compass not available"));
+        return true;
+    }
+
+    if (cmd == SystemCompassBenchmark)
+    {
+        // F4 reports, F4:v=1 starts a run, F4:v=0 ends it and reports
+        if (paramCount == 0)
+        {
+            sendReport(sender, cmd);
+            sendAckOk(sender, cmd);
+            return true;
+        }
+
+        uint8_t mode = params[0].value.toInt();
+
+        if (mode == BenchmarkStart)
+        {
+            start();
+            sendAckOk(sender, cmd, &params[0]);
+        }
+        else if (mode == BenchmarkStop)
+        {
+            _running = false;
+
+            // live sampling resumes on millis()
+            _compass->resetState(millis());
+            sendReport(sender, cmd);
+            sendAckOk(sender, cmd, &params[0]);
+        }
+        else
+        {
+            sendAckErr(sender, cmd, F("Invalid value"), &params[0]);
+        }
+    }
+    else if (cmd == SystemCompassTraceSample)
+    {
+        if (!_running)
+        {
+            sendAckErr(sender, cmd, F("Benchmark not running"));
+            return true;
+        }
+
+        if (paramCount < 4)
+        {
+            sendAckErr(sender, cmd, F("Missing params"));
+            return true;
+        }
+
+        replay(params, paramCount);
+
+        // Acknowledge each sample so the computer can pace the trace
+        sendAckOk(sender, cmd);
+    }
+
+    return true;
+}
+
+void CompassBenchmarkCommandHandler::start()
+{
+    resetStats();
+    _running = true;
+
+    // replayed samples run on their own clock from 0
+    _compass->resetState(_nowMs);
+}
+
+void CompassBenchmarkCommandHandler::resetStats()
+{
+    _nowMs = 0;
+    _sampleCount = 0;
+    _totalMicros = 0;
+    _maxMicros = 0;
+    _errorCount = 0;
+    _errorSum = 0;
+    _errorMax = 0;
+    _lastTruth = NAN;
+    _stepActive = false;
+    _stepCount = 0;
+    _stepStartMs = 0;
+    _settleMaxMs = 0;
+}
+
+void CompassBenchmarkCommandHandler::replay(const StringKeyValue params[], int paramCount)
+{
+    // F5:x=<bx mT>:y=<by mT>:z=<bz mT>:h=<ground truth heading>
+    double sampleBx = 0;
+    double sampleBy = 0;
+    double sampleBz = 0;
+    float truth = NAN;
+
+    for (int i = 0; i < paramCount; i++)
+    {
+        if (params[i].key == "x")
+            sampleBx = params[i].value.toFloat();
+        else if (params[i].key == "y")
+            sampleBy = params[i].value.toFloat();
+        else if (params[i].key == "z")
+            sampleBz = params[i].value.toFloat();
+        else if (params[i].key == "h")
+            truth = params[i].value.toFloat();
+    }
+
+    _nowMs += _samplePeriodMs;
+
+    unsigned long startUs = micros();
+    _compass->replaySample(sampleBx, sampleBy, sampleBz, BenchmarkTemperature, _nowMs);
+    unsigned long elapsedUs = micros() - startUs;
+
+    _sampleCount++;
+    _totalMicros += elapsedUs;
+    if (elapsedUs > _maxMicros)
+        _maxMicros = elapsedUs;
+
+    if (isnan(truth))
+        return;
+
+    float error = fabs(wrapDegrees(static_cast<float>(_compass->getHeading()) - truth));
+    _errorCount++;
+    _errorSum += error;
+    if (error > _errorMax)
+        _errorMax = error;
+
+    // A jump in ground truth is a step turn, settling time runs until the
+    // last sample outside tolerance before the next step
+    if (!isnan(_lastTruth) && fabs(wrapDegrees(truth - _lastTruth)) >= BenchmarkStepDegrees)
+    {
+        _stepActive = true;
+        _stepStartMs = _nowMs;
+        _stepCount++;
+    }
+
+    _lastTruth = truth;
+
+    if (_stepActive && error > BenchmarkSettleDegrees)
+    {
+        unsigned long settleMs = _nowMs - _stepStartMs + _samplePeriodMs;
+        if (settleMs > _settleMaxMs)
+            _settleMaxMs = settleMs;
+    }
+}
+
+void CompassBenchmarkCommandHandler::sendReport(SerialCommandManager* sender, const String& cmd)
+{
+    uint32_t meanMicros = _sampleCount ? _totalMicros / _sampleCount : 0;
+    float meanError = _errorCount ? _errorSum / _errorCount : 0;
+
+    StringKeyValue params[] = {
+        { F("n"), String(_sampleCount) },
+        { F("us"), String(meanMicros) },
+        { F("usmax"), String(_maxMicros) },
+        { F("err"), String(meanError, 2) },
+        { F("errmax"), String(_errorMax, 2) },
+        { F("settle"), String(_settleMaxMs) },
+        { F("steps"), String(_stepCount) },
+        { F("mem"), String(sizeof(TLVCompass)) }
+    };
+
+    sender->sendCommand(cmd, "", "", params, sizeof(params) / sizeof(params[0]));
+}
+
+float CompassBenchmarkCommandHandler::wrapDegrees(float degrees)
+{
+    while (degrees > 180.0f)
+        degrees -= 360.0f;
+
+    while (degrees < -180.0f)
+        degrees += 360.0f;
+
+    return degrees;
+}
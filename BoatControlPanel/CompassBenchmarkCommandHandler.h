@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Arduino.h>
+#include "BaseCommandHandler.h"
+#include "BoatControlPanelConstants.h"
+#include "TLVCompass.h"
+
+// A change in ground truth heading of at least this between samples starts a step
+constexpr float BenchmarkStepDegrees = 20.0f;
+
+// Heading is settled once the error stays within this many degrees
+constexpr float BenchmarkSettleDegrees = 2.0f;
+
+/**
+ * @class CompassBenchmarkCommandHandler
+ * @brief Replays a recorded compass trace through TLVCompass and reports
+ * how the pipeline performed.
+ *
+ * The computer streams the trace one sample per command, each sample
+ * carrying the raw magnetometer reading and the ground truth heading. The
+ * sample is run through the same processing as a live reading and timed
+ * with micros(), so the figures are for the real target, compiler and
+ * numeric backend (COMPASS_MATH). Live sampling is paused while a run is
+ * in progress and replay time advances by one sample period per sample.
+ *
+ * Reported: samples, mean and worst micros per update, mean and worst
+ * absolute heading error, worst settling time after a step turn, number
+ * of steps seen and the size of the TLVCompass object.
+ */
+class CompassBenchmarkCommandHandler : public BaseCommandHandler
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param compass Compass the trace is replayed through
+     * @param samplePeriodMs Replay time between samples, normally the live sample period
+     */
+    CompassBenchmarkCommandHandler(TLVCompass* compass, unsigned long samplePeriodMs);
+
+    bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
+    const String* supportedCommands(size_t& count) const override;
+
+    bool isRunning() const { return _running; }
+
+    /**
+     * @brief Set the replay time between samples, called when the live rate changes.
+     * @param samplePeriodMs Replay time between samples
+     */
+    void setSamplePeriod(unsigned long samplePeriodMs);
+
+private:
+    void start();
+    void resetStats();
+    void replay(const StringKeyValue params[], int paramCount);
+    void sendReport(SerialCommandManager* sender, const String& cmd);
+
+    static float wrapDegrees(float degrees);
+
+    TLVCompass* _compass;
+    unsigned long _samplePeriodMs;
+    bool _running;
+    unsigned long _nowMs;
+
+    uint32_t _sampleCount;
+    uint32_t _totalMicros;
+    unsigned long _maxMicros;
+    uint32_t _errorCount;
+    float _errorSum;
+    float _errorMax;
+
+    // Step response
+    float _lastTruth;
+    bool _stepActive;
+    uint16_t _stepCount;
+    unsigned long _stepStartMs;
+    unsigned long _settleMaxMs;
+};
@@ -0,0 +1,315 @@
+#include "CompassCalibration.h"
+#include <math.h>
+#include <string.h>
+
+// Jump between consecutive samples, relative to the field magnitude, treated as a spike
+constexpr float SpikeThreshold = 0.5f;
+
+// Minimum distance from the last accepted sample, relative to the field magnitude
+constexpr float MinSampleSpacing = 0.05f;
+
+constexpr uint8_t JacobiMaxSweeps = 10;
+constexpr float SolveEpsilon = 1e-9f;
+
+CompassCalibration::CompassCalibration()
+{
+    begin();
+}
+
+void CompassCalibration::begin()
+{
+    _scale = 0;
+    _sampleCount = 0;
+    _rejectedCount = 0;
+    _hasLast = false;
+    memset(_last, 0, sizeof(_last));
+    memset(_lastAccepted, 0, sizeof(_lastAccepted));
+    memset(_normal, 0, sizeof(_normal));
+    memset(_rhs, 0, sizeof(_rhs));
+}
+
+uint8_t CompassCalibration::packedIndex(uint8_t row, uint8_t col)
+{
+    if (row > col)
+    {
+        uint8_t swap = row;
+        row = col;
+        col = swap;
+    }
+
+    // Offset of the start of the row in the packed upper triangle
+    return row * CompassCalibrationTerms - (row * (row - 1)) / 2 + (col - row);
+}
+
+bool CompassCalibration::addSample(float x, float y, float z)
+{
+    if (_sampleCount >= CompassCalibrationMaxSamples)
+        return false;
+
+    if (_scale == 0)
+    {
+        _scale = sqrtf(x * x + y * y + z * z);
+        if (_scale == 0)
+            return false;
+    }
+
+    float u[3] = { x / _scale, y / _scale, z / _scale };
+
+    // Spike rejection against the previous raw sample, whether accepted or not
+    bool spike = false;
+    if (_hasLast)
+    {
+        float dx = u[0] - _last[0];
+        float dy = u[1] - _last[1];
+        float dz = u[2] - _last[2];
+        spike = (dx * dx + dy * dy + dz * dz) > SpikeThreshold * SpikeThreshold;
+    }
+
+    memcpy(_last, u, sizeof(_last));
+    _hasLast = true;
+
+    if (spike)
+    {
+        _rejectedCount++;
+        return false;
+    }
+
+    if (_sampleCount > 0)
+    {
+        float dx = u[0] - _lastAccepted[0];
+        float dy = u[1] - _lastAccepted[1];
+        float dz = u[2] - _lastAccepted[2];
+
+        if ((dx * dx + dy * dy + dz * dz) < MinSampleSpacing * MinSampleSpacing)
+            return false;
+    }
+
+    memcpy(_lastAccepted, u, sizeof(_lastAccepted));
+
+    float row[CompassCalibrationTerms] = {
+        u[0] * u[0], u[1] * u[1], u[2] * u[2],
+        2 * u[0] * u[1], 2 * u[0] * u[2], 2 * u[1] * u[2],
+        2 * u[0], 2 * u[1], 2 * u[2]
+    };
+
+    uint8_t index = 0;
+    for (uint8_t i = 0; i < CompassCalibrationTerms; i++)
+    {
+        for (uint8_t j = i; j < CompassCalibrationTerms; j++)
+        {
+            _normal[index++] += row[i] * row[j];
+        }
+
+        _rhs[i] += row[i];
+    }
+
+    _sampleCount++;
+    return true;
+}
+
+bool CompassCalibration::solve(float offset[3], float transform[3][3]) const
+{
+    if (_sampleCount < CompassCalibrationMinSamples)
+        return false;
+
+    // Expand the packed normal equations into an augmented matrix
+    float system[CompassCalibrationTerms][CompassCalibrationTerms + 1];
+    for (uint8_t i = 0; i < CompassCalibrationTerms; i++)
+    {
+        for (uint8_t j = 0; j < CompassCalibrationTerms; j++)
+        {
+            system[i][j] = _normal[packedIndex(i, j)];
+        }
+
+        system[i][CompassCalibrationTerms] = _rhs[i];
+    }
+
+    float p[CompassCalibrationTerms];
+    if (!solveLinear(system, p))
+        return false;
+
+    float shape[3][3] = {
+        { p[0], p[3], p[4] },
+        { p[3], p[1], p[5] },
+        { p[4], p[5], p[2] }
+    };
+
+    // Centre = -shape^-1 * (g, h, i), inverse from the adjugate
+    float c00 = shape[1][1] * shape[2][2] - shape[1][2] * shape[2][1];
+    float c01 = shape[0][2] * shape[2][1] - shape[0][1] * shape[2][2];
+    float c02 = shape[0][1] * shape[1][2] - shape[0][2] * shape[1][1];
+    float c11 = shape[0][0] * shape[2][2] - shape[0][2] * shape[2][0];
+    float c12 = shape[0][2] * shape[1][0] - shape[0][0] * shape[1][2];
+    float c22 = shape[0][0] * shape[1][1] - shape[0][1] * shape[1][0];
+    float determinant = shape[0][0] * c00 + shape[0][1] * (shape[1][2] * shape[2][0] - shape[1][0] * shape[2][2]) +
+        shape[0][2] * (shape[1][0] * shape[2][1] - shape[1][1] * shape[2][0]);
+
+    if (fabsf(determinant) < SolveEpsilon)
+        return false;
+
+    float centre[3] = {
+        -(c00 * p[6] + c01 * p[7] + c02 * p[8]) / determinant,
+        -(c01 * p[6] + c11 * p[7] + c12 * p[8]) / determinant,
+        -(c02 * p[6] + c12 * p[7] + c22 * p[8]) / determinant
+    };
+
+    // (u - centre)' shape (u - centre) = 1 + centre' shape centre
+    float k = 1;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            k += centre[i] * shape[i][j] * centre[j];
+        }
+    }
+
+    if (k <= 0)
+        return false;
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            shape[i][j] /= k;
+        }
+    }
+
+    // Transform is the symmetric square root of the normalised shape,
+    // V * sqrt(D) * V' from its eigen decomposition
+    float vectors[3][3];
+    symmetricEigen(shape, vectors);
+
+    float root[3];
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        // All axes must be positive for an ellipsoid
+        if (shape[i][i] <= 0)
+            return false;
+
+        root[i] = sqrtf(shape[i][i]);
+    }
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            transform[i][j] = vectors[i][0] * root[0] * vectors[j][0] +
+                vectors[i][1] * root[1] * vectors[j][1] +
+                vectors[i][2] * root[2] * vectors[j][2];
+        }
+
+        // Centre was fitted on scaled samples, offset is in sensor units
+        offset[i] = centre[i] * _scale;
+    }
+
+    return true;
+}
+
+bool CompassCalibration::solveLinear(float matrix[CompassCalibrationTerms][CompassCalibrationTerms + 1], float result[CompassCalibrationTerms])
+{
+    const uint8_t n = CompassCalibrationTerms;
+
+    // Gaussian elimination with partial pivoting
+    for (uint8_t col = 0; col < n; col++)
+    {
+        uint8_t pivot = col;
+        for (uint8_t row = col + 1; row < n; row++)
+        {
+            if (fabsf(matrix[row][col]) > fabsf(matrix[pivot][col]))
+                pivot = row;
+        }
+
+        if (fabsf(matrix[pivot][col]) < SolveEpsilon)
+            return false;
+
+        if (pivot != col)
+        {
+            for (uint8_t k = col; k <= n; k++)
+            {
+                float swap = matrix[col][k];
+                matrix[col][k] = matrix[pivot][k];
+                matrix[pivot][k] = swap;
+            }
+        }
+
+        for (uint8_t row = col + 1; row < n; row++)
+        {
+            float factor = matrix[row][col] / matrix[col][col];
+            for (uint8_t k = col; k <= n; k++)
+            {
+                matrix[row][k] -= factor * matrix[col][k];
+            }
+        }
+    }
+
+    for (int8_t row = n - 1; row >= 0; row--)
+    {
+        float sum = matrix[row][n];
+        for (uint8_t k = row + 1; k < n; k++)
+        {
+            sum -= matrix[row][k] * result[k];
+        }
+
+        result[row] = sum / matrix[row][row];
+    }
+
+    return true;
+}
+
+void CompassCalibration::symmetricEigen(float matrix[3][3], float vectors[3][3])
+{
+    // Cyclic Jacobi rotations, on return the diagonal of matrix holds the
+    // eigenvalues and the columns of vectors the matching eigenvectors
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            vectors[i][j] = (i == j) ? 1 : 0;
+        }
+    }
+
+    for (uint8_t sweep = 0; sweep < JacobiMaxSweeps; sweep++)
+    {
+        float offDiagonal = fabsf(matrix[0][1]) + fabsf(matrix[0][2]) + fabsf(matrix[1][2]);
+        if (offDiagonal < SolveEpsilon)
+            return;
+
+        for (uint8_t p = 0; p < 2; p++)
+        {
+            for (uint8_t q = p + 1; q < 3; q++)
+            {
+                if (fabsf(matrix[p][q]) < SolveEpsilon)
+                    continue;
+
+                float theta = (matrix[q][q] - matrix[p][p]) / (2 * matrix[p][q]);
+                float t = (theta >= 0 ? 1 : -1) / (fabsf(theta) + sqrtf(theta * theta + 1));
+                float c = 1 / sqrtf(t * t + 1);
+                float s = t * c;
+
+                for (uint8_t k = 0; k < 3; k++)
+                {
+                    float mkp = matrix[k][p];
+                    float mkq = matrix[k][q];
+                    matrix[k][p] = c * mkp - s * mkq;
+                    matrix[k][q] = s * mkp + c * mkq;
+                }
+
+                for (uint8_t k = 0; k < 3; k++)
+                {
+                    float mpk = matrix[p][k];
+                    float mqk = matrix[q][k];
+                    matrix[p][k] = c * mpk - s * mqk;
+                    matrix[q][k] = s * mpk + c * mqk;
+                }
+
+                for (uint8_t k = 0; k < 3; k++)
+                {
+                    float vkp = vectors[k][p];
+                    float vkq = vectors[k][q];
+                    vectors[k][p] = c * vkp - s * vkq;
+                    vectors[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
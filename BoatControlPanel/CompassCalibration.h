@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+
+// Samples needed before a calibration can be solved
+constexpr uint16_t CompassCalibrationMinSamples = 100;
+
+// Samples accepted after this are ignored, bounds the run time of a calibration
+constexpr uint16_t CompassCalibrationMaxSamples = 2000;
+
+// Terms of the general ellipsoid: x2, y2, z2, xy, xz, yz, x, y, z
+constexpr uint8_t CompassCalibrationTerms = 9;
+
+/**
+ * @class CompassCalibration
+ * @brief Incremental hard and soft iron magnetometer calibration.
+ *
+ * Raw magnetometer samples are fitted to the general ellipsoid
+ *
+ *     a x2 + b y2 + c z2 + 2d xy + 2e xz + 2f yz + 2g x + 2h y + 2i z = 1
+ *
+ * by least squares. Samples are not stored, each accepted sample is folded
+ * into the normal equations (a packed 9x9 symmetric matrix and a 9 term
+ * vector), so memory use is fixed however long the calibration runs.
+ *
+ * Solving produces a hard iron offset and a symmetric 3x3 soft iron
+ * transform; a corrected reading is transform * (raw - offset), which maps
+ * the fitted ellipsoid onto a sphere. The sphere radius is the magnitude of
+ * the first sample, so corrected readings stay close to sensor units.
+ *
+ * Single samples that jump away from the previous reading are rejected as
+ * spikes, and samples too close to the last accepted sample are skipped so
+ * holding the sensor still does not bias the fit towards one orientation.
+ *
+ * Usage:
+ * @code
+ * calibration.begin();
+ * // rotate the sensor through as many orientations as possible
+ * calibration.addSample(bx, by, bz);
+ * ...
+ * float offset[3], transform[3][3];
+ * if (calibration.solve(offset, transform))
+ *     compass.setCalibration(offset, transform);
+ * @endcode
+ */
+class CompassCalibration
+{
+public:
+    CompassCalibration();
+
+    /**
+     * @brief Start a new calibration, discarding any accumulated samples.
+     */
+    void begin();
+
+    /**
+     * @brief Add a raw magnetometer sample.
+     * @return true if the sample was accepted into the fit
+     */
+    bool addSample(float x, float y, float z);
+
+    /**
+     * @brief Solve the accumulated fit.
+     * @param offset Receives the hard iron offset, in sensor units
+     * @param transform Receives the soft iron correction matrix
+     * @return false if there are too few samples or the samples do not
+     *         describe an ellipsoid (sensor not rotated enough)
+     */
+    bool solve(float offset[3], float transform[3][3]) const;
+
+    uint16_t getSampleCount() const { return _sampleCount; }
+    uint16_t getRejectedCount() const { return _rejectedCount; }
+
+private:
+    static uint8_t packedIndex(uint8_t row, uint8_t col);
+    static bool solveLinear(float matrix[CompassCalibrationTerms][CompassCalibrationTerms + 1], float result[CompassCalibrationTerms]);
+    static void symmetricEigen(float matrix[3][3], float vectors[3][3]);
+
+    // Samples are divided by the magnitude of the first sample, keeping the
+    // sums of fourth powers well conditioned in single precision
+    float _scale;
+    float _last[3];
+    float _lastAccepted[3];
+    uint16_t _sampleCount;
+    uint16_t _rejectedCount;
+    bool _hasLast;
+
+    // Normal equations, upper triangle of the symmetric matrix packed by row
+    float _normal[CompassCalibrationTerms * (CompassCalibrationTerms + 1) / 2];
+    float _rhs[CompassCalibrationTerms];
+};
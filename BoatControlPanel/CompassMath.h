@@ -0,0 +1,225 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+//
+// Numeric backend for the compass pipeline, selected at compile time.
+//
+//   COMPASS_MATH_DOUBLE  double with libm (reference, emulated on the UNO R4 and software float on AVR)
+//   COMPASS_MATH_FLOAT   float with libm (hardware FPU on the UNO R4)
+//   COMPASS_MATH_FIXED   Q16.16 fixed point with polynomial atan2/sin/cos and integer sqrt
+//
+// Define COMPASS_MATH before including this file (or in the build flags)
+// to override the default.
+//
+
+#define COMPASS_MATH_DOUBLE 0
+#define COMPASS_MATH_FLOAT 1
+#define COMPASS_MATH_FIXED 2
+
+#ifndef COMPASS_MATH
+#define COMPASS_MATH COMPASS_MATH_FLOAT
+#endif
+
+/**
+ * @class Fixed16
+ * @brief Q16.16 signed fixed point number.
+ *
+ * Range is +/-32767 with a resolution of 1/65536, which covers the
+ * magnetometer (mT), accelerometer (g, m/s^2) and heading (degrees) values
+ * used by the compass. Products and quotients use a 64-bit intermediate.
+ * Integers outside the range saturate rather than wrap.
+ */
+class Fixed16
+{
+public:
+    int32_t raw;
+
+    constexpr Fixed16() : raw(0) {}
+    constexpr Fixed16(int value) : Fixed16(static_cast<long>(value)) {}
+    constexpr Fixed16(long value)
+        : raw(value > 32767L ? INT32_MAX : value < -32768L ? INT32_MIN : static_cast<int32_t>(value) * 65536L) {}
+    constexpr Fixed16(float value) : raw(static_cast<int32_t>(value * 65536.0f + (value >= 0 ? 0.5f : -0.5f))) {}
+    constexpr Fixed16(double value) : raw(static_cast<int32_t>(value * 65536.0 + (value >= 0 ? 0.5 : -0.5))) {}
+
+    static Fixed16 fromRaw(int32_t value)
+    {
+        Fixed16 result;
+        result.raw = value;
+        return result;
+    }
+
+    double toDouble() const { return raw / 65536.0; }
+
+    Fixed16 operator-() const { return fromRaw(-raw); }
+
+    Fixed16& operator+=(Fixed16 other) { raw += other.raw; return *this; }
+    Fixed16& operator-=(Fixed16 other) { raw -= other.raw; return *this; }
+    Fixed16& operator*=(Fixed16 other) { *this = *this * other; return *this; }
+    Fixed16& operator/=(Fixed16 other) { *this = *this / other; return *this; }
+
+    // Binary operators are friends so numeric literals convert on either side
+    friend Fixed16 operator+(Fixed16 a, Fixed16 b) { return fromRaw(a.raw + b.raw); }
+    friend Fixed16 operator-(Fixed16 a, Fixed16 b) { return fromRaw(a.raw - b.raw); }
+    friend Fixed16 operator*(Fixed16 a, Fixed16 b)
+    {
+        return fromRaw(static_cast<int32_t>((static_cast<int64_t>(a.raw) * b.raw) >> 16));
+    }
+    friend Fixed16 operator/(Fixed16 a, Fixed16 b)
+    {
+        if (b.raw == 0)
+            return fromRaw(a.raw >= 0 ? INT32_MAX : INT32_MIN);
+
+        return fromRaw(static_cast<int32_t>((static_cast<int64_t>(a.raw) * 65536) / b.raw));
+    }
+
+    friend bool operator<(Fixed16 a, Fixed16 b) { return a.raw < b.raw; }
+    friend bool operator>(Fixed16 a, Fixed16 b) { return a.raw > b.raw; }
+    friend bool operator<=(Fixed16 a, Fixed16 b) { return a.raw <= b.raw; }
+    friend bool operator>=(Fixed16 a, Fixed16 b) { return a.raw >= b.raw; }
+    friend bool operator==(Fixed16 a, Fixed16 b) { return a.raw == b.raw; }
+    friend bool operator!=(Fixed16 a, Fixed16 b) { return a.raw != b.raw; }
+};
+
+//
+// Polynomial approximations, usable with any of the numeric types. Used by
+// the fixed point backend, float/double use libm.
+//
+
+// atan(z) for z in [0, 1], max error ~0.0015 rad (0.09 degrees)
+template <typename T>
+inline T compassAtanUnit(T z)
+{
+    const T quarterPi = T(0.7853981634);
+    return quarterPi * z - z * (z - T(1)) * (T(0.2447) + T(0.0663) * z);
+}
+
+template <typename T>
+inline T compassAtan2Approx(T y, T x)
+{
+    const T zero = T(0);
+    const T pi = T(3.1415926536);
+    const T halfPi = T(1.5707963268);
+
+    T absX = x < zero ? -x : x;
+    T absY = y < zero ? -y : y;
+
+    if (absX == zero && absY == zero)
+        return zero;
+
+    T angle = absX >= absY
+        ? compassAtanUnit(absY / absX)
+        : halfPi - compassAtanUnit(absX / absY);
+
+    if (x < zero)
+        angle = pi - angle;
+
+    return y < zero ? -angle : angle;
+}
+
+// sin(x) for any x, range reduced to [-pi/2, pi/2], 7th order Taylor, max error ~0.00016
+template <typename T>
+inline T compassSinApprox(T x)
+{
+    const T pi = T(3.1415926536);
+    const T twoPi = T(6.2831853072);
+    const T halfPi = T(1.5707963268);
+
+    while (x > pi)
+        x -= twoPi;
+    while (x < -pi)
+        x += twoPi;
+
+    if (x > halfPi)
+        x = pi - x;
+    else if (x < -halfPi)
+        x = -pi - x;
+
+    T x2 = x * x;
+    return x * (T(1) - x2 / T(6) * (T(1) - x2 / T(20) * (T(1) - x2 / T(42))));
+}
+
+template <typename T>
+inline T compassCosApprox(T x)
+{
+    return compassSinApprox(x + T(1.5707963268));
+}
+
+// Integer square root of a Q16.16 value (exact to the last bit)
+inline Fixed16 compassSqrtFixed(Fixed16 value)
+{
+    if (value.raw <= 0)
+        return Fixed16();
+
+    uint64_t n = static_cast<uint64_t>(value.raw) << 16;
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > n)
+        bit >>= 2;
+
+    while (bit != 0)
+    {
+        if (n >= result + bit)
+        {
+            n -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return Fixed16::fromRaw(static_cast<int32_t>(result));
+}
+
+//
+// Backend selection
+//
+
+#if COMPASS_MATH == COMPASS_MATH_FIXED
+
+typedef Fixed16 CompassReal;
+
+inline CompassReal compassAtan2(CompassReal y, CompassReal x) { return compassAtan2Approx(y, x); }
+inline CompassReal compassSin(CompassReal x) { return compassSinApprox(x); }
+inline CompassReal compassCos(CompassReal x) { return compassCosApprox(x); }
+inline CompassReal compassSqrt(CompassReal x) { return compassSqrtFixed(x); }
+inline double compassToDouble(CompassReal x) { return x.toDouble(); }
+
+#elif COMPASS_MATH == COMPASS_MATH_FLOAT
+
+typedef float CompassReal;
+
+inline CompassReal compassAtan2(CompassReal y, CompassReal x) { return atan2f(y, x); }
+inline CompassReal compassSin(CompassReal x) { return sinf(x); }
+inline CompassReal compassCos(CompassReal x) { return cosf(x); }
+inline CompassReal compassSqrt(CompassReal x) { return sqrtf(x); }
+inline double compassToDouble(CompassReal x) { return x; }
+
+#else
+
+typedef double CompassReal;
+
+inline CompassReal compassAtan2(CompassReal y, CompassReal x) { return atan2(y, x); }
+inline CompassReal compassSin(CompassReal x) { return sin(x); }
+inline CompassReal compassCos(CompassReal x) { return cos(x); }
+inline CompassReal compassSqrt(CompassReal x) { return sqrt(x); }
+inline double compassToDouble(CompassReal x) { return x; }
+
+#endif
+
+inline CompassReal compassAbs(CompassReal x) { return x < CompassReal(0) ? -x : x; }
+
+// Horizontal heading vector from the calibrated field with pitch and roll
+// removed, sin/cos of the angles are computed once by the caller
+inline void compassTiltCompensate(CompassReal bx, CompassReal by, CompassReal bz,
+    CompassReal sinPitch, CompassReal cosPitch, CompassReal sinRoll, CompassReal cosRoll,
+    CompassReal& east, CompassReal& north)
+{
+    east = by * cosPitch - bz * sinPitch;
+    north = bx * cosRoll + by * sinRoll * sinPitch + bz * sinRoll * cosPitch;
+}
@@ -19,16 +19,24 @@ enum class VesselType : uint8_t {
 // - homePageButtonImage[4] (button color image IDs)
 // - vesselType (VesselType)
 // - hornRelayIndex (uint8_t) 0..7 or 0xFF = none
+// - compassCalibrated (uint8_t) 1 = compass calibration below is valid
+// - compassOffset[3] (float) hard iron offset
+// - compassTransform[3][3] (float) soft iron correction matrix
+// - nmeaOutputPort (uint8_t) 0 = off, 1 = computer serial, 2 = Serial3 TX
+// - nmeaOutputRateHz (uint8_t) sentence sets per second, 1..10
+// - compassSampleRateHz (uint8_t) compass samples per second, 25..50
 // - checksum (uint16_t)
 //
 // Keep struct packed and stable. Increase 'VERSION' when you change layout.
 // Packed POD for persistent configuration.
-constexpr uint8_t ConfigVersion = 3;
+constexpr uint8_t ConfigVersion = 6;
 constexpr uint8_t ConfigRelayCount = 8;
 constexpr uint8_t ConfigHomeButtons = 4;
 constexpr uint8_t ConfigMaxBoatNameLength = 31; // max characters (inc null)
 constexpr uint8_t ConfigShortRelayName = 6; // max characters (inc null) - for home page
 constexpr uint8_t ConfigLongRelayName = 21; // max characters (inc null) - for buttons page
+constexpr uint8_t ConfigCompassMinRateHz = 25;
+constexpr uint8_t ConfigCompassMaxRateHz = 50;
 
 struct Config {
     uint8_t version;
@@ -39,5 +47,11 @@ struct Config {
     uint8_t buttonImage[ConfigRelayCount]; // 0..7 or 0xFF = empty
     VesselType vesselType;
 	uint8_t hornRelayIndex; // 0..7 or 0xFF = none
+    uint8_t compassCalibrated; // 0 = not calibrated, 1 = calibrated
+    float compassOffset[3]; // corrected = transform * (raw - offset)
+    float compassTransform[3][3];
+    uint8_t nmeaOutputPort; // 0 = off, 1 = computer serial, 2 = Serial3 TX
+    uint8_t nmeaOutputRateHz;
+    uint8_t compassSampleRateHz; // ConfigCompassMinRateHz..ConfigCompassMaxRateHz
     uint16_t checksum;
 } __attribute__((packed));
\ No newline at end of file
@@ -9,10 +9,19 @@ constexpr char ConfigMapHomeButton[] = "C5";
 constexpr char ConfigSetButtonColor[] = "C6";
 constexpr char ConfigBoatType[] = "C7";
 constexpr char ConfigSoundRelayId[] = "C8";
+constexpr char ConfigCompassCalibration[] = "C10";
+constexpr char ConfigNmeaOutput[] = "C11";
+constexpr char ConfigCompassSampleRate[] = "C14";
 
+constexpr uint8_t CompassCalibrationFinish = 0;
+constexpr uint8_t CompassCalibrationStart = 1;
+constexpr uint8_t CompassCalibrationClear = 2;
 
-ConfigCommandHandler::ConfigCommandHandler(HomePage* homePage)
-    : _homePage(homePage)
+
+ConfigCommandHandler::ConfigCommandHandler(HomePage* homePage, TLVCompass* compass, NmeaOutput* nmeaOutput,
+    FixedRateSampler* compassSampler, CompassBenchmarkCommandHandler* compassBenchmark)
+    : _homePage(homePage), _compass(compass), _nmeaOutput(nmeaOutput),
+      _compassSampler(compassSampler), _compassBenchmark(compassBenchmark)
 {
 }
 
@@ -30,6 +39,13 @@ bool ConfigCommandHandler::handleCommand(SerialCommandManager* sender, const Str
     String cmd = command;
     cmd.trim();
 
+    // NMEA output restarts its sentence set when applied, only do it on a change
+    uint8_t nmeaPort = cfg->nmeaOutputPort;
+    uint8_t nmeaRate = cfg->nmeaOutputRateHz;
+
+    // Changing the rate restarts the sampler and its statistics, only do it on a change
+    uint8_t compassRate = cfg->compassSampleRateHz;
+
     if (cmd == ConfigRenameBoat)
     {
         if (paramCount >= 1)
@@ -244,6 +260,15 @@ bool ConfigCommandHandler::handleCommand(SerialCommandManager* sender, const Str
 		// C8 Sound relay ID
 		sender->sendCommand(ConfigSoundRelayId, String(cfg->hornRelayIndex));
 
+        // C10 Compass calibrated
+        sender->sendCommand(ConfigCompassCalibration, String(cfg->compassCalibrated));
+
+        // C11 NMEA output port and rate
+        sendNmeaOutput(sender, cfg);
+
+        // C14 compass sample rate
+        sendCompassSampleRate(sender, cfg);
+
         sendAckOk(sender, cmd);
     }
     else if (cmd == ConfigBoatType)
@@ -266,6 +291,18 @@ bool ConfigCommandHandler::handleCommand(SerialCommandManager* sender, const Str
             return true;
         }
 	}
+    else if (cmd == ConfigCompassCalibration)
+    {
+        handleCompassCalibration(sender, cmd, cfg, params, paramCount);
+    }
+    else if (cmd == ConfigNmeaOutput)
+    {
+        handleNmeaOutput(sender, cmd, cfg, params, paramCount);
+    }
+    else if (cmd == ConfigCompassSampleRate)
+    {
+        handleCompassSampleRate(sender, cmd, cfg, params, paramCount);
+    }
     else if (cmd == ConfigResetSettings)
     {
         // Reset to defaults
@@ -281,13 +318,190 @@ bool ConfigCommandHandler::handleCommand(SerialCommandManager* sender, const Str
     if (_homePage)
         _homePage->configUpdated();
 
+    if (_compass && !_compass->isCalibrating())
+        _compass->configUpdated(cfg);
+
+    if (_nmeaOutput && (cfg->nmeaOutputPort != nmeaPort || cfg->nmeaOutputRateHz != nmeaRate))
+        _nmeaOutput->configUpdated(cfg);
+
+    if (cfg->compassSampleRateHz != compassRate)
+        applyCompassSampleRate(cfg);
+
     return true;
 }
 
+void ConfigCommandHandler::handleCompassCalibration(SerialCommandManager* sender, const String& cmd, Config* cfg, const StringKeyValue params[], int paramCount)
+{
+    // Expect "C10:v=1" to start collecting samples, "C10:v=0" to solve and store,
+    // "C10:v=2" to clear the stored calibration
+    if (paramCount < 1)
+    {
+        sendAckErr(sender, cmd, F("Missing param"));
+        return;
+    }
+
+    if (!_compass)
+    {
+        sendAckErr(sender, cmd, F("Compass not available"), &params[0]);
+        return;
+    }
+
+    uint8_t mode = params[0].value.toInt();
+
+    if (mode == CompassCalibrationStart)
+    {
+        _compass->startCalibration();
+        sendAckOk(sender, cmd, &params[0]);
+    }
+    else if (mode == CompassCalibrationFinish)
+    {
+        if (!_compass->isCalibrating())
+        {
+            sendAckErr(sender, cmd, F("Calibration not started"), &params[0]);
+            return;
+        }
+
+        float offset[3];
+        float transform[3][3];
+
+        if (!_compass->finishCalibration(offset, transform))
+        {
+            sendAckErr(sender, cmd, F("Calibration failed, rotate sensor fully"), &params[0]);
+            return;
+        }
+
+        // Stored in memory only, C0 persists it with the rest of the config
+        memcpy(cfg->compassOffset, offset, sizeof(offset));
+        memcpy(cfg->compassTransform, transform, sizeof(transform));
+        cfg->compassCalibrated = 1;
+
+        StringKeyValue param = { ValueParamName, String(_compass->getCalibrationSampleCount()) };
+        sendAckOk(sender, cmd, &param);
+    }
+    else if (mode == CompassCalibrationClear)
+    {
+        // The compass only takes the config once calibration has finished,
+        // clearing now would leave it using the old calibration
+        if (_compass->isCalibrating())
+        {
+            sendAckErr(sender, cmd, F("Calibration in progress"), &params[0]);
+            return;
+        }
+
+        cfg->compassCalibrated = 0;
+        memset(cfg->compassOffset, 0, sizeof(cfg->compassOffset));
+        memset(cfg->compassTransform, 0, sizeof(cfg->compassTransform));
+        for (uint8_t i = 0; i < 3; ++i)
+        {
+            cfg->compassTransform[i][i] = 1.0f;
+        }
+
+        sendAckOk(sender, cmd, &params[0]);
+    }
+    else
+    {
+        sendAckErr(sender, cmd, F("Invalid value"), &params[0]);
+    }
+}
+
+void ConfigCommandHandler::handleNmeaOutput(SerialCommandManager* sender, const String& cmd, Config* cfg, const StringKeyValue params[], int paramCount)
+{
+    // Expect "C11:p=<port>:r=<rate>", either may be left out, no params reports the current setting
+    if (paramCount == 0)
+    {
+        sendNmeaOutput(sender, cfg);
+        sendAckOk(sender, cmd);
+        return;
+    }
+
+    // Range checked before narrowing, r=266 must not be taken as 10
+    long port = cfg->nmeaOutputPort;
+    long rate = cfg->nmeaOutputRateHz;
+
+    for (int i = 0; i < paramCount; i++)
+    {
+        if (params[i].key == "p")
+            port = params[i].value.toInt();
+        else if (params[i].key == "r")
+            rate = params[i].value.toInt();
+    }
+
+    if (port < NmeaPortOff || port > NmeaPortAux)
+    {
+        sendAckErr(sender, cmd, F("Invalid port"));
+        return;
+    }
+
+    if (rate < 1 || rate > NmeaMaxRateHz)
+    {
+        sendAckErr(sender, cmd, F("Rate must be 1-10"));
+        return;
+    }
+
+    cfg->nmeaOutputPort = static_cast<uint8_t>(port);
+    cfg->nmeaOutputRateHz = static_cast<uint8_t>(rate);
+    sendAckOk(sender, cmd);
+}
+
+void ConfigCommandHandler::sendNmeaOutput(SerialCommandManager* sender, const Config* cfg)
+{
+    StringKeyValue params[] = {
+        { F("p"), String(cfg->nmeaOutputPort) },
+        { F("r"), String(cfg->nmeaOutputRateHz) }
+    };
+
+    sender->sendCommand(ConfigNmeaOutput, "", "", params, sizeof(params) / sizeof(params[0]));
+}
+
+void ConfigCommandHandler::handleCompassSampleRate(SerialCommandManager* sender, const String& cmd, Config* cfg, const StringKeyValue params[], int paramCount)
+{
+    // Expect "C14:r=<rate>", no params reports the current setting
+    if (paramCount == 0)
+    {
+        sendCompassSampleRate(sender, cfg);
+        sendAckOk(sender, cmd);
+        return;
+    }
+
+    // Range checked before narrowing, r=281 must not be taken as 25
+    long rate = params[0].value.toInt();
+
+    if (rate < ConfigCompassMinRateHz || rate > ConfigCompassMaxRateHz)
+    {
+        sendAckErr(sender, cmd, F("Rate must be 25-50"), &params[0]);
+        return;
+    }
+
+    cfg->compassSampleRateHz = static_cast<uint8_t>(rate);
+    sendAckOk(sender, cmd, &params[0]);
+}
+
+void ConfigCommandHandler::sendCompassSampleRate(SerialCommandManager* sender, const Config* cfg)
+{
+    StringKeyValue param = { F("r"), String(cfg->compassSampleRateHz) };
+    sender->sendCommand(ConfigCompassSampleRate, "", "", &param, 1);
+}
+
+void ConfigCommandHandler::applyCompassSampleRate(const Config* cfg)
+{
+    uint8_t rate = cfg->compassSampleRateHz;
+
+    // Guard against a bad stored value, the sampler period must stay sane
+    if (rate < ConfigCompassMinRateHz || rate > ConfigCompassMaxRateHz)
+        rate = ConfigCompassMinRateHz;
+
+    if (_compassSampler)
+        _compassSampler->setRate(rate);
+
+    if (_compassBenchmark)
+        _compassBenchmark->setSamplePeriod(1000UL / rate);
+}
+
 const String* ConfigCommandHandler::supportedCommands(size_t& count) const
 {
     static const String cmds[] = { ConfigSaveSettings, ConfigGetSettings, ConfigResetSettings, ConfigRenameBoat,
-        ConfigRenameRelay, ConfigMapHomeButton, ConfigSetButtonColor, ConfigBoatType, ConfigSoundRelayId };
+        ConfigRenameRelay, ConfigMapHomeButton, ConfigSetButtonColor, ConfigBoatType, ConfigSoundRelayId, ConfigCompassCalibration,
+        ConfigNmeaOutput, ConfigCompassSampleRate };
     count = sizeof(cmds) / sizeof(cmds[0]);
     return cmds;
 }
\ No newline at end of file
@@ -3,17 +3,37 @@
 #include "Config.h"
 #include "ConfigManager.h"
 #include "HomePage.h"
+#include "TLVCompass.h"
+#include "NmeaOutput.h"
+#include "FixedRateSampler.h"
+#include "CompassBenchmarkCommandHandler.h"
 #include "BaseCommandHandler.h"
 
 class ConfigCommandHandler : public BaseCommandHandler
 {
 public:
-    // Constructor: pass the HomePage pointer so we can notify UI when saved/updated
-    explicit ConfigCommandHandler(HomePage* homePage);
+    // Constructor: pass the HomePage pointer so we can notify UI when saved/updated,
+    // and the compass, its sampler and benchmark and NMEA output so calibration, sample rate
+    // and output changes are applied immediately
+    explicit ConfigCommandHandler(HomePage* homePage, TLVCompass* compass = nullptr, NmeaOutput* nmeaOutput = nullptr,
+        FixedRateSampler* compassSampler = nullptr, CompassBenchmarkCommandHandler* compassBenchmark = nullptr);
+
+    // Apply the compass sample rate in config to the sampler and benchmark replay
+    void applyCompassSampleRate(const Config* cfg);
 
     bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
     const String* supportedCommands(size_t& count) const override;
 
 private:
     HomePage* _homePage;
+    TLVCompass* _compass;
+    NmeaOutput* _nmeaOutput;
+    FixedRateSampler* _compassSampler;
+    CompassBenchmarkCommandHandler* _compassBenchmark;
+
+    void handleCompassCalibration(SerialCommandManager* sender, const String& cmd, Config* cfg, const StringKeyValue params[], int paramCount);
+    void handleNmeaOutput(SerialCommandManager* sender, const String& cmd, Config* cfg, const StringKeyValue params[], int paramCount);
+    void sendNmeaOutput(SerialCommandManager* sender, const Config* cfg);
+    void handleCompassSampleRate(SerialCommandManager* sender, const String& cmd, Config* cfg, const StringKeyValue params[], int paramCount);
+    void sendCompassSampleRate(SerialCommandManager* sender, const Config* cfg);
 };
\ No newline at end of file
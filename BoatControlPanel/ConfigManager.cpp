@@ -109,6 +109,20 @@ void ConfigManager::resetToDefaults()
 	_cfg.vesselType = VesselType::Motor;
 	_cfg.hornRelayIndex = 0xFF; // none
 
+    // Compass not calibrated, identity transform
+    _cfg.compassCalibrated = 0;
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        _cfg.compassTransform[i][i] = 1.0f;
+    }
+
+    // NMEA output off, once a second when enabled
+    _cfg.nmeaOutputPort = 0;
+    _cfg.nmeaOutputRateHz = 1;
+
+    // Compass sampled at the slowest rate, enough for the heading filter
+    _cfg.compassSampleRateHz = ConfigCompassMinRateHz;
+
     // compute checksum
     _cfg.checksum = 0;
     _cfg.checksum = calcChecksum(_cfg);
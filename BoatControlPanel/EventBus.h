@@ -0,0 +1,117 @@
+#pragma once
+
+#include <stdint.h>
+
+// Maximum number of subscribers for any single event type
+constexpr uint8_t EventBusMaxSubscribers = 4;
+
+/**
+ * @class EventBus
+ * @brief Compile-time typed publish/subscribe bus.
+ *
+ * Each event type gets its own static subscriber table, so publishing an
+ * event is a single walk over the subscribers of that type only. Handlers
+ * are plain function pointers bound at subscription time (no virtual calls,
+ * no runtime type checks), and the payload type is enforced by the compiler.
+ *
+ * All storage is static and zero initialised, so subscribing from the
+ * constructor of a global object is safe.
+ *
+ * Usage:
+ * @code
+ * struct TemperatureEvent { float value; };
+ *
+ * class HomePage {
+ *     HomePage() { EventBus<TemperatureEvent>::subscribe<HomePage, &HomePage::onTemperature>(this); }
+ *     void onTemperature(const TemperatureEvent& event);
+ * };
+ *
+ * publishEvent(TemperatureEvent{ 21.5f });
+ * @endcode
+ *
+ * Dispatch is synchronous; event data only needs to remain valid for the
+ * duration of the publish call.
+ */
+template <typename TEvent>
+class EventBus
+{
+public:
+    typedef void (*Handler)(void* context, const TEvent& event);
+
+    /**
+     * @brief Subscribe a member function of an object to this event type.
+     * @param subscriber Object that receives the event
+     * @return true if subscribed, false if the subscriber table is full
+     */
+    template <typename TSubscriber, void (TSubscriber::*Method)(const TEvent&)>
+    static bool subscribe(TSubscriber* subscriber)
+    {
+        return subscribe(&invoke<TSubscriber, Method>, subscriber);
+    }
+
+    /**
+     * @brief Subscribe a free function to this event type.
+     * @param handler Function called for each published event
+     * @param context Optional pointer passed back to the handler
+     * @return true if subscribed, false if the subscriber table is full
+     */
+    static bool subscribe(Handler handler, void* context = nullptr)
+    {
+        if (!handler || _count >= EventBusMaxSubscribers)
+            return false;
+
+        _subscribers[_count].handler = handler;
+        _subscribers[_count].context = context;
+        _count++;
+        return true;
+    }
+
+    /**
+     * @brief Deliver an event to every subscriber of this type.
+     * @param event Event data
+     */
+    static void publish(const TEvent& event)
+    {
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            _subscribers[i].handler(_subscribers[i].context, event);
+        }
+    }
+
+    /**
+     * @brief Number of subscribers registered for this event type.
+     */
+    static uint8_t subscriberCount() { return _count; }
+
+private:
+    struct Subscriber
+    {
+        Handler handler;
+        void* context;
+    };
+
+    template <typename TSubscriber, void (TSubscriber::*Method)(const TEvent&)>
+    static void invoke(void* context, const TEvent& event)
+    {
+        (static_cast<TSubscriber*>(context)->*Method)(event);
+    }
+
+    static Subscriber _subscribers[EventBusMaxSubscribers];
+    static uint8_t _count;
+};
+
+template <typename TEvent>
+typename EventBus<TEvent>::Subscriber EventBus<TEvent>::_subscribers[EventBusMaxSubscribers];
+
+template <typename TEvent>
+uint8_t EventBus<TEvent>::_count = 0;
+
+/**
+ * @brief Publish an event, deducing the bus from the event type.
+ * @param event Event data
+ */
+template <typename TEvent>
+inline void publishEvent(const TEvent& event)
+{
+    EventBus<TEvent>::publish(event);
+}
@@ -0,0 +1,38 @@
+#include "EventLogger.h"
+
+const char EventLoggerIdentifier[] = "EVENT";
+
+EventLogger::EventLogger(SerialCommandManager* commandMgrComputer)
+    : _commandMgrComputer(commandMgrComputer)
+{
+    EventBus<RelayStateEvent>::subscribe<EventLogger, &EventLogger::onRelayState>(this);
+    EventBus<SoundSignalEvent>::subscribe<EventLogger, &EventLogger::onSoundSignal>(this);
+    EventBus<WarningsChangedEvent>::subscribe<EventLogger, &EventLogger::onWarningsChanged>(this);
+}
+
+void EventLogger::onRelayState(const RelayStateEvent& event)
+{
+    if (!_commandMgrComputer)
+        return;
+
+    _commandMgrComputer->sendDebug(String(F("Relay ")) + String(event.relayIndex) + (event.isOn ? F(" ON") : F(" OFF")),
+        EventLoggerIdentifier);
+}
+
+void EventLogger::onSoundSignal(const SoundSignalEvent& event)
+{
+    if (!_commandMgrComputer)
+        return;
+
+    _commandMgrComputer->sendDebug(String(F("Sound signal ")) + String(event.soundType) + String(F(" state ")) + String(event.soundState),
+        EventLoggerIdentifier);
+}
+
+void EventLogger::onWarningsChanged(const WarningsChangedEvent& event)
+{
+    if (!_commandMgrComputer)
+        return;
+
+    _commandMgrComputer->sendDebug(String(F("Warnings 0x")) + String(event.activeWarnings, HEX),
+        EventLoggerIdentifier);
+}
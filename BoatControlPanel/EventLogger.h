@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SerialCommandManager.h>
+#include "EventBus.h"
+#include "BoatEvents.h"
+
+/**
+ * @class EventLogger
+ * @brief Sends debug messages to the computer for selected EventBus events.
+ *
+ * Subscribes to state changes that are useful when diagnosing the link
+ * (relay states, sound signals and warnings), keeping logging out of the
+ * pages that render them.
+ */
+class EventLogger
+{
+private:
+    SerialCommandManager* _commandMgrComputer;
+
+    void onRelayState(const RelayStateEvent& event);
+    void onSoundSignal(const SoundSignalEvent& event);
+    void onWarningsChanged(const WarningsChangedEvent& event);
+
+public:
+    explicit EventLogger(SerialCommandManager* commandMgrComputer);
+};
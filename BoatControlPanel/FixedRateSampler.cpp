@@ -0,0 +1,83 @@
+#include "FixedRateSampler.h"
+
+constexpr unsigned long MicrosPerSecond = 1000000UL;
+
+FixedRateSampler::FixedRateSampler(unsigned long periodUs)
+    : _periodUs(periodUs > 0 ? periodUs : 1),
+      _nextDueUs(0),
+      _lastSampleUs(0),
+      _started(false)
+{
+    resetStats();
+}
+
+void FixedRateSampler::setRate(uint16_t rateHz)
+{
+    if (rateHz == 0)
+        return;
+
+    _periodUs = MicrosPerSecond / rateHz;
+    _started = false;
+    resetStats();
+}
+
+bool FixedRateSampler::isDue(unsigned long nowUs)
+{
+    if (!_started)
+    {
+        // First sample is taken immediately and sets the phase
+        _started = true;
+        _nextDueUs = nowUs + _periodUs;
+        _lastSampleUs = nowUs;
+        _sampleCount++;
+        return true;
+    }
+
+    // Wrap safe comparison, not yet due
+    long lateness = static_cast<long>(nowUs - _nextDueUs);
+    if (lateness < 0)
+        return false;
+
+    // Whole periods that passed without a sample are missed deadlines,
+    // skip them but keep the original phase
+    unsigned long missed = static_cast<unsigned long>(lateness) / _periodUs;
+    _missedCount += missed;
+    _nextDueUs += (missed + 1) * _periodUs;
+
+    long jitter = static_cast<long>(nowUs - _lastSampleUs) - static_cast<long>(_periodUs);
+    _lastSampleUs = nowUs;
+
+    // Intervals that span missed deadlines are not jitter, they are counted above
+    if (missed == 0)
+    {
+        if (_jitterCount == 0 || jitter < _jitterMin)
+            _jitterMin = jitter;
+
+        if (_jitterCount == 0 || jitter > _jitterMax)
+            _jitterMax = jitter;
+
+        _jitterSum += jitter;
+        _jitterCount++;
+    }
+
+    _sampleCount++;
+    return true;
+}
+
+void FixedRateSampler::resetStats()
+{
+    _sampleCount = 0;
+    _missedCount = 0;
+    _jitterCount = 0;
+    _jitterMin = 0;
+    _jitterMax = 0;
+    _jitterSum = 0;
+}
+
+long FixedRateSampler::getJitterMean() const
+{
+    if (_jitterCount == 0)
+        return 0;
+
+    return static_cast<long>(_jitterSum / static_cast<int64_t>(_jitterCount));
+}
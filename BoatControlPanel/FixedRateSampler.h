@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @class FixedRateSampler
+ * @brief Drift-free fixed-rate deadline generator with timing statistics.
+ *
+ * Deadlines advance by exactly one period from the previous deadline, not
+ * from the time the sample was taken, so a late loop iteration does not
+ * shift every following sample. If the loop falls more than a whole period
+ * behind, the skipped deadlines are counted as missed and the sampler
+ * resynchronises to the original phase.
+ *
+ * Jitter is the measured interval between two samples minus the nominal
+ * period, in microseconds.
+ *
+ * Usage:
+ * @code
+ * FixedRateSampler compassSampler(40000);     // 25 Hz
+ *
+ * void loop() {
+ *     if (compassSampler.isDue(micros()))
+ *         compass.requestSample();
+ * }
+ * @endcode
+ */
+class FixedRateSampler
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param periodUs Sample period in microseconds
+     */
+    explicit FixedRateSampler(unsigned long periodUs);
+
+    /**
+     * @brief Set the sample rate.
+     * @param rateHz Samples per second, 0 is ignored
+     */
+    void setRate(uint16_t rateHz);
+
+    /**
+     * @brief Get the sample period.
+     * @return Period in microseconds
+     */
+    unsigned long getPeriod() const { return _periodUs; }
+
+    /**
+     * @brief Check whether a sample is due and advance the deadline if so.
+     * @param nowUs Current time in microseconds (from micros())
+     * @return true if the caller should take a sample now
+     */
+    bool isDue(unsigned long nowUs);
+
+    /**
+     * @brief Clear the timing statistics.
+     */
+    void resetStats();
+
+    uint32_t getSampleCount() const { return _sampleCount; }
+    uint32_t getMissedCount() const { return _missedCount; }
+    long getJitterMin() const { return _jitterCount ? _jitterMin : 0; }
+    long getJitterMax() const { return _jitterCount ? _jitterMax : 0; }
+    long getJitterMean() const;
+
+private:
+    unsigned long _periodUs;
+    unsigned long _nextDueUs;
+    unsigned long _lastSampleUs;
+    bool _started;
+
+    // Statistics
+    uint32_t _sampleCount;
+    uint32_t _missedCount;
+    uint32_t _jitterCount;
+    long _jitterMin;
+    long _jitterMax;
+    int64_t _jitterSum;
+};
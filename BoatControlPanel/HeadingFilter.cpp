@@ -0,0 +1,81 @@
+#include "HeadingFilter.h"
+
+HeadingFilter::HeadingFilter(unsigned long timeConstantMs)
+    : _timeConstantMs(timeConstantMs)
+{
+    reset();
+}
+
+void HeadingFilter::reset()
+{
+    _headingSin = _headingCos = 0;
+    _heading = _previousHeading = _rateOfTurn = 0;
+    _initialised = false;
+}
+
+void HeadingFilter::update(CompassReal east, CompassReal north, CompassReal dt)
+{
+    const CompassReal radToDeg = 57.2957795131;
+
+    // Normalise to a unit vector so field strength does not weight the average
+    CompassReal magnitude = compassSqrt(east * east + north * north);
+    if (magnitude == CompassReal(0))
+    {
+        return;
+    }
+
+    east = east / magnitude;
+    north = north / magnitude;
+
+    bool firstHeading = !_initialised;
+
+    if (!_initialised || _timeConstantMs == 0)
+    {
+        _headingSin = east;
+        _headingCos = north;
+        _initialised = true;
+    }
+    else
+    {
+        // First order low pass, alpha = dt / (tau + dt)
+        CompassReal tau = CompassReal(static_cast<long>(_timeConstantMs)) / CompassReal(1000);
+        CompassReal alpha = dt / (tau + dt);
+
+        _headingSin += (east - _headingSin) * alpha;
+        _headingCos += (north - _headingCos) * alpha;
+    }
+
+    _previousHeading = _heading;
+    _heading = compassAtan2(_headingSin, _headingCos) * radToDeg;
+    if (_heading < CompassReal(0)) _heading += CompassReal(360);
+
+    if (firstHeading)
+    {
+        // Nothing to differentiate against yet
+        _previousHeading = _heading;
+        _rateOfTurn = 0;
+        return;
+    }
+
+    updateRateOfTurn(dt);
+}
+
+void HeadingFilter::updateRateOfTurn(CompassReal dt)
+{
+    if (dt <= CompassReal(0))
+    {
+        return;
+    }
+
+    // Shortest way round, so 359 -> 1 is +2 degrees rather than -358
+    CompassReal delta = _heading - _previousHeading;
+    if (delta > CompassReal(180))
+        delta -= CompassReal(360);
+    else if (delta < CompassReal(-180))
+        delta += CompassReal(360);
+
+    // Low pass the derivative, alpha = dt / (tau + dt)
+    CompassReal tau = CompassReal(static_cast<long>(RateOfTurnTimeConstantMs)) / CompassReal(1000);
+    CompassReal alpha = dt / (tau + dt);
+    _rateOfTurn += (delta / dt - _rateOfTurn) * alpha;
+}
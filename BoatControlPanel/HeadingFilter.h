@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CompassMath.h"
+
+// Default time constant of the heading filter in milliseconds
+constexpr unsigned long DefaultHeadingTimeConstantMs = 500;
+
+// Time constant of the rate of turn filter in milliseconds, differentiating
+// amplifies noise so this is longer than the heading filter
+constexpr unsigned long RateOfTurnTimeConstantMs = 2000;
+
+/**
+ * @class HeadingFilter
+ * @brief Smooths the tilt compensated heading and derives the rate of turn.
+ *
+ * The heading vector is normalised and low pass filtered as a unit vector
+ * (alpha = dt / (tau + dt)), the heading is taken from the filtered vector,
+ * so readings either side of north average to north instead of swinging
+ * through south. Rate of turn is the filtered derivative of the heading,
+ * taking the shortest way round. Constant memory and work per sample, in
+ * the numeric type selected by COMPASS_MATH.
+ */
+class HeadingFilter
+{
+public:
+    explicit HeadingFilter(unsigned long timeConstantMs = DefaultHeadingTimeConstantMs);
+
+    /**
+     * @brief Restart from the next sample.
+     */
+    void reset();
+
+    /**
+     * @brief Add one heading vector.
+     * @param east East component of the horizontal field
+     * @param north North component of the horizontal field
+     * @param dt Seconds since the previous sample
+     */
+    void update(CompassReal east, CompassReal north, CompassReal dt);
+
+    void setTimeConstant(unsigned long timeConstantMs) { _timeConstantMs = timeConstantMs; }
+    unsigned long getTimeConstant() const { return _timeConstantMs; }
+
+    CompassReal getHeading() const { return _heading; }          // degrees, 0..360
+    CompassReal getRateOfTurn() const { return _rateOfTurn; }    // degrees per second, positive turning to starboard
+
+private:
+    void updateRateOfTurn(CompassReal dt);
+
+    CompassReal _headingSin, _headingCos;
+    CompassReal _heading;
+    CompassReal _previousHeading;
+    CompassReal _rateOfTurn;
+    unsigned long _timeConstantMs;
+    bool _initialised;
+};
@@ -1,31 +1,43 @@
 #include "HomePage.h"
+#include "SensorRegistry.h"
 
 
 // Nextion Names/Ids on current Home Page
-constexpr float CompassTemperatureWarningValue = 35;
 constexpr char ControlHumidity[] = "t3";
 constexpr char ControlTemperature[] = "t2";
 constexpr char ControlBearingText[] = "t6";
 constexpr char ControlBearingDirection[] = "t4";
+constexpr char ControlRateOfTurn[] = "t7";
 constexpr char ControlSpeed[] = "t5";
 constexpr char ControlBoatName[] = "t0";
 constexpr char ControlWarning[] = "p2";
 constexpr char NoValueText[] = "--";
-constexpr char SpeedUnitKnots[] = "%d kn";
+constexpr char SpeedUnitKnots[] = "%d.%d kn";
 constexpr char BearingFormat[] = "%d°";
+constexpr char RateOfTurnFormat[] = "%+d°/m";
 constexpr char PercentSuffix[] = "%";
 constexpr char CelsiusSuffix[] = "C";
 constexpr char ButtonOn[] = "=1";
 constexpr char ButtonOff[] = "=0";
 
 
-constexpr uint8_t Button1 = 1; // b1
-constexpr uint8_t Button2 = 2; // b2
-constexpr uint8_t Button3 = 3; // b3
-constexpr uint8_t Button4 = 4; // b4
-constexpr uint8_t ButtonNext = 12;
-constexpr uint8_t ButtonWarning = 13;
-constexpr uint8_t ButtonIdOffset = 1; // Offset to map button IDs to array indices
+// Component registry, indexed by Nextion component id
+const PageComponent HomeComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                    // 0 page
+    { "b1", ComponentRole::RelayButton, 0, nullptr },           // 1
+    { "b2", ComponentRole::RelayButton, 1, nullptr },           // 2
+    { "b3", ComponentRole::RelayButton, 2, nullptr },           // 3
+    { "b4", ComponentRole::RelayButton, 3, nullptr },           // 4
+    { "", ComponentRole::None, 0, nullptr },                    // 5
+    { "", ComponentRole::None, 0, nullptr },                    // 6
+    { "", ComponentRole::None, 0, nullptr },                    // 7
+    { "", ComponentRole::None, 0, nullptr },                    // 8
+    { "", ComponentRole::None, 0, nullptr },                    // 9
+    { "", ComponentRole::None, 0, nullptr },                    // 10
+    { "", ComponentRole::None, 0, nullptr },                    // 11
+    { "", ComponentRole::Navigate, PageRelay, nullptr },        // 12 next
+    { "", ComponentRole::Navigate, PageWarning, nullptr }       // 13 warning
+};
 
 constexpr unsigned long RefreshIntervalMs = 10000;
 
@@ -36,7 +48,15 @@ HomePage::HomePage(Stream* serialPort,
                    SerialCommandManager* commandMgrComputer)
     : BaseBoatPage(serialPort, warningMgr, commandMgrLink, commandMgrComputer)
 {
-    
+    EventBus<RelayStateEvent>::subscribe<HomePage, &HomePage::onRelayState>(this);
+    EventBus<TemperatureEvent>::subscribe<HomePage, &HomePage::onTemperature>(this);
+    EventBus<HumidityEvent>::subscribe<HomePage, &HomePage::onHumidity>(this);
+    EventBus<BearingEvent>::subscribe<HomePage, &HomePage::onBearing>(this);
+    EventBus<RateOfTurnEvent>::subscribe<HomePage, &HomePage::onRateOfTurn>(this);
+    EventBus<DirectionEvent>::subscribe<HomePage, &HomePage::onDirection>(this);
+    EventBus<SpeedEvent>::subscribe<HomePage, &HomePage::onSpeed>(this);
+    EventBus<CompassTemperatureEvent>::subscribe<HomePage, &HomePage::onCompassTemperature>(this);
+    EventBus<WarningsChangedEvent>::subscribe<HomePage, &HomePage::onWarningsChanged>(this);
 }
 
 void HomePage::begin()
@@ -47,11 +67,15 @@ void HomePage::begin()
         configUpdated();
     }
 
-    for (uint8_t i = 1; i <= ConfigHomeButtons; ++i)
+    PageComponent component;
+    for (uint8_t i = 0; i < ConfigHomeButtons; ++i)
     {
-        setPicture(ButtonPrefix + String(i), ImageButtonColorGrey);
+        if (findRelayButton(HomeComponents, i, component))
+            writePicture(component.name, ImageButtonColorGrey);
 	}
     _compassTempAboveNorm = 0;
+
+    setGlobalValue(GlobalWarnings, static_cast<int32_t>(_activeWarnings));
 }
 
 void HomePage::onEnterPage()
@@ -61,16 +85,43 @@ void HomePage::onEnterPage()
         configUpdated();
     }
     
+    // Discard touches queued on a previous visit
+    _touchInput.clear();
+
     // Request relay states to update button states
     getCommandMgrLink()->sendCommand(RelayRetrieveStates, "");
     _lastRefreshTime = millis();
 
     updateAllDisplayItems();
+    updateWarning();
+}
+
+void HomePage::onLeavePage()
+{
+    // The release of a held horn button goes to the next page, stop the
+    // horn now instead of leaving it to the fuse box time limit
+    if (_touchInput.isLongPressActive())
+    {
+        SerialCommandManager* commandMgrLink = getCommandMgrLink();
+
+        if (commandMgrLink)
+            commandMgrLink->sendCommand(SoundSignalCancel, "");
+    }
+
+    _touchInput.clear();
 }
 
 void HomePage::refresh(unsigned long now)
 {
-    updateAllDisplayItems();
+    TouchAction action;
+    while (_touchInput.poll(now, action))
+    {
+        handleTouchAction(action);
+    }
+
+    // Display items are drawn on entering the page and by the EventBus
+    // handlers when a value changes, nothing is redrawn here
+
     // Send R2 command every 10 seconds to refresh relay states
     if (now - _lastRefreshTime >= RefreshIntervalMs)
     {
@@ -78,27 +129,6 @@ void HomePage::refresh(unsigned long now)
         _lastRefreshTime = now;
         getCommandMgrLink()->sendCommand(RelayRetrieveStates, "");
     }
-    
-    // Update warning display
-    WarningManager* warningMgr = getWarningManager();
-    if (warningMgr)
-    {
-        if (warningMgr->hasWarnings())
-        {
-            setPicture(ControlWarning, ImageWarning);
-        }
-        else
-        {
-            setPicture(ControlWarning, ImageBlank);
-        }
-        
-        // Update connection-related displays
-        if (warningMgr->isWarningActive(WarningType::ConnectionLost))
-        {
-            sendText(ControlHumidity, NoValueText);
-            sendText(ControlTemperature, NoValueText);
-        }
-    }
 }
 
 void HomePage::updateAllDisplayItems()
@@ -106,6 +136,7 @@ void HomePage::updateAllDisplayItems()
     updateTemperature();
     updateHumidity();
     updateBearing();
+    updateRateOfTurn();
     updateSpeed();
 	updateDirection();
 }
@@ -113,169 +144,186 @@ void HomePage::updateAllDisplayItems()
 // Handle touch events for buttons
 void HomePage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-    Config* config = getConfig();
+    PageComponent component;
 
-    if (!config)
-    {
+    if (!readPageComponent(HomeComponents, compId, component))
         return;
-    }
-
 
-    if (config->hornRelayIndex < DefaultValue &&
-        compId - 1 == config->hornRelayIndex)
+    if (component.role == ComponentRole::RelayButton)
     {
-        // relay button is configured to sound system (horn) and will be
-        // controlled via own command methods from sound pages
-        setPage(PageSoundSignals);
+        // Relay buttons are queued so bursts of taps are collapsed
+        if (eventType == EventPress)
+            _touchInput.press(compId, millis());
+        else if (eventType == EventRelease)
+            _touchInput.release(compId, millis());
         return;
     }
 
+    handleComponentTouch(component, eventType);
+}
 
-    // Map component ID to button index
-    uint8_t buttonIndex = InvalidButtonIndex;
-    switch (compId)
+void HomePage::handleTouchAction(const TouchAction& action)
+{
+    Config* config = getConfig();
+    PageComponent component;
+
+    if (!config || !readPageComponent(HomeComponents, action.compId, component) ||
+        component.role != ComponentRole::RelayButton)
     {
-        case Button1:
-        case Button2:
-        case Button3:
-        case Button4:
-            buttonIndex = compId - ButtonIdOffset;
-            break;
-
-        case ButtonNext: 
-            setPage(PageRelay);
-            return;
-
-        case ButtonWarning:
-            setPage(PageWarning);
-            return;  
-
-        default:
-            return;
+        return;
     }
 
-    // Check if we have a valid config and the button is mapped to a relay
+    uint8_t buttonIndex = component.value;
+
+    // Check the button is mapped to a relay
     if (buttonIndex >= ConfigHomeButtons)
         return;
 
     uint8_t relayIndex = _slotToRelay[buttonIndex];
 
+    if (config->hornRelayIndex < DefaultValue &&
+        relayIndex == config->hornRelayIndex)
+    {
+        // relay button is configured to sound system (horn) and will be
+        // controlled via own command methods from sound pages, the horn
+        // sounds while the button is held and a tap opens the sound pages
+        SerialCommandManager* commandMgrLink = getCommandMgrLink();
+
+        if (action.gesture == TouchGesture::LongPress)
+        {
+            if (commandMgrLink)
+                commandMgrLink->sendCommand(SoundSignalHorn, "");
+        }
+        else if (action.gesture == TouchGesture::LongPressEnd)
+        {
+            if (commandMgrLink)
+                commandMgrLink->sendCommand(SoundSignalCancel, "");
+        }
+        else
+        {
+            leavePage(PageSoundSignals);
+        }
+        return;
+    }
+
+    // Only taps toggle relays, the first tap toggles straight away and an
+    // even number of further taps leaves the relay as the first tap set it
+    if (action.gesture != TouchGesture::Tap || (action.tapCount % 2) == 0)
+        return;
+
     // Check if this button slot has a valid relay mapping
     if (relayIndex == 0xFF || relayIndex >= ConfigRelayCount)
         return;
 
-    // Get the relay short name from config (for home page display)
-    String relayName = String(config->relayShortNames[relayIndex]);
+    // Toggle button state
+    _buttonOn[buttonIndex] = !_buttonOn[buttonIndex];
 
-    SerialCommandManager* commandMgrComputer = getCommandMgrComputer();
+    // Get the appropriate color based on the new state
+    uint8_t newColor = getButtonColor(buttonIndex, _buttonOn[buttonIndex], ConfigHomeButtons);
+    _buttonImage[buttonIndex] = newColor;
 
-    if (eventType == EventPress)
+    // Update the button appearance
+    writePicture(component.name, newColor);
+    writePicture2(component.name, newColor);
+
+    // Send relay command
+    String cmd = String(relayIndex) + (_buttonOn[buttonIndex] ? ButtonOn : ButtonOff);
+    SerialCommandManager* commandMgrLink = getCommandMgrLink();
+    if (commandMgrLink)
     {
-        if (commandMgrComputer)
-        {
-            commandMgrComputer->sendDebug(relayName + String(F(" pressed")), F("HomePage"));
-        }
+        commandMgrLink->sendCommand(RelaySetState, cmd);
     }
-    else if (eventType == EventRelease)
+}
+
+void HomePage::handleText(String text)
+{
+    (void)text;
+    // nothing to handle here
+}
+
+// --- EventBus handlers ---
+void HomePage::onRelayState(const RelayStateEvent& event)
+{
+    // Find if this relay is mapped to any button on this page
+    for (uint8_t buttonIndex = 0; buttonIndex < ConfigHomeButtons; ++buttonIndex)
     {
-        if (commandMgrComputer)
+        if (_slotToRelay[buttonIndex] == event.relayIndex)
         {
-            commandMgrComputer->sendDebug(relayName + String(F(" released")), F("HomePage"));
-        }
-
-        // Toggle button state
-        _buttonOn[buttonIndex] = !_buttonOn[buttonIndex];
+            // Update internal state
+            _buttonOn[buttonIndex] = event.isOn;
 
-        // Get the appropriate color based on the new state
-        uint8_t newColor = getButtonColor(buttonIndex, _buttonOn[buttonIndex], ConfigHomeButtons);
-        _buttonImage[buttonIndex] = newColor;
+            // Get the appropriate color for the new state
+            uint8_t newColor = getButtonColor(buttonIndex, event.isOn, ConfigHomeButtons);
+            _buttonImage[buttonIndex] = newColor;
 
-        // Update the button appearance
-        setPicture(ButtonPrefix + String(buttonIndex + 1), newColor);
-        setPicture2(ButtonPrefix + String(buttonIndex + 1), newColor);
+            // Update the button appearance on display
+            PageComponent component;
+            if (isCurrentPage() && findRelayButton(HomeComponents, buttonIndex, component))
+            {
+                writePicture(component.name, newColor);
+                writePicture2(component.name, newColor);
+            }
 
-        // Send relay command
-        String cmd = String(relayIndex) + (_buttonOn[buttonIndex] ? ButtonOn : ButtonOff);
-        SerialCommandManager* commandMgrLink = getCommandMgrLink();
-        if (commandMgrLink)
-        {
-            commandMgrLink->sendCommand(RelaySetState, cmd);
+            break; // Found the button, no need to continue
         }
     }
 }
 
-void HomePage::handleText(String text)
+void HomePage::onTemperature(const TemperatureEvent& event)
 {
-    (void)text;
-    // nothing to handle here
+    setTemperature(event.value);
 }
 
-void HomePage::handleExternalUpdate(uint8_t updateType, const void* data)
+void HomePage::onHumidity(const HumidityEvent& event)
 {
-    getCommandMgrComputer()->sendDebug("HomePage::handleExternalUpdate type=" + String(updateType), F("HomePage"));
-    
-    // Call base class first to handle heartbeat ACKs
-    BaseBoatPage::handleExternalUpdate(updateType, data);
+    setHumidity(event.value);
+}
 
-    if (updateType == static_cast<uint8_t>(PageUpdateType::RelayState) && data != nullptr)
-    {
-        const RelayStateUpdate* update = static_cast<const RelayStateUpdate*>(data);
+void HomePage::onBearing(const BearingEvent& event)
+{
+    setBearing(event.value);
+}
 
-        // Find if this relay is mapped to any button on this page
-        for (uint8_t buttonIndex = 0; buttonIndex < ConfigHomeButtons; ++buttonIndex)
-        {
-            if (_slotToRelay[buttonIndex] == update->relayIndex)
-            {
-                
-                // Update internal state
-                _buttonOn[buttonIndex] = update->isOn;
+void HomePage::onRateOfTurn(const RateOfTurnEvent& event)
+{
+    setRateOfTurn(event.value);
+}
 
-                // Get the appropriate color for the new state
-                uint8_t newColor = getButtonColor(buttonIndex, update->isOn, ConfigHomeButtons);
-                _buttonImage[buttonIndex] = newColor;
+void HomePage::onDirection(const DirectionEvent& event)
+{
+    setDirection(String(event.value));
+}
 
-                // Update the button appearance on display
-                String buttonName = ButtonPrefix + String(buttonIndex + 1);
-                setPicture(buttonName, newColor);
-                setPicture2(buttonName, newColor);
+void HomePage::onSpeed(const SpeedEvent& event)
+{
+    setSpeed(event.value);
+}
 
-                // Log the update for debugging (using short name)
-                Config* config = getConfig();
-                String relayName = config ? String(config->relayShortNames[update->relayIndex]) : String(update->relayIndex);
+void HomePage::onCompassTemperature(const CompassTemperatureEvent& event)
+{
+    setCompassTemperature(event.value);
+}
 
-                break; // Found the button, no need to continue
-            }
-        }
-    }
-    else if (updateType == static_cast<uint8_t>(PageUpdateType::Temperature) && data != nullptr)
-    {
-        const FloatStateUpdate* update = static_cast<const FloatStateUpdate*>(data);
-        setTemperature(update->value);
-    }
-    else if (updateType == static_cast<uint8_t>(PageUpdateType::Humidity) && data != nullptr)
-    {
-        const IntStateUpdate* update = static_cast<const IntStateUpdate*>(data);
-        setHumidity(static_cast<float>(update->value));
-    }
-    else if (updateType == static_cast<uint8_t>(PageUpdateType::Bearing) && data != nullptr)
-    {
-        const FloatStateUpdate* update = static_cast<const FloatStateUpdate*>(data);
-        setBearing(update->value);
-    }
-    else if (updateType == static_cast<uint8_t>(PageUpdateType::Direction) && data != nullptr)
-    {
-        const CharStateUpdate* update = static_cast<const CharStateUpdate*>(data);
-        setDirection(String(update->value));
-    }
-    else if (updateType == static_cast<uint8_t>(PageUpdateType::Speed) && data != nullptr)
+void HomePage::onWarningsChanged(const WarningsChangedEvent& event)
+{
+    _activeWarnings = event.activeWarnings;
+
+    // One write per change, the warning icon blink is run by a timer on the display
+    setGlobalValue(GlobalWarnings, static_cast<int32_t>(_activeWarnings));
+
+    // Values from the fuse box are stale once the link is lost
+    WarningManager* warningMgr = getWarningManager();
+    if (warningMgr && warningMgr->isWarningActive(WarningType::ConnectionLost))
     {
-        const IntStateUpdate* update = static_cast<const IntStateUpdate*>(data);
-        setSpeed(static_cast<float>(update->value));
+        _lastTemp = NAN;
+        _lastHumidity = NAN;
     }
-    else if (updateType == static_cast<uint8_t>(PageUpdateType::CompassTemp) && data != nullptr)
+
+    if (isCurrentPage())
     {
-        const FloatStateUpdate* update = static_cast<const FloatStateUpdate*>(data);
-        setCompassTemperature(update->value);
+        updateWarning();
+        updateTemperature();
+        updateHumidity();
     }
 }
 
@@ -285,7 +333,9 @@ void HomePage::setTemperature(float tempC)
     if (isnan(_lastTemp) || _lastTemp != tempC)
     {
         _lastTemp = tempC;
-        updateTemperature();
+
+        if (isCurrentPage())
+            updateTemperature();
     }
 }
 
@@ -294,7 +344,9 @@ void HomePage::setHumidity(float humPerc)
     if (isnan(_lastHumidity) || _lastHumidity != humPerc)
     {
         _lastHumidity = humPerc;
-        updateHumidity();
+
+        if (isCurrentPage())
+            updateHumidity();
     }
 }
 
@@ -303,16 +355,35 @@ void HomePage::setBearing(float dir)
     if (isnan(_lastBearing) || _lastBearing != dir)
     {
         _lastBearing = dir;
-        updateBearing();
+
+        if (isCurrentPage())
+            updateBearing();
+    }
+}
+
+void HomePage::setRateOfTurn(float degreesPerMinute)
+{
+    // Displayed in whole degrees, only redraw when that changes
+    if (isnan(_lastRateOfTurn) || (int)_lastRateOfTurn != (int)degreesPerMinute)
+    {
+        _lastRateOfTurn = degreesPerMinute;
+
+        if (isCurrentPage())
+            updateRateOfTurn();
     }
 }
 
 void HomePage::setSpeed(float speedKn)
 {
-    if (isnan(_lastSpeed) || _lastSpeed != speedKn)
+    // NAN never compares equal, an RMC without speed must not redraw "--" every time
+    bool changed = isnan(speedKn) ? !isnan(_lastSpeed) : isnan(_lastSpeed) || _lastSpeed != speedKn;
+
+    if (changed)
     {
         _lastSpeed = speedKn;
-        updateSpeed();
+
+        if (isCurrentPage())
+            updateSpeed();
     }
 }
 
@@ -321,7 +392,9 @@ void HomePage::setDirection(String dir)
     if (_lastDirection == "" || _lastDirection != dir)
     {
         _lastDirection = dir;
-        updateDirection();
+
+        if (isCurrentPage())
+            updateDirection();
     }
 }
 
@@ -331,7 +404,7 @@ void HomePage::setCompassTemperature(float tempC)
     {
         _lastCompassTemp = tempC;
 
-        if (tempC > CompassTemperatureWarningValue && _compassTempAboveNorm < 10)
+        if (SensorRegistry::isOutsideLimits(SensorId::CompassTemperature, tempC) && _compassTempAboveNorm < 10)
         {
             _compassTempAboveNorm++;
 
@@ -383,6 +456,19 @@ void HomePage::updateBearing()
     sendText(ControlBearingText, buffer);
 }
 
+void HomePage::updateRateOfTurn()
+{
+    if (isnan(_lastRateOfTurn))
+    {
+        sendText(ControlRateOfTurn, NoValueText);
+        return;
+    }
+
+    char buffer[12];
+    snprintf(buffer, sizeof(buffer), RateOfTurnFormat, (int)_lastRateOfTurn);
+    sendText(ControlRateOfTurn, buffer);
+}
+
 void HomePage::updateSpeed()
 {
     if (isnan(_lastSpeed))
@@ -391,8 +477,11 @@ void HomePage::updateSpeed()
         return;
     }
 
-    char buffer[10];
-    snprintf(buffer, sizeof(buffer), SpeedUnitKnots, (int)_lastSpeed);
+    // one decimal without float printf support
+    int tenths = (int)(_lastSpeed * 10 + 0.5f);
+
+    char buffer[12];
+    snprintf(buffer, sizeof(buffer), SpeedUnitKnots, tenths / 10, tenths % 10);
     sendText(ControlSpeed, buffer);
 }
 
@@ -401,6 +490,12 @@ void HomePage::updateDirection()
     sendText(ControlBearingDirection, _lastDirection);
 }
 
+void HomePage::updateWarning()
+{
+    // Static fallback image, the display timer toggles it while warnings are active
+    setPicture(ControlWarning, _activeWarnings ? ImageWarning : ImageBlank);
+}
+
 void HomePage::configUpdated()
 {
     Config* config = getConfig();
@@ -412,31 +507,33 @@ void HomePage::configUpdated()
 
     // update Nextion with config details
     // Example: apply home page mapping and enabled mask to UI slots
+    PageComponent component;
     for (uint8_t button = 0; button < ConfigHomeButtons; ++button)
     {
+        if (!findRelayButton(HomeComponents, button, component))
+            continue;
+
         uint8_t relayIndex = config->homePageMapping[button];
         if (relayIndex <= 7)
         {
             _slotToRelay[button] = relayIndex;
 
-            // set picture control (button image) - control names in your Nextion might differ
-            setPicture(ButtonPrefix + String(button + 1), _buttonImage[button]);
+            // set picture control (button image)
+            writePicture(component.name, _buttonImage[button]);
 
             // Use short name for home page display
-            String shortName = String(config->relayShortNames[relayIndex]);
-            sendText(String(ButtonPrefix) + String(button + 1), shortName);
+            writeText(component.name, config->relayShortNames[relayIndex]);
         }
         else
         {
             _slotToRelay[button] = 0xFF;
             _buttonOn[button] = false;
             _buttonImage[button] = ImageButtonColorGrey;
-            setPicture(ButtonPrefix + String(button + 1), _buttonImage[button]);
-            sendText(String(ButtonPrefix) + String(button + 1), "");
+            writePicture(component.name, _buttonImage[button]);
+            writeText(component.name, "");
         }
     }
 
     // Update the boat name
-    String boatName = String(config->boatName);
-    sendText(ControlBoatName, boatName);
+    writeText(ControlBoatName, config->boatName);
 }
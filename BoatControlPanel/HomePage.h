@@ -8,6 +8,7 @@
 #include "BaseBoatPage.h"
 #include "NextionIds.h"
 #include "BoatControlPanelConstants.h"
+#include "TouchInput.h"
 
 class HomePage : public BaseBoatPage {
 private:
@@ -15,23 +16,42 @@ private:
     float _lastTemp = NAN;
     float _lastHumidity = NAN;
     float _lastBearing = NAN;
+    float _lastRateOfTurn = NAN;
     float _lastSpeed = NAN;
     String _lastDirection = "";
     float _lastCompassTemp = NAN;
     byte _compassTempAboveNorm = 0;
+    uint32_t _activeWarnings = 0;
 	bool _buttonOn[ConfigHomeButtons] = { false, false, false, false };
 	byte _buttonImage[ConfigHomeButtons] = { ImageButtonColorGrey, ImageButtonColorGrey, ImageButtonColorGrey, ImageButtonColorGrey };
 	const byte _buttonImageOn[ConfigHomeButtons] = { ImageButtonColorBlue, ImageButtonColorBlue, ImageButtonColorBlue, ImageButtonColorBlue };
 
     uint8_t _slotToRelay[ConfigHomeButtons] = { 0xFF, 0xFF, 0xFF, 0xFF }; // map home slots 0..3 -> relay index 0..7 or 0xFF empty
 
+    // Relay button touches are queued and handled from refresh()
+    TouchInput _touchInput;
+    void handleTouchAction(const TouchAction& action);
+
     // Internal methods to update the display
     void updateTemperature();
     void updateHumidity();
     void updateBearing();
+    void updateRateOfTurn();
     void updateSpeed();
     void updateDirection();
     void updateAllDisplayItems();
+    void updateWarning();
+
+    // EventBus handlers
+    void onRelayState(const RelayStateEvent& event);
+    void onTemperature(const TemperatureEvent& event);
+    void onHumidity(const HumidityEvent& event);
+    void onBearing(const BearingEvent& event);
+    void onRateOfTurn(const RateOfTurnEvent& event);
+    void onDirection(const DirectionEvent& event);
+    void onSpeed(const SpeedEvent& event);
+    void onCompassTemperature(const CompassTemperatureEvent& event);
+    void onWarningsChanged(const WarningsChangedEvent& event);
 
 protected:
     // Required overrides
@@ -41,9 +61,9 @@ protected:
 
     //optional overrides
 	void onEnterPage() override;
+    void onLeavePage() override;
     void handleTouch(uint8_t compId, uint8_t eventType) override;
     void handleText(String text) override;
-    void handleExternalUpdate(uint8_t updateType, const void* data) override;
 
 public:
     explicit HomePage(Stream* serialPort,
@@ -58,6 +78,7 @@ public:
     void setTemperature(float tempC);
     void setHumidity(float humPerc);
     void setBearing(float dir);
+    void setRateOfTurn(float degreesPerMinute);
     void setSpeed(float speedKn);
     void setDirection(String dir);
     void setCompassTemperature(float tempC);
@@ -10,6 +10,7 @@ constexpr uint8_t PageSoundFogSignals = 6;
 constexpr uint8_t PageSoundOvertaking = 7;
 constexpr uint8_t PageSoundEmergency = 8;
 constexpr uint8_t PageSoundOther = 9;
+constexpr uint8_t PageTrend = 10;
 
 constexpr uint8_t InvalidButtonIndex = 0xFF;
 
@@ -35,6 +36,9 @@ constexpr uint8_t ImageNextButton = 13;
 // page
 constexpr char PageOne[] = "page 1";
 
-// general
-constexpr char ButtonPrefix[] = "b";
+// Global variables (vscope global, defined on the splash page), read by
+// timer events on the display to run animations locally
+constexpr char GlobalWarnings[] = "Splash.vWarn";           // active warnings bitmap
+constexpr char GlobalSoundType[] = "Splash.vSndType";       // active sound signal type, 0 = none
+constexpr char GlobalSoundState[] = "Splash.vSndState";     // sound signal state
 
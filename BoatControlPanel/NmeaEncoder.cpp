@@ -0,0 +1,173 @@
+#include "NmeaEncoder.h"
+
+#include <math.h>
+
+constexpr uint8_t NmeaEncoderMaxDecimals = 4;
+
+// Headings are sent with one decimal, anything from 359.95 rounds to 360.0
+constexpr uint8_t NmeaHeadingDecimals = 1;
+constexpr float NmeaHeadingWrap = 359.95f;
+
+// "*hh\r\n" appended by finish()
+constexpr uint8_t NmeaEncoderTrailerLength = 5;
+
+static const char HexDigits[] = "0123456789ABCDEF";
+
+NmeaEncoder::NmeaEncoder()
+    : _length(0), _overflow(false)
+{
+    _buffer[0] = '\0';
+}
+
+void NmeaEncoder::begin(const char* sentenceType)
+{
+    _length = 0;
+    _overflow = false;
+
+    appendChar('$');
+    appendText(NmeaTalkerId);
+    appendText(sentenceType);
+}
+
+void NmeaEncoder::startField()
+{
+    appendChar(',');
+}
+
+void NmeaEncoder::addEmpty()
+{
+    startField();
+}
+
+void NmeaEncoder::addText(const char* text)
+{
+    startField();
+
+    if (text)
+        appendText(text);
+}
+
+void NmeaEncoder::addFloat(float value, uint8_t decimals)
+{
+    startField();
+
+    if (isnan(value) || isinf(value))
+        return;
+
+    if (decimals > NmeaEncoderMaxDecimals)
+        decimals = NmeaEncoderMaxDecimals;
+
+    uint32_t scale = 1;
+    for (uint8_t i = 0; i < decimals; i++)
+        scale *= 10;
+
+    bool negative = value < 0;
+
+    if (negative)
+        value = -value;
+
+    // Rounded once as a scaled integer so 9.96 with one decimal becomes 10.0
+    uint32_t scaled = static_cast<uint32_t>(value * scale + 0.5f);
+
+    // -0.01 with one decimal is 0.0, not -0.0
+    if (negative && scaled > 0)
+        appendChar('-');
+    uint32_t whole = scaled / scale;
+    uint32_t fraction = scaled % scale;
+
+    char digits[10];
+    uint8_t count = 0;
+
+    do
+    {
+        digits[count++] = '0' + (whole % 10);
+        whole /= 10;
+    } while (whole > 0 && count < sizeof(digits));
+
+    while (count > 0)
+        appendChar(digits[--count]);
+
+    if (decimals == 0)
+        return;
+
+    appendChar('.');
+
+    for (uint32_t divisor = scale / 10; divisor > 0; divisor /= 10)
+    {
+        appendChar('0' + (fraction / divisor) % 10);
+    }
+}
+
+const char* NmeaEncoder::finish()
+{
+    if (_overflow || _length + NmeaEncoderTrailerLength > NmeaEncoderMaxLength)
+    {
+        _length = 0;
+        _buffer[0] = '\0';
+        return nullptr;
+    }
+
+    // XOR of everything between $ and *
+    uint8_t checksum = 0;
+    for (uint8_t i = 1; i < _length; i++)
+        checksum ^= static_cast<uint8_t>(_buffer[i]);
+
+    appendChar('*');
+    appendChar(HexDigits[checksum >> 4]);
+    appendChar(HexDigits[checksum & 0x0F]);
+    appendChar('\r');
+    appendChar('\n');
+
+    _buffer[_length] = '\0';
+    return _buffer;
+}
+
+void NmeaEncoder::addHeading(float heading)
+{
+    // 0 <= heading < 360 as printed, 359.96 is sent as 0.0 rather than 360.0
+    heading = fmodf(heading, 360.0f);
+
+    if (heading < 0)
+        heading += 360.0f;
+
+    if (heading >= NmeaHeadingWrap)
+        heading = 0;
+
+    addFloat(heading, NmeaHeadingDecimals);
+}
+
+const char* NmeaEncoder::encodeHdg(float magneticHeading)
+{
+    begin("HDG");
+    addHeading(magneticHeading);
+    addEmpty();     // deviation
+    addEmpty();
+    addEmpty();     // variation
+    addEmpty();
+    return finish();
+}
+
+const char* NmeaEncoder::encodeHdm(float magneticHeading)
+{
+    begin("HDM");
+    addHeading(magneticHeading);
+    addText("M");
+    return finish();
+}
+
+void NmeaEncoder::appendChar(char c)
+{
+    if (_length >= NmeaEncoderMaxLength)
+    {
+        _overflow = true;
+        return;
+    }
+
+    _buffer[_length++] = c;
+}
+
+void NmeaEncoder::appendText(const char* text)
+{
+    while (*text)
+        appendChar(*text++);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdint.h>
+
+// Talker for sentences made up from several sensors (integrated instrumentation)
+constexpr char NmeaTalkerId[] = "II";
+
+// NMEA 0183 sentence limit, $ to checksum plus CR LF
+constexpr uint8_t NmeaEncoderMaxLength = 82;
+
+/**
+ * @class NmeaEncoder
+ * @brief Formats NMEA 0183 sentences into a fixed buffer.
+ *
+ * A sentence is built field by field with begin(), the add methods and
+ * finish(), which appends the checksum and CR LF and returns the buffer.
+ * Numbers are formatted without printf float support (not available on
+ * AVR) and nothing is allocated, the returned pointer stays valid until
+ * the next begin(). A sentence that would exceed the NMEA length limit is
+ * discarded and finish() returns nullptr.
+ *
+ * @code
+ * encoder.begin("HDM");
+ * encoder.addFloat(heading, 1);
+ * encoder.addText("M");
+ * Serial3.print(encoder.finish());
+ * @endcode
+ */
+class NmeaEncoder
+{
+public:
+    NmeaEncoder();
+
+    /**
+     * @brief Start a sentence.
+     * @param sentenceType Three letter type, e.g. "HDG"
+     */
+    void begin(const char* sentenceType);
+
+    /**
+     * @brief Append a numeric field.
+     * @param decimals Digits after the decimal point (0..4), NAN gives an empty field
+     */
+    void addFloat(float value, uint8_t decimals);
+
+    /**
+     * @brief Append a heading in degrees with one decimal, wrapped to 0.0..359.9.
+     */
+    void addHeading(float heading);
+
+    /**
+     * @brief Append a text field, nullptr gives an empty field.
+     */
+    void addText(const char* text);
+
+    /**
+     * @brief Append an empty field.
+     */
+    void addEmpty();
+
+    /**
+     * @brief Complete the sentence.
+     * @return The sentence including checksum and CR LF, or nullptr if it overflowed
+     */
+    const char* finish();
+
+    /**
+     * @brief Length of the last finished sentence.
+     */
+    uint8_t length() const { return _length; }
+
+    // Sentences used by the panel
+
+    /**
+     * @brief Heading, deviation and variation (HDG), deviation and variation left empty.
+     */
+    const char* encodeHdg(float magneticHeading);
+
+    /**
+     * @brief Heading magnetic (HDM).
+     */
+    const char* encodeHdm(float magneticHeading);
+
+private:
+    void appendChar(char c);
+    void appendText(const char* text);
+    void startField();
+
+    char _buffer[NmeaEncoderMaxLength + 1];
+    uint8_t _length;
+    bool _overflow;
+};
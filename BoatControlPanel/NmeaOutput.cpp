@@ -0,0 +1,164 @@
+#include "NmeaOutput.h"
+
+NmeaOutput::NmeaOutput(Stream* computerPort, Stream* auxPort)
+    : _computerPort(computerPort), _auxPort(auxPort), _port(nullptr),
+      _intervalMs(1000 / DefaultNmeaRateHz), _nextOutputMs(0),
+      _nextSentence(NmeaSentenceSetSize), _sentence(nullptr),
+      _heading(NAN), _airTemperature(NAN), _humidity(NAN), _compassTemperature(NAN),
+      _waterLevel(0), _waterLevelValid(false)
+{
+    EventBus<BearingEvent>::subscribe<NmeaOutput, &NmeaOutput::onBearing>(this);
+    EventBus<TemperatureEvent>::subscribe<NmeaOutput, &NmeaOutput::onTemperature>(this);
+    EventBus<HumidityEvent>::subscribe<NmeaOutput, &NmeaOutput::onHumidity>(this);
+    EventBus<CompassTemperatureEvent>::subscribe<NmeaOutput, &NmeaOutput::onCompassTemperature>(this);
+    EventBus<WaterLevelEvent>::subscribe<NmeaOutput, &NmeaOutput::onWaterLevel>(this);
+}
+
+void NmeaOutput::configUpdated(const Config* config)
+{
+    if (!config)
+        return;
+
+    switch (config->nmeaOutputPort)
+    {
+        case NmeaPortComputer:
+            _port = _computerPort;
+            break;
+
+        case NmeaPortAux:
+            _port = _auxPort;
+            break;
+
+        default:
+            _port = nullptr;
+            break;
+    }
+
+    uint8_t rate = config->nmeaOutputRateHz;
+    if (rate == 0 || rate > NmeaMaxRateHz)
+        rate = DefaultNmeaRateHz;
+
+    _intervalMs = 1000 / rate;
+    _nextOutputMs = millis();
+
+    // Sentences not yet written start again on the new port
+    _nextSentence = NmeaSentenceSetSize;
+    _sentence = nullptr;
+}
+
+void NmeaOutput::update(unsigned long now)
+{
+    if (!_port)
+        return;
+
+    if (_nextSentence >= NmeaSentenceSetSize)
+    {
+        if ((long)(now - _nextOutputMs) < 0)
+            return;
+
+        _nextOutputMs += _intervalMs;
+
+        // Resynchronise rather than burst if output fell behind
+        if ((long)(now - _nextOutputMs) >= 0)
+            _nextOutputMs = now + _intervalMs;
+
+        _nextSentence = 0;
+        _sentence = nullptr;
+    }
+
+    while (_nextSentence < NmeaSentenceSetSize)
+    {
+        if (!_sentence)
+        {
+            _sentence = encodeSentence(_nextSentence);
+
+            // Nothing to report for this one
+            if (!_sentence)
+            {
+                _nextSentence++;
+                continue;
+            }
+        }
+
+        if (!writePending())
+            return;
+
+        _sentence = nullptr;
+        _nextSentence++;
+    }
+}
+
+bool NmeaOutput::writePending()
+{
+    // Whole sentences only, a part written now could be split by a command reply
+    if (_port->availableForWrite() < _encoder.length())
+        return false;
+
+    _port->write(reinterpret_cast<const uint8_t*>(_sentence), _encoder.length());
+    return true;
+}
+
+const char* NmeaOutput::encodeSentence(uint8_t index)
+{
+    switch (index)
+    {
+        case 0:
+            return isnan(_heading) ? nullptr : _encoder.encodeHdg(_heading);
+
+        case 1:
+            return isnan(_heading) ? nullptr : _encoder.encodeHdm(_heading);
+
+        case 2:
+            return isnan(_airTemperature) ? nullptr : encodeXdr("C", _airTemperature, 1, "C", "AIRTEMP");
+
+        case 3:
+            return isnan(_humidity) ? nullptr : encodeXdr("P", _humidity, 0, "P", "HUMIDITY");
+
+        case 4:
+            return isnan(_compassTemperature) ? nullptr : encodeXdr("C", _compassTemperature, 1, "C", "COMPASS");
+
+        case 5:
+            // Generic transducer, raw probe reading without a unit
+            return _waterLevelValid ? encodeXdr("G", _waterLevel, 0, nullptr, "BILGE") : nullptr;
+
+        default:
+            return nullptr;
+    }
+}
+
+const char* NmeaOutput::encodeXdr(const char* type, float value, uint8_t decimals, const char* unit, const char* name)
+{
+    // One transducer per XDR so each sentence fits the transmit buffer on its own
+    _encoder.begin("XDR");
+    _encoder.addText(type);
+    _encoder.addFloat(value, decimals);
+    _encoder.addText(unit);
+    _encoder.addText(name);
+    return _encoder.finish();
+}
+
+void NmeaOutput::onBearing(const BearingEvent& event)
+{
+    _heading = event.value;
+}
+
+void NmeaOutput::onTemperature(const TemperatureEvent& event)
+{
+    _airTemperature = event.value;
+}
+
+void NmeaOutput::onHumidity(const HumidityEvent& event)
+{
+    _humidity = event.value;
+}
+
+void NmeaOutput::onCompassTemperature(const CompassTemperatureEvent& event)
+{
+    _compassTemperature = event.value;
+}
+
+void NmeaOutput::onWaterLevel(const WaterLevelEvent& event)
+{
+    _waterLevel = event.value;
+    _waterLevelValid = true;
+}
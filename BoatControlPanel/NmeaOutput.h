@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "Config.h"
+#include "EventBus.h"
+#include "BoatEvents.h"
+#include "NmeaEncoder.h"
+
+// Output port numbers stored in Config::nmeaOutputPort
+constexpr uint8_t NmeaPortOff = 0;
+constexpr uint8_t NmeaPortComputer = 1;    // USB serial, shared with the command protocol
+constexpr uint8_t NmeaPortAux = 2;         // Serial3 TX, the GPS only uses RX
+
+constexpr uint8_t NmeaMaxRateHz = 10;
+constexpr uint8_t DefaultNmeaRateHz = 1;
+
+// HDG, HDM and one XDR per transducer
+constexpr uint8_t NmeaSentenceSetSize = 6;
+
+/**
+ * @class NmeaOutput
+ * @brief Streams panel sensor data as NMEA 0183 sentences.
+ *
+ * Caches the latest heading, temperatures, humidity and bilge level from
+ * the EventBus and writes a set of sentences at the configured rate so a
+ * chartplotter or navigation software can use them directly:
+ * - HDG and HDM, compass heading
+ * - XDR, cabin temperature (AIRTEMP), humidity (HUMIDITY), compass
+ *   temperature (COMPASS) and bilge level (BILGE, raw reading), one
+ *   transducer per sentence
+ *
+ * Values that have not been received are left out. Port and rate come from
+ * the config (C11).
+ *
+ * Writes never block and never split a sentence: a sentence is only
+ * written once the UART transmit buffer has room for all of it, otherwise
+ * it waits for the next update(). The computer port is shared with the
+ * command protocol, whose replies are written whole from the loop, so the
+ * two never interleave within a line. Every sentence is kept well under
+ * the 64 byte transmit buffer of the Mega UARTs so it can always fit.
+ */
+class NmeaOutput
+{
+private:
+    Stream* _computerPort;
+    Stream* _auxPort;
+    Stream* _port;
+    unsigned long _intervalMs;
+    unsigned long _nextOutputMs;
+
+    NmeaEncoder _encoder;
+    uint8_t _nextSentence;          // index in the set, NmeaSentenceSetSize when idle
+    const char* _sentence;          // encoded sentence waiting for buffer space
+
+    float _heading;
+    float _airTemperature;
+    float _humidity;
+    float _compassTemperature;
+    int16_t _waterLevel;
+    bool _waterLevelValid;
+
+    void onBearing(const BearingEvent& event);
+    void onTemperature(const TemperatureEvent& event);
+    void onHumidity(const HumidityEvent& event);
+    void onCompassTemperature(const CompassTemperatureEvent& event);
+    void onWaterLevel(const WaterLevelEvent& event);
+
+    const char* encodeSentence(uint8_t index);
+    const char* encodeXdr(const char* type, float value, uint8_t decimals, const char* unit, const char* name);
+    bool writePending();
+
+public:
+    NmeaOutput(Stream* computerPort, Stream* auxPort);
+
+    /**
+     * @brief Apply port and rate from the config.
+     */
+    void configUpdated(const Config* config);
+
+    /**
+     * @brief Start the next set of sentences when due and write what fits.
+     * @param now Current time in milliseconds (from millis())
+     */
+    void update(unsigned long now);
+
+    bool isEnabled() const { return _port != nullptr; }
+};
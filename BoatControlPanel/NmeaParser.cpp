@@ -0,0 +1,430 @@
+#include "NmeaParser.h"
+
+#include <math.h>
+
+// Coordinates are normalised to this many decimal places of minutes
+constexpr uint8_t NmeaCoordinateDecimals = 5;
+constexpr int32_t NmeaCoordinateScale = 100000;    // 10^NmeaCoordinateDecimals
+
+// Largest decoded mantissa, INT32_MAX is not defined for C++ on every AVR toolchain
+constexpr int32_t NmeaMantissaMax = 2147483647L;
+
+NmeaParser::NmeaParser()
+{
+    reset();
+}
+
+void NmeaParser::reset()
+{
+    _state = ParseState::WaitStart;
+    _sentence = NmeaSentence::None;
+    _length = 0;
+    _fieldIndex = 0;
+    _checksum = 0;
+    _receivedChecksum = 0;
+    _fieldLength = 0;
+    _coordinate = 0;
+    _coordinateValid = false;
+
+    _fix.valid = false;
+    _fix.latitudeE7 = 0;
+    _fix.longitudeE7 = 0;
+    _fix.speedKnots = NAN;
+    _fix.courseDegrees = NAN;
+    _fix.quality = 0;
+    _fix.satellites = 0;
+    _pending = _fix;
+
+    _sentenceCount = 0;
+    _checksumErrorCount = 0;
+    _ignoredCount = 0;
+}
+
+NmeaSentence NmeaParser::feed(char c)
+{
+    // A $ always starts a new sentence, so a lost byte costs at most one sentence
+    if (c == '$')
+    {
+        startSentence();
+        return NmeaSentence::None;
+    }
+
+    if (_state == ParseState::WaitStart)
+        return NmeaSentence::None;
+
+    if (++_length > NmeaMaxSentenceLength)
+    {
+        _ignoredCount++;
+        _state = ParseState::WaitStart;
+        return NmeaSentence::None;
+    }
+
+    switch (_state)
+    {
+        case ParseState::Fields:
+            if (c == '*')
+            {
+                endField();
+                _state = ParseState::Checksum1;
+            }
+            else if (c == '\r' || c == '\n')
+            {
+                // Sentences without a checksum are not trusted
+                _ignoredCount++;
+                _state = ParseState::WaitStart;
+            }
+            else
+            {
+                _checksum ^= static_cast<uint8_t>(c);
+
+                if (c == ',')
+                {
+                    endField();
+                }
+                else if (_fieldLength < NmeaMaxFieldLength)
+                {
+                    _field[_fieldLength++] = c;
+                }
+            }
+
+            // Unsupported sentence types are dropped as soon as the address is read
+            if (_state == ParseState::Fields && _fieldIndex > 0 && _sentence == NmeaSentence::None)
+            {
+                _ignoredCount++;
+                _state = ParseState::WaitStart;
+            }
+            break;
+
+        case ParseState::Checksum1:
+        case ParseState::Checksum2:
+        {
+            int8_t nibble = hexValue(c);
+
+            if (nibble < 0)
+            {
+                _checksumErrorCount++;
+                _state = ParseState::WaitStart;
+                break;
+            }
+
+            _receivedChecksum = (_receivedChecksum << 4) | nibble;
+
+            if (_state == ParseState::Checksum1)
+            {
+                _state = ParseState::Checksum2;
+                break;
+            }
+
+            _state = ParseState::WaitStart;
+            return endSentence();
+        }
+
+        default:
+            break;
+    }
+
+    return NmeaSentence::None;
+}
+
+void NmeaParser::startSentence()
+{
+    _state = ParseState::Fields;
+    _sentence = NmeaSentence::None;
+    _length = 1;
+    _fieldIndex = 0;
+    _fieldLength = 0;
+    _checksum = 0;
+    _receivedChecksum = 0;
+    _coordinateValid = false;
+
+    // Fields not carried by this sentence keep their last values
+    _pending = _fix;
+}
+
+void NmeaParser::endField()
+{
+    _field[_fieldLength] = '\0';
+    decodeField();
+
+    _fieldIndex++;
+    _fieldLength = 0;
+}
+
+NmeaSentence NmeaParser::endSentence()
+{
+    if (_receivedChecksum != _checksum)
+    {
+        _checksumErrorCount++;
+        return NmeaSentence::None;
+    }
+
+    _fix = _pending;
+    _sentenceCount++;
+    return _sentence;
+}
+
+void NmeaParser::decodeField()
+{
+    if (_fieldIndex == 0)
+    {
+        // Address is a two character talker followed by the sentence type, e.g. GPRMC
+        _sentence = NmeaSentence::None;
+
+        if (_fieldLength != 5)
+            return;
+
+        const char* type = &_field[2];
+
+        if (type[0] == 'R' && type[1] == 'M' && type[2] == 'C')
+            _sentence = NmeaSentence::Rmc;
+        else if (type[0] == 'V' && type[1] == 'T' && type[2] == 'G')
+            _sentence = NmeaSentence::Vtg;
+        else if (type[0] == 'G' && type[1] == 'G' && type[2] == 'A')
+            _sentence = NmeaSentence::Gga;
+
+        return;
+    }
+
+    switch (_sentence)
+    {
+        case NmeaSentence::Rmc:
+            decodeRmcField();
+            break;
+
+        case NmeaSentence::Vtg:
+            decodeVtgField();
+            break;
+
+        case NmeaSentence::Gga:
+            decodeGgaField();
+            break;
+
+        default:
+            break;
+    }
+}
+
+void NmeaParser::decodeRmcField()
+{
+    // $xxRMC,time,status,lat,N/S,lon,E/W,sog,cog,date,...
+    switch (_fieldIndex)
+    {
+        case 2:
+            _pending.valid = _fieldLength > 0 && _field[0] == 'A';
+            break;
+
+        case 3:
+        case 5:
+            _coordinateValid = parseCoordinate(_coordinate);
+            break;
+
+        case 4:
+            if (_coordinateValid)
+                _pending.latitudeE7 = _field[0] == 'S' ? -_coordinate : _coordinate;
+            break;
+
+        case 6:
+            if (_coordinateValid)
+                _pending.longitudeE7 = _field[0] == 'W' ? -_coordinate : _coordinate;
+            break;
+
+        case 7:
+            if (!parseFloat(_pending.speedKnots))
+                _pending.speedKnots = NAN;
+            break;
+
+        case 8:
+            if (!parseFloat(_pending.courseDegrees))
+                _pending.courseDegrees = NAN;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void NmeaParser::decodeVtgField()
+{
+    // $xxVTG,cog true,T,cog magnetic,M,sog knots,N,sog km/h,K,mode
+    switch (_fieldIndex)
+    {
+        case 1:
+            if (!parseFloat(_pending.courseDegrees))
+                _pending.courseDegrees = NAN;
+            break;
+
+        case 5:
+            if (!parseFloat(_pending.speedKnots))
+                _pending.speedKnots = NAN;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void NmeaParser::decodeGgaField()
+{
+    // $xxGGA,time,lat,N/S,lon,E/W,quality,satellites,hdop,altitude,...
+    switch (_fieldIndex)
+    {
+        case 2:
+        case 4:
+            _coordinateValid = parseCoordinate(_coordinate);
+            break;
+
+        case 3:
+            if (_coordinateValid)
+                _pending.latitudeE7 = _field[0] == 'S' ? -_coordinate : _coordinate;
+            break;
+
+        case 5:
+            if (_coordinateValid)
+                _pending.longitudeE7 = _field[0] == 'W' ? -_coordinate : _coordinate;
+            break;
+
+        case 6:
+        {
+            int32_t quality;
+            uint8_t decimals;
+
+            _pending.quality = parseDecimal(quality, decimals) ? static_cast<uint8_t>(quality) : 0;
+            _pending.valid = _pending.quality > 0;
+            break;
+        }
+
+        case 7:
+        {
+            int32_t satellites;
+            uint8_t decimals;
+
+            _pending.satellites = parseDecimal(satellites, decimals) ? static_cast<uint8_t>(satellites) : 0;
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+bool NmeaParser::parseDecimal(int32_t& mantissa, uint8_t& decimals) const
+{
+    mantissa = 0;
+    decimals = 0;
+
+    if (_fieldLength == 0)
+        return false;
+
+    uint8_t i = 0;
+    bool negative = false;
+    bool fraction = false;
+    bool digits = false;
+
+    if (_field[0] == '-')
+    {
+        negative = true;
+        i++;
+    }
+
+    for (; i < _fieldLength; i++)
+    {
+        char c = _field[i];
+
+        if (c == '.' && !fraction)
+        {
+            fraction = true;
+            continue;
+        }
+
+        if (c < '0' || c > '9')
+            return false;
+
+        int32_t digit = c - '0';
+
+        if (mantissa > (NmeaMantissaMax - digit) / 10)
+        {
+            // Extra fraction digits are below the resolution we keep
+            if (fraction)
+                break;
+
+            return false;
+        }
+
+        mantissa = mantissa * 10 + digit;
+        digits = true;
+
+        if (fraction)
+            decimals++;
+    }
+
+    if (negative)
+        mantissa = -mantissa;
+
+    return digits;
+}
+
+bool NmeaParser::parseFloat(float& value) const
+{
+    int32_t mantissa;
+    uint8_t decimals;
+
+    if (!parseDecimal(mantissa, decimals))
+        return false;
+
+    float result = static_cast<float>(mantissa);
+
+    while (decimals-- > 0)
+        result *= 0.1f;
+
+    value = result;
+    return true;
+}
+
+bool NmeaParser::parseCoordinate(int32_t& valueE7) const
+{
+    // ddmm.mmmm or dddmm.mmmm, degrees and decimal minutes
+    int32_t mantissa;
+    uint8_t decimals;
+
+    if (!parseDecimal(mantissa, decimals) || mantissa < 0)
+        return false;
+
+    while (decimals > NmeaCoordinateDecimals)
+    {
+        mantissa /= 10;
+        decimals--;
+    }
+
+    while (decimals < NmeaCoordinateDecimals)
+    {
+        if (mantissa > NmeaMantissaMax / 10)
+            return false;
+
+        mantissa *= 10;
+        decimals++;
+    }
+
+    int32_t degrees = mantissa / (100 * NmeaCoordinateScale);
+    int32_t minutes = mantissa % (100 * NmeaCoordinateScale);
+
+    if (degrees > 180)
+        return false;
+
+    // minutes * 1e5 -> degrees * 1e7 is * 100 / 60
+    valueE7 = degrees * 10000000L + (minutes * 100) / 60;
+    return true;
+}
+
+int8_t NmeaParser::hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+
+    return -1;
+}
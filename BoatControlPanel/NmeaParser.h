@@ -0,0 +1,121 @@
+#pragma once
+
+#include <stdint.h>
+
+// Longest field that is decoded, longer fields are truncated (ddmm.mmmmmm fits)
+constexpr uint8_t NmeaMaxFieldLength = 15;
+
+// NMEA 0183 caps a sentence at 82 characters including $ and CR LF
+constexpr uint8_t NmeaMaxSentenceLength = 82;
+
+enum class NmeaSentence : uint8_t
+{
+    None,       // no complete sentence yet, or one that was rejected
+    Rmc,        // recommended minimum, position, speed and course
+    Vtg,        // course and speed over ground
+    Gga         // fix quality, satellites and position
+};
+
+/**
+ * @struct NmeaFix
+ * @brief Navigation data decoded from the most recent valid sentences.
+ */
+struct NmeaFix
+{
+    bool valid;                 // RMC status A, GGA quality above zero
+    int32_t latitudeE7;         // degrees * 1e7, north positive
+    int32_t longitudeE7;        // degrees * 1e7, east positive
+    float speedKnots;           // speed over ground, NAN if not reported
+    float courseDegrees;        // course over ground (true), NAN if not reported
+    uint8_t quality;            // GGA fix quality, 0 = no fix, 1 = GPS, 2 = DGPS ...
+    uint8_t satellites;         // satellites used in the fix
+};
+
+/**
+ * @class NmeaParser
+ * @brief Incremental NMEA 0183 parser for RMC, VTG and GGA sentences.
+ *
+ * Bytes are fed one at a time as they arrive from the UART, there is no
+ * sentence buffer and no String use. Each field is decoded when its
+ * delimiter arrives into a pending copy of the fix, and the pending values
+ * are only committed when the sentence checksum matches, so a corrupted
+ * sentence never changes the published fix. Sentences from any talker
+ * (GP, GN, GL ...) are accepted, other sentence types are skipped.
+ *
+ * Numbers are decoded as scaled integers, positions are kept in 1e-7
+ * degrees so no precision is lost to the 32 bit float on AVR.
+ *
+ * Usage:
+ * @code
+ * while (GPS_SERIAL.available())
+ * {
+ *     if (gps.feed(GPS_SERIAL.read()) == NmeaSentence::Rmc)
+ *         publishEvent(SpeedEvent{ gps.getFix().speedKnots });
+ * }
+ * @endcode
+ */
+class NmeaParser
+{
+public:
+    NmeaParser();
+
+    /**
+     * @brief Consume one received byte.
+     * @return The sentence type when a supported sentence completed with a
+     * valid checksum, otherwise NmeaSentence::None
+     */
+    NmeaSentence feed(char c);
+
+    /**
+     * @brief Clear the decoded fix and statistics.
+     */
+    void reset();
+
+    const NmeaFix& getFix() const { return _fix; }
+
+    uint32_t getSentenceCount() const { return _sentenceCount; }
+    uint32_t getChecksumErrorCount() const { return _checksumErrorCount; }
+    uint32_t getIgnoredCount() const { return _ignoredCount; }
+
+private:
+    enum class ParseState : uint8_t
+    {
+        WaitStart,      // waiting for $
+        Fields,         // inside the sentence, checksum accumulating
+        Checksum1,      // first checksum hex digit
+        Checksum2       // second checksum hex digit
+    };
+
+    void startSentence();
+    void endField();
+    void decodeField();
+    void decodeRmcField();
+    void decodeVtgField();
+    void decodeGgaField();
+    NmeaSentence endSentence();
+
+    bool parseDecimal(int32_t& mantissa, uint8_t& decimals) const;
+    bool parseFloat(float& value) const;
+    bool parseCoordinate(int32_t& valueE7) const;
+    static int8_t hexValue(char c);
+
+    ParseState _state;
+    NmeaSentence _sentence;
+    uint8_t _length;
+    uint8_t _fieldIndex;
+    uint8_t _checksum;
+    uint8_t _receivedChecksum;
+    char _field[NmeaMaxFieldLength + 1];
+    uint8_t _fieldLength;
+
+    // Coordinate magnitude waiting for its hemisphere field
+    int32_t _coordinate;
+    bool _coordinateValid;
+
+    NmeaFix _fix;
+    NmeaFix _pending;
+
+    uint32_t _sentenceCount;
+    uint32_t _checksumErrorCount;
+    uint32_t _ignoredCount;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @enum ComponentRole
+ * @brief What a touchable Nextion component does on its page.
+ */
+enum class ComponentRole : uint8_t {
+    None = 0x00,        // Unused component id
+    RelayButton = 0x01, // Relay toggle, value = button slot on the page
+    Navigate = 0x02,    // Page change, value = target page id
+    Command = 0x03,     // Sends command to the link on release
+    Action = 0x04       // Handled by the page, value = page specific action
+};
+
+/**
+ * @struct PageComponent
+ * @brief Registry entry describing one Nextion component.
+ *
+ * Each page defines a PROGMEM table of these indexed by component id, so
+ * touch dispatch is a single table read and component names are not built
+ * at runtime.
+ */
+struct PageComponent {
+    char name[4];               // Nextion object name, e.g. "b1"
+    ComponentRole role;         // What the component does
+    uint8_t value;              // Relay slot or page id depending on role
+    const char* command;        // Link command for ComponentRole::Command, otherwise nullptr
+};
+
+/**
+ * @brief Read a component registry entry from flash.
+ * @param table PROGMEM table indexed by component id
+ * @param compId Nextion component id
+ * @param component Receives the entry
+ * @return true if the component id is registered, false otherwise
+ */
+template <size_t N>
+inline bool readPageComponent(const PageComponent (&table)[N], uint8_t compId, PageComponent& component)
+{
+    if (compId >= N)
+        return false;
+
+    memcpy_P(&component, &table[compId], sizeof(PageComponent));
+    return component.role != ComponentRole::None;
+}
+
+/**
+ * @brief Find the relay button registered for a button slot.
+ * @param table PROGMEM table indexed by component id
+ * @param slot Button slot on the page
+ * @param component Receives the entry
+ * @return true if a relay button is registered for the slot
+ */
+template <size_t N>
+inline bool findRelayButton(const PageComponent (&table)[N], uint8_t slot, PageComponent& component)
+{
+    for (uint8_t compId = 0; compId < N; compId++)
+    {
+        memcpy_P(&component, &table[compId], sizeof(PageComponent));
+
+        if (component.role == ComponentRole::RelayButton && component.value == slot)
+            return true;
+    }
+
+    return false;
+}
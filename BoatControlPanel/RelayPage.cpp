@@ -1,18 +1,21 @@
 #include "RelayPage.h"
 
 
-// Nextion Names/Ids on current Home Page
-constexpr uint8_t Button1 = 4; // b1
-constexpr uint8_t Button2 = 5; // b2
-constexpr uint8_t Button3 = 6; // b3
-constexpr uint8_t Button4 = 7; // b4
-constexpr uint8_t Button5 = 8; // b5
-constexpr uint8_t Button6 = 9; // b6
-constexpr uint8_t Button7 = 10; // b7
-constexpr uint8_t Button8 = 11; // b8
-constexpr uint8_t ButtonNext = 3;
-constexpr uint8_t ButtonPrevious = 2;
-constexpr uint8_t ButtonIdOffset = 4; // Offset to map button IDs to array indices
+// Component registry, indexed by Nextion component id
+const PageComponent RelayComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                        // 0 page
+    { "", ComponentRole::None, 0, nullptr },                        // 1
+    { "", ComponentRole::Navigate, PageHome, nullptr },             // 2 previous
+    { "", ComponentRole::Navigate, PageSoundSignals, nullptr },     // 3 next
+    { "b1", ComponentRole::RelayButton, 0, nullptr },               // 4
+    { "b2", ComponentRole::RelayButton, 1, nullptr },               // 5
+    { "b3", ComponentRole::RelayButton, 2, nullptr },               // 6
+    { "b4", ComponentRole::RelayButton, 3, nullptr },               // 7
+    { "b5", ComponentRole::RelayButton, 4, nullptr },               // 8
+    { "b6", ComponentRole::RelayButton, 5, nullptr },               // 9
+    { "b7", ComponentRole::RelayButton, 6, nullptr },               // 10
+    { "b8", ComponentRole::RelayButton, 7, nullptr }                // 11
+};
 
 constexpr char ButtonOn[] = "1";
 constexpr char ButtonOff[] = "0";
@@ -31,6 +34,8 @@ RelayPage::RelayPage(Stream* serialPort,
         _buttonImage[i] = ImageButtonColorGrey + ImageButtonColorOffset;
         _buttonImageOn[i] = ImageButtonColorBlue + ImageButtonColorOffset;
 	}
+
+    EventBus<RelayStateEvent>::subscribe<RelayPage, &RelayPage::onRelayState>(this);
 }
 
 void RelayPage::begin()
@@ -41,10 +46,14 @@ void RelayPage::begin()
         configUpdated();
     }
 
+    PageComponent component;
     for (uint8_t i = 0; i < ConfigRelayCount; ++i)
     {
-        setPicture(ButtonPrefix + String(i + 1), ImageButtonColorGrey + ImageButtonColorOffset);
-        setPicture2(ButtonPrefix + String(i + 1), ImageButtonColorGrey + ImageButtonColorOffset);
+        if (!findRelayButton(RelayComponents, i, component))
+            continue;
+
+        writePicture(component.name, ImageButtonColorGrey + ImageButtonColorOffset);
+        writePicture2(component.name, ImageButtonColorGrey + ImageButtonColorOffset);
 	}
 }
 
@@ -55,13 +64,37 @@ void RelayPage::onEnterPage()
         configUpdated();
     }
 
+    // Discard touches queued on a previous visit
+    _touchInput.clear();
+
     // Request relay states to update button states
     getCommandMgrLink()->sendCommand(RelayRetrieveStates, "");
     _lastRefreshTime = millis();
 }
 
+void RelayPage::onLeavePage()
+{
+    // The release of a held horn button goes to the next page, stop the
+    // horn now instead of leaving it to the fuse box time limit
+    if (_touchInput.isLongPressActive())
+    {
+        SerialCommandManager* commandMgrLink = getCommandMgrLink();
+
+        if (commandMgrLink)
+            commandMgrLink->sendCommand(SoundSignalCancel, "");
+    }
+
+    _touchInput.clear();
+}
+
 void RelayPage::refresh(unsigned long now)
 {
+    TouchAction action;
+    while (_touchInput.poll(now, action))
+    {
+        handleTouchAction(action);
+    }
+
     // Send R2 command every 10 seconds to refresh relay states
     if (now - _lastRefreshTime >= RefreshIntervalMs)
     {
@@ -74,57 +107,78 @@ void RelayPage::refresh(unsigned long now)
 // Handle touch events for buttons
 void RelayPage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-    Config* config = getConfig();
+    PageComponent component;
 
-    if (!config)
+    if (!readPageComponent(RelayComponents, compId, component))
     {
         return;
     }
 
-    if (config->hornRelayIndex < DefaultValue &&
-        compId - 4 == config->hornRelayIndex)
+    if (component.role == ComponentRole::RelayButton)
     {
-        // relay button is configured to sound system (horn) and will be
-        // controlled via own command methods from sound pages
-        setPage(PageSoundSignals);
+        // Relay buttons are queued so bursts of taps are collapsed
+        if (eventType == EventPress)
+            _touchInput.press(compId, millis());
+        else if (eventType == EventRelease)
+            _touchInput.release(compId, millis());
         return;
     }
 
-    // Map component ID to button index
-    uint8_t buttonIndex = InvalidButtonIndex;
+    handleComponentTouch(component, eventType);
+}
+
+void RelayPage::handleTouchAction(const TouchAction& action)
+{
+    Config* config = getConfig();
+    PageComponent component;
 
-    switch (compId)
+    if (!config || !readPageComponent(RelayComponents, action.compId, component) ||
+        component.role != ComponentRole::RelayButton)
     {
-    case Button1:
-    case Button2:
-    case Button3:
-    case Button4:
-    case Button5:
-    case Button6:
-    case Button7:
-    case Button8:
-        buttonIndex = compId - ButtonIdOffset;
-        break;
-
-    case ButtonNext:
-        setPage(PageSoundSignals);
         return;
+    }
 
-    case ButtonPrevious:
-        setPage(PageHome);
-        return;
+    uint8_t buttonIndex = component.value;
 
-    default:
+    // Check the button is mapped to a relay
+    if (buttonIndex >= ConfigRelayCount)
+    {
         return;
     }
 
-    // Check if we have a valid config and the button is mapped to a relay
-    if (buttonIndex >= ConfigRelayCount)
+    uint8_t relayIndex = _slotToRelay[buttonIndex];
+
+    if (config->hornRelayIndex < DefaultValue &&
+        relayIndex == config->hornRelayIndex)
     {
+        // relay button is configured to sound system (horn) and will be
+        // controlled via own command methods from sound pages, the horn
+        // sounds while the button is held and a tap opens the sound pages
+        SerialCommandManager* commandMgrLink = getCommandMgrLink();
+
+        if (action.gesture == TouchGesture::LongPress)
+        {
+            if (commandMgrLink)
+                commandMgrLink->sendCommand(SoundSignalHorn, "");
+        }
+        else if (action.gesture == TouchGesture::LongPressEnd)
+        {
+            if (commandMgrLink)
+                commandMgrLink->sendCommand(SoundSignalCancel, "");
+        }
+        else
+        {
+            leavePage(PageSoundSignals);
+        }
         return;
     }
 
-    uint8_t relayIndex = _slotToRelay[buttonIndex];
+    // Only taps toggle relays, the first tap toggles straight away and an
+    // even number of further taps leaves the relay as the first tap set it
+    if (action.gesture != TouchGesture::Tap || (action.tapCount % 2) == 0)
+    {
+        return;
+    }
 
     // Check if this button slot has a valid relay mapping
     if (relayIndex == 0xFF || relayIndex >= ConfigRelayCount)
@@ -132,82 +186,49 @@ void RelayPage::handleTouch(uint8_t compId, uint8_t eventType)
         return;
     }
 
-    // Get the relay long name from config (for home page display)
-    String relayName = String(config->relayLongNames[relayIndex]);
+    // Toggle the cached state so a corrective tap sends the opposite of
+    // the first, the R4 reply confirms it
+    _buttonOn[buttonIndex] = !_buttonOn[buttonIndex];
 
-    SerialCommandManager* commandMgrComputer = getCommandMgrComputer();
-
-    if (eventType == EventPress)
+    // Send relay command
+    SerialCommandManager* commandMgrLink = getCommandMgrLink();
+    if (commandMgrLink)
     {
-        if (commandMgrComputer)
-        {
-            commandMgrComputer->sendDebug(relayName + String(F(" pressed")), F("RelayPage"));
-        }
-    }
-    else if (eventType == EventRelease)
-    {
-        if (commandMgrComputer)
-        {
-            commandMgrComputer->sendDebug(relayName + String(F(" released")), F("RelayPage"));
-        }
-
-        // Send relay command
-        SerialCommandManager* commandMgrLink = getCommandMgrLink();
-        if (commandMgrLink)
-        {
-            // R3 to update relay status in fuse box
-            StringKeyValue param = { String(relayIndex), _buttonOn[buttonIndex] ? ButtonOff : ButtonOn };
-            commandMgrLink->sendCommand(RelaySetState, "", "", &param, 1);
-
-            // send R4 to get relay state, to confirm change and reflect any failures etc,
-            // this will prevent the UI being in an incorrect state if the command fails
-			      param.value = "";
-            commandMgrLink->sendCommand(RelayStatusGet, "", "", &param, 1);
-        }
+        // R3 to update relay status in fuse box
+        StringKeyValue param = { String(relayIndex), _buttonOn[buttonIndex] ? ButtonOn : ButtonOff };
+        commandMgrLink->sendCommand(RelaySetState, "", "", &param, 1);
+
+        // send R4 to get relay state, to confirm change and reflect any failures etc,
+        // this will prevent the UI being in an incorrect state if the command fails
+        param.value = "";
+        commandMgrLink->sendCommand(RelayStatusGet, "", "", &param, 1);
     }
 }
 
-void RelayPage::handleExternalUpdate(uint8_t updateType, const void* data)
+void RelayPage::onRelayState(const RelayStateEvent& event)
 {
-    // Call base class first to handle heartbeat ACKs
-    BaseBoatPage::handleExternalUpdate(updateType, data);
-
-    if (updateType == static_cast<uint8_t>(PageUpdateType::RelayState) && data != nullptr)
+    // Find if this relay is mapped to any button on this page
+    for (uint8_t buttonIndex = 0; buttonIndex < ConfigRelayCount; ++buttonIndex)
     {
-        const RelayStateUpdate* update = static_cast<const RelayStateUpdate*>(data);
-
-        // Find if this relay is mapped to any button on this page
-        for (uint8_t buttonIndex = 0; buttonIndex < ConfigRelayCount; ++buttonIndex)
+        if (_slotToRelay[buttonIndex] == event.relayIndex)
         {
-            if (_slotToRelay[buttonIndex] == update->relayIndex)
+            // Update internal state
+            _buttonOn[buttonIndex] = event.isOn;
+
+            // Get the appropriate color for the new state
+            uint8_t newColor = getButtonColor(buttonIndex, event.isOn, ConfigRelayCount);
+            newColor += ImageButtonColorOffset;
+            _buttonImage[buttonIndex] = newColor;
+
+            // Update the button appearance on display
+            PageComponent component;
+            if (isCurrentPage() && findRelayButton(RelayComponents, buttonIndex, component))
             {
-                // Update internal state
-                _buttonOn[buttonIndex] = update->isOn;
-
-                // Get the appropriate color for the new state
-                uint8_t newColor = getButtonColor(buttonIndex, update->isOn, ConfigRelayCount);
-                newColor += ImageButtonColorOffset;
-                _buttonImage[buttonIndex] = newColor;
-
-                // Update the button appearance on display
-                String buttonName = ButtonPrefix + String(buttonIndex + 1);
-                setPicture(buttonName, newColor);
-                setPicture2(buttonName, newColor);
-
-                // Log the update for debugging (using Long name)
-                SerialCommandManager* commandMgrComputer = getCommandMgrComputer();
-                if (commandMgrComputer)
-                {
-                    Config* config = getConfig();
-                    String relayName = config ? String(config->relayLongNames[update->relayIndex]) : String(update->relayIndex);
-                    commandMgrComputer->sendDebug(
-                        relayName + " state updated to " + (update->isOn ? F("ON") : F("OFF")),
-                        F("RelayPage")
-                    );
-                }
-
-                break;
+                writePicture(component.name, newColor);
+                writePicture2(component.name, newColor);
             }
+
+            break;
         }
     }
 }
@@ -221,6 +242,7 @@ void RelayPage::configUpdated()
         return;
     }
 
+    PageComponent component;
     for (uint8_t button = 0; button < ConfigRelayCount; ++button)
     {
         _slotToRelay[button] = button;
@@ -229,10 +251,11 @@ void RelayPage::configUpdated()
         _buttonOn[button] = false;
         _buttonImage[button] = ImageButtonColorGrey + ImageButtonColorOffset;
 
-        setPicture(ButtonPrefix + String(button), ImageButtonColorGrey + ImageButtonColorOffset);
-        setPicture2(ButtonPrefix + String(button), ImageButtonColorGrey + ImageButtonColorOffset);
+        if (!findRelayButton(RelayComponents, button, component))
+            continue;
 
-        String longName = String(config->relayLongNames[button]);
-        sendText(ButtonPrefix + String(button), longName);
+        writePicture(component.name, ImageButtonColorGrey + ImageButtonColorOffset);
+        writePicture2(component.name, ImageButtonColorGrey + ImageButtonColorOffset);
+        writeText(component.name, config->relayLongNames[button]);
     }
 }
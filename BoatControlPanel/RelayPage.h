@@ -8,6 +8,7 @@
 #include "BaseBoatPage.h"
 #include "NextionIds.h"
 #include "BoatControlPanelConstants.h"
+#include "TouchInput.h"
 
 
 class RelayPage : public BaseBoatPage {
@@ -19,6 +20,13 @@ private:
 
     uint8_t _slotToRelay[ConfigRelayCount] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
 
+    // Relay button touches are queued and handled from refresh()
+    TouchInput _touchInput;
+    void handleTouchAction(const TouchAction& action);
+
+    // EventBus handlers
+    void onRelayState(const RelayStateEvent& event);
+
 protected:
     // Required overrides
     uint8_t getPageId() const override { return PageRelay; }
@@ -27,8 +35,8 @@ protected:
 
     //optional overrides
     void onEnterPage() override;
+    void onLeavePage() override;
     void handleTouch(uint8_t compId, uint8_t eventType) override;
-    void handleExternalUpdate(uint8_t updateType, const void* data) override;
 
 public:
     explicit RelayPage(Stream* serialPort,
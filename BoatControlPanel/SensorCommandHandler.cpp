@@ -1,17 +1,8 @@
 #include "SensorCommandHandler.h"
+#include "SensorRegistry.h"
 
-const char SensorTemperature[] = "S0";
-const char SensorHumidity[] = "S1";
-const char SensorBearing[] = "S2";
-const char SensorDirection[] = "S3";
-const char SensorSpeed[] = "S4";
-const char SensorCompassTemp[] = "S5";
-const char SensorWaterLevel[] = "S6";
-const char SensorWaterPumpActive[] = "S7";
-const char SensorHornActive[] = "S8";
-
-SensorCommandHandler::SensorCommandHandler(SerialCommandManager* computerCommandManager, NextionControl* nextionControl, WarningManager* warningManager)
-    : BaseBoatCommandHandler(computerCommandManager, nextionControl, warningManager)
+SensorCommandHandler::SensorCommandHandler(SerialCommandManager* computerCommandManager, WarningManager* warningManager)
+    : BaseBoatCommandHandler(computerCommandManager, warningManager)
 {
 }
 
@@ -20,6 +11,16 @@ bool SensorCommandHandler::handleCommand(SerialCommandManager* sender, const Str
     String cmd = command;
     cmd.trim();
 
+    // S<n> indexes the sensor table directly
+    SensorDescriptor descriptor;
+    int16_t id = SensorRegistry::parseCommand(cmd);
+
+    if (id < 0 || !SensorRegistry::getDescriptor(id, descriptor))
+    {
+        sendDebugMessage(F("Unknown or invalid Sensor command"), F("SensorCommandHandler"));
+        return false;
+    }
+
     // the first param indicates the value (v=23 or v=NNW)
 
     if (paramCount == 0)
@@ -28,57 +29,31 @@ bool SensorCommandHandler::handleCommand(SerialCommandManager* sender, const Str
         return true;
     }
 
-    String key = params[0].key;
-    key.trim();
-    String val = params[0].value;
-    val.trim();
-
-    if (cmd == SensorTemperature)
+    if (descriptor.format.type == SensorValueType::Channels)
     {
-        FloatStateUpdate update = { val.toFloat() };
-        notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::Temperature), &update);
-    }
-    else if (cmd == SensorHumidity)
-    {
-        IntStateUpdate update = { static_cast<int16_t>(val.toInt()) };
-        notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::Humidity), &update);
-    }
-    else if (cmd == SensorBearing)
-    {
-        FloatStateUpdate update = { val.toFloat() };
-        notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::Bearing), &update);
-    }
-    else if (cmd == SensorDirection)
-    {
-        CharStateUpdate update = {};
-        update.length = min(val.length(), (unsigned int)(CharStateUpdate::MaxLength - 1));
-        val.toCharArray(update.value, CharStateUpdate::MaxLength);
-        notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::Direction), &update);
-    }
-    else if (cmd == SensorSpeed)
-    {
-        IntStateUpdate update = { static_cast<int16_t>(val.toInt()) };
-        notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::Speed), &update);
-    }
-    else if (cmd == SensorCompassTemp)
-    {
-        FloatStateUpdate update = { val.toFloat() };
-        notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::CompassTemp), &update);
-    }
-    else if (cmd == SensorWaterLevel)
-    {
-        IntStateUpdate update = { static_cast<int16_t>(val.toInt()) };
-        notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::WaterLevel), &update);
-    }
-    else if (cmd == SensorWaterPumpActive)
-    {
-        BoolStateUpdate update = { val.toInt() > 0 };
-        notifyCurrentPage(static_cast<uint8_t>(PageUpdateType::WaterPumpActive), &update);
+        // one <channel>=<value> param per channel
+        for (int i = 0; i < paramCount; i++)
+        {
+            if (!isAllDigits(params[i].key))
+                continue;
+
+            float value = params[i].value.toFloat() * descriptor.format.scale;
+            SensorRegistry::publish(descriptor, static_cast<uint8_t>(params[i].key.toInt()), value, nullptr);
+        }
     }
     else
     {
-        sendDebugMessage(F("Unknown or invalid Sensor command"), F("SensorCommandHandler"));
-        return false;
+        String val = params[0].value;
+        val.trim();
+
+        float value = NAN;
+
+        if (descriptor.format.type == SensorValueType::Flag)
+            value = val.toInt() > 0 ? 1 : 0;
+        else if (descriptor.format.type == SensorValueType::Number)
+            value = val.toFloat() * descriptor.format.scale;
+
+        SensorRegistry::publish(descriptor, 0, value, val.c_str());
     }
 
     sendAckOk(sender, cmd);
@@ -87,9 +62,6 @@ bool SensorCommandHandler::handleCommand(SerialCommandManager* sender, const Str
 
 const String* SensorCommandHandler::supportedCommands(size_t& count) const
 {
-    static const String cmds[] = { SensorTemperature, SensorHumidity, SensorBearing,
-        SensorDirection, SensorSpeed, SensorCompassTemp, SensorWaterLevel,
-        SensorWaterPumpActive, SensorHornActive };
-    count = sizeof(cmds) / sizeof(cmds[0]);
-    return cmds;
-}
\ No newline at end of file
+    count = SensorCount;
+    return SensorRegistry::commandNames();
+}
@@ -8,8 +8,8 @@
 class SensorCommandHandler : public BaseBoatCommandHandler
 {
 public:
-    // Constructor: pass the NextionControl pointer so we can notify the current page
-    explicit SensorCommandHandler(SerialCommandManager* computerCommandManager, NextionControl* nextionControl, WarningManager* warningManager);
+    // Constructor: updates are published on the EventBus for any interested subscriber
+    explicit SensorCommandHandler(SerialCommandManager* computerCommandManager, WarningManager* warningManager);
 
     bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
     const String* supportedCommands(size_t& count) const override;
@@ -0,0 +1,288 @@
+#include "SensorHistory.h"
+
+#include <math.h>
+
+struct HistorySensor {
+    uint8_t sensorId;
+    uint8_t offsetShift;
+};
+
+// Tracked sensors, in series order, with the step of the stored min/max
+// distance: 0.1 C and 0.01 V cover 25.5 C and 2.55 V, the bilge probe's
+// 10 bit reading is held in steps of 4 so a pump cycle fits
+const HistorySensor HistorySensors[HistorySeriesCount] PROGMEM = {
+    { static_cast<uint8_t>(SensorId::Temperature), 0 },
+    { static_cast<uint8_t>(SensorId::WaterLevel), 2 },
+    { static_cast<uint8_t>(SensorId::BatteryVoltage), 0 }
+};
+
+constexpr uint8_t HistoryMaxDistance = 255;
+
+// Stored values are limited to keep clear of HistoryNoValue
+constexpr int16_t HistoryValueMax = 32767;
+constexpr int16_t HistoryValueMin = -32767;
+
+SensorHistory::SensorHistory()
+    : _minuteStart(0), _minutesInQuarter(0), _closedMinutes(0)
+{
+    memset(_seriesIndex, -1, sizeof(_seriesIndex));
+
+    for (uint8_t i = 0; i < HistorySeriesCount; i++)
+    {
+        Series& series = _series[i];
+        SensorDescriptor descriptor;
+
+        series.sensorId = pgm_read_byte(&HistorySensors[i].sensorId);
+        series.offsetShift = pgm_read_byte(&HistorySensors[i].offsetShift);
+        series.decimals = SensorRegistry::getDescriptor(series.sensorId, descriptor) ? descriptor.format.decimals : 0;
+        series.lastValue = HistoryNoValue;
+        series.minuteHead = 0;
+        series.minuteCount = 0;
+        series.quarterHead = 0;
+        series.quarterCount = 0;
+        clear(series.minute);
+        clear(series.quarter);
+
+        if (series.sensorId < SensorCount)
+            _seriesIndex[series.sensorId] = i;
+    }
+
+    EventBus<SensorReadingEvent>::subscribe<SensorHistory, &SensorHistory::onSensorReading>(this);
+}
+
+void SensorHistory::begin(unsigned long now)
+{
+    _minuteStart = now;
+    _minutesInQuarter = 0;
+}
+
+void SensorHistory::update(unsigned long now)
+{
+    // catches up one bucket at a time if the loop was held up
+    while (now - _minuteStart >= HistoryMinuteMs)
+    {
+        _minuteStart += HistoryMinuteMs;
+        closeMinute();
+    }
+}
+
+void SensorHistory::onSensorReading(const SensorReadingEvent& event)
+{
+    if (event.sensorId >= SensorCount || event.channel != 0 || isnan(event.value))
+        return;
+
+    int8_t index = _seriesIndex[event.sensorId];
+
+    if (index < 0)
+        return;
+
+    Series& series = _series[index];
+    int16_t value = scale(event.value, series.decimals);
+
+    add(series.minute, value, value, value);
+    series.lastValue = value;
+}
+
+void SensorHistory::closeMinute()
+{
+    bool quarterDue = ++_minutesInQuarter >= HistoryMinutesPerQuarter;
+
+    if (quarterDue)
+        _minutesInQuarter = 0;
+
+    for (uint8_t i = 0; i < HistorySeriesCount; i++)
+    {
+        Series& series = _series[i];
+        HistoryBucket bucket = close(series.minute, series.lastValue);
+
+        series.minutes[series.minuteHead] = pack(bucket, series.offsetShift);
+        series.minuteHead = (series.minuteHead + 1) % HistoryMinuteBuckets;
+
+        if (series.minuteCount < HistoryMinuteBuckets)
+            series.minuteCount++;
+
+        // equal length minutes, so the mean of minute averages is time weighted
+        if (bucket.average != HistoryNoValue)
+            add(series.quarter, bucket.average, bucket.minimum, bucket.maximum);
+
+        if (!quarterDue)
+            continue;
+
+        series.quarters[series.quarterHead] = pack(close(series.quarter, HistoryNoValue), series.offsetShift);
+        series.quarterHead = (series.quarterHead + 1) % HistoryQuarterBuckets;
+
+        if (series.quarterCount < HistoryQuarterBuckets)
+            series.quarterCount++;
+    }
+
+    _closedMinutes++;
+}
+
+const SensorHistory::Series* SensorHistory::findSeries(uint8_t sensorId) const
+{
+    if (sensorId >= SensorCount || _seriesIndex[sensorId] < 0)
+        return nullptr;
+
+    return &_series[_seriesIndex[sensorId]];
+}
+
+bool SensorHistory::hasSeries(uint8_t sensorId) const
+{
+    return findSeries(sensorId) != nullptr;
+}
+
+uint8_t SensorHistory::getSeriesSensorId(uint8_t series) const
+{
+    return series < HistorySeriesCount ? _series[series].sensorId : 0xFF;
+}
+
+uint8_t SensorHistory::getBucketCount(uint8_t sensorId, HistoryResolution resolution) const
+{
+    const Series* series = findSeries(sensorId);
+
+    if (!series)
+        return 0;
+
+    return resolution == HistoryResolution::Minute ? series->minuteCount : series->quarterCount;
+}
+
+bool SensorHistory::getBucket(uint8_t sensorId, HistoryResolution resolution, uint8_t index, HistoryBucket& bucket) const
+{
+    const Series* series = findSeries(sensorId);
+
+    if (!series)
+        return false;
+
+    // oldest held bucket is count slots behind the next write
+    if (resolution == HistoryResolution::Minute)
+    {
+        if (index >= series->minuteCount)
+            return false;
+
+        uint8_t slot = (series->minuteHead + HistoryMinuteBuckets - series->minuteCount + index) % HistoryMinuteBuckets;
+        bucket = unpack(series->minutes[slot], series->offsetShift);
+    }
+    else
+    {
+        if (index >= series->quarterCount)
+            return false;
+
+        uint8_t slot = (series->quarterHead + HistoryQuarterBuckets - series->quarterCount + index) % HistoryQuarterBuckets;
+        bucket = unpack(series->quarters[slot], series->offsetShift);
+    }
+
+    return true;
+}
+
+uint8_t SensorHistory::getDecimals(uint8_t sensorId) const
+{
+    const Series* series = findSeries(sensorId);
+    return series ? series->decimals : 0;
+}
+
+void SensorHistory::clear(Accumulator& accumulator)
+{
+    accumulator.sum = 0;
+    accumulator.count = 0;
+    accumulator.minimum = HistoryValueMax;
+    accumulator.maximum = HistoryValueMin;
+}
+
+void SensorHistory::add(Accumulator& accumulator, int16_t average, int16_t minimum, int16_t maximum)
+{
+    accumulator.sum += average;
+    accumulator.count++;
+
+    if (minimum < accumulator.minimum)
+        accumulator.minimum = minimum;
+
+    if (maximum > accumulator.maximum)
+        accumulator.maximum = maximum;
+}
+
+HistoryBucket SensorHistory::close(Accumulator& accumulator, int16_t carry)
+{
+    HistoryBucket bucket;
+
+    if (accumulator.count == 0)
+    {
+        // no samples, the value has not moved past the sender's deadband
+        bucket.average = carry;
+        bucket.minimum = carry;
+        bucket.maximum = carry;
+    }
+    else
+    {
+        int32_t half = accumulator.count / 2;
+        int32_t sum = accumulator.sum;
+
+        bucket.average = static_cast<int16_t>((sum >= 0 ? sum + half : sum - half) / accumulator.count);
+        bucket.minimum = accumulator.minimum;
+        bucket.maximum = accumulator.maximum;
+    }
+
+    clear(accumulator);
+    return bucket;
+}
+
+int16_t SensorHistory::scale(float value, uint8_t decimals)
+{
+    for (uint8_t i = 0; i < decimals; i++)
+        value *= 10;
+
+    if (value >= HistoryValueMax)
+        return HistoryValueMax;
+
+    if (value <= HistoryValueMin)
+        return HistoryValueMin;
+
+    return static_cast<int16_t>(lroundf(value));
+}
+
+SensorHistory::PackedBucket SensorHistory::pack(const HistoryBucket& bucket, uint8_t offsetShift)
+{
+    PackedBucket packed;
+    packed.average = bucket.average;
+
+    // an empty bucket has no range, all three values are HistoryNoValue
+    if (bucket.average == HistoryNoValue)
+    {
+        packed.belowAverage = 0;
+        packed.aboveAverage = 0;
+        return packed;
+    }
+
+    packed.belowAverage = packDistance(static_cast<int32_t>(bucket.average) - bucket.minimum, offsetShift);
+    packed.aboveAverage = packDistance(static_cast<int32_t>(bucket.maximum) - bucket.average, offsetShift);
+    return packed;
+}
+
+HistoryBucket SensorHistory::unpack(const PackedBucket& packed, uint8_t offsetShift)
+{
+    HistoryBucket bucket;
+    bucket.average = packed.average;
+
+    if (packed.average == HistoryNoValue)
+    {
+        bucket.minimum = HistoryNoValue;
+        bucket.maximum = HistoryNoValue;
+        return bucket;
+    }
+
+    int32_t minimum = static_cast<int32_t>(packed.average) - (static_cast<int32_t>(packed.belowAverage) << offsetShift);
+    int32_t maximum = static_cast<int32_t>(packed.average) + (static_cast<int32_t>(packed.aboveAverage) << offsetShift);
+
+    // rounding up may step past the stored value limits
+    bucket.minimum = static_cast<int16_t>(minimum < HistoryValueMin ? HistoryValueMin : minimum);
+    bucket.maximum = static_cast<int16_t>(maximum > HistoryValueMax ? HistoryValueMax : maximum);
+    return bucket;
+}
+
+uint8_t SensorHistory::packDistance(int32_t distance, uint8_t offsetShift)
+{
+    if (distance <= 0)
+        return 0;
+
+    int32_t steps = (distance + (1L << offsetShift) - 1) >> offsetShift;
+    return steps > HistoryMaxDistance ? HistoryMaxDistance : static_cast<uint8_t>(steps);
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "SensorRegistry.h"
+#include "EventBus.h"
+#include "BoatEvents.h"
+
+constexpr uint8_t HistoryMinuteBuckets = 60;        // last hour
+constexpr uint8_t HistoryQuarterBuckets = 96;       // last 24 hours
+constexpr uint8_t HistoryMinutesPerQuarter = 15;
+constexpr unsigned long HistoryMinuteMs = 60000;
+
+// Stored in place of a value before the sensor has reported anything
+constexpr int16_t HistoryNoValue = -32768;
+
+// Sensors with a history, each one costs (60 + 96) * 4 = 624 bytes of RAM
+constexpr uint8_t HistorySeriesCount = 3;
+
+enum class HistoryResolution : uint8_t {
+    Minute = 0,     // 1 minute buckets, last hour
+    Quarter = 1     // 15 minute buckets, last 24 hours
+};
+
+/**
+ * @struct HistoryBucket
+ * @brief Summary of one time bucket, values scaled by 10^decimals of the sensor.
+ */
+struct HistoryBucket {
+    int16_t average;
+    int16_t minimum;
+    int16_t maximum;
+};
+
+/**
+ * @class SensorHistory
+ * @brief Fixed memory, two resolution trend store for a few sensors.
+ *
+ * Subscribes to SensorReadingEvent. Each sample of a tracked sensor is
+ * scaled to an int16 with the decimals from the sensor table and added to
+ * the open minute bucket, O(1) with a table lookup from sensor id to
+ * series. update() closes the minute bucket once a minute into a 60 slot
+ * ring, and every 15 closed minutes are folded into one bucket of a 96 slot
+ * ring, so nothing is ever re-scanned and memory does not grow.
+ *
+ * Sensors on the link are sent on change (a deadband and heartbeat on the
+ * fuse box), so a minute without samples carries the last value forward
+ * rather than leaving a gap.
+ *
+ * Closed buckets are stored in 4 bytes rather than 6, the minimum and
+ * maximum as 8 bit distances below and above the average in steps of
+ * 2^offsetShift of the series. Distances are rounded up, so a bucket read
+ * back never shows a narrower range than the samples had, and one wider
+ * than 255 steps is cut to 255 steps.
+ */
+class SensorHistory
+{
+public:
+    SensorHistory();
+
+    /**
+     * @brief Start the first bucket.
+     */
+    void begin(unsigned long now);
+
+    /**
+     * @brief Close buckets that are due, call at least every few seconds.
+     */
+    void update(unsigned long now);
+
+    /**
+     * @brief true if the sensor is one of the tracked series.
+     */
+    bool hasSeries(uint8_t sensorId) const;
+
+    /**
+     * @brief Sensor id of a tracked series, 0..HistorySeriesCount - 1.
+     */
+    uint8_t getSeriesSensorId(uint8_t series) const;
+
+    /**
+     * @brief Number of closed buckets held, oldest first.
+     */
+    uint8_t getBucketCount(uint8_t sensorId, HistoryResolution resolution) const;
+
+    /**
+     * @brief Read a closed bucket.
+     * @param index 0 is the oldest bucket held
+     * @return false if the sensor has no history or the index is out of range
+     */
+    bool getBucket(uint8_t sensorId, HistoryResolution resolution, uint8_t index, HistoryBucket& bucket) const;
+
+    /**
+     * @brief Decimals the stored values are scaled by.
+     */
+    uint8_t getDecimals(uint8_t sensorId) const;
+
+    /**
+     * @brief Minutes closed since begin(), changes whenever new buckets are available.
+     */
+    uint32_t getClosedMinutes() const { return _closedMinutes; }
+
+private:
+    struct Accumulator {
+        int32_t sum;
+        uint16_t count;
+        int16_t minimum;
+        int16_t maximum;
+    };
+
+    // Closed bucket as held in RAM, see pack()
+    struct PackedBucket {
+        int16_t average;
+        uint8_t belowAverage;       // (average - minimum) >> offsetShift, rounded up
+        uint8_t aboveAverage;       // (maximum - average) >> offsetShift, rounded up
+    };
+
+    struct Series {
+        uint8_t sensorId;
+        uint8_t decimals;
+        uint8_t offsetShift;        // min/max distance step is 2^offsetShift
+        int16_t lastValue;
+
+        Accumulator minute;         // samples in the open minute
+        Accumulator quarter;        // closed minutes in the open quarter
+
+        PackedBucket minutes[HistoryMinuteBuckets];
+        uint8_t minuteHead;         // next slot written
+        uint8_t minuteCount;
+
+        PackedBucket quarters[HistoryQuarterBuckets];
+        uint8_t quarterHead;
+        uint8_t quarterCount;
+    };
+
+    void onSensorReading(const SensorReadingEvent& event);
+    void closeMinute();
+    const Series* findSeries(uint8_t sensorId) const;
+
+    static void clear(Accumulator& accumulator);
+    static void add(Accumulator& accumulator, int16_t average, int16_t minimum, int16_t maximum);
+    static HistoryBucket close(Accumulator& accumulator, int16_t carry);
+    static int16_t scale(float value, uint8_t decimals);
+    static PackedBucket pack(const HistoryBucket& bucket, uint8_t offsetShift);
+    static HistoryBucket unpack(const PackedBucket& packed, uint8_t offsetShift);
+    static uint8_t packDistance(int32_t distance, uint8_t offsetShift);
+
+    Series _series[HistorySeriesCount];
+    int8_t _seriesIndex[SensorCount];   // sensor id -> series, -1 = not tracked
+
+    unsigned long _minuteStart;
+    uint8_t _minutesInQuarter;
+    uint32_t _closedMinutes;
+};
@@ -0,0 +1,166 @@
+#include "SensorRegistry.h"
+#include "EventBus.h"
+#include "BoatEvents.h"
+
+// Typed events for the existing subscribers
+
+static void publishTemperature(uint8_t, float value, const char*)
+{
+    publishEvent(TemperatureEvent{ value });
+}
+
+static void publishHumidity(uint8_t, float value, const char*)
+{
+    publishEvent(HumidityEvent{ value });
+}
+
+static void publishBearing(uint8_t, float value, const char*)
+{
+    publishEvent(BearingEvent{ value });
+}
+
+static void publishDirection(uint8_t, float, const char* text)
+{
+    publishEvent(DirectionEvent{ text });
+}
+
+static void publishSpeed(uint8_t, float value, const char*)
+{
+    publishEvent(SpeedEvent{ value });
+}
+
+static void publishCompassTemperature(uint8_t, float value, const char*)
+{
+    publishEvent(CompassTemperatureEvent{ value });
+}
+
+static void publishWaterLevel(uint8_t, float value, const char*)
+{
+    publishEvent(WaterLevelEvent{ static_cast<int16_t>(value) });
+}
+
+static void publishWaterPump(uint8_t, float value, const char*)
+{
+    publishEvent(WaterPumpEvent{ value > 0 });
+}
+
+static void publishRateOfTurn(uint8_t, float value, const char*)
+{
+    publishEvent(RateOfTurnEvent{ value });
+}
+
+static void publishBatteryVoltage(uint8_t, float value, const char*)
+{
+    publishEvent(BatteryVoltageEvent{ value });
+}
+
+static void publishRelayCurrent(uint8_t channel, float value, const char*)
+{
+    publishEvent(RelayCurrentEvent{ channel, value });
+}
+
+const char SensorNameTemperature[] PROGMEM = "Temp";
+const char SensorNameHumidity[] PROGMEM = "Humidity";
+const char SensorNameBearing[] PROGMEM = "Bearing";
+const char SensorNameDirection[] PROGMEM = "Direction";
+const char SensorNameSpeed[] PROGMEM = "Speed";
+const char SensorNameCompassTemperature[] PROGMEM = "Compass Temp";
+const char SensorNameWaterLevel[] PROGMEM = "Bilge";
+const char SensorNameWaterPump[] PROGMEM = "Bilge Pump";
+const char SensorNameHorn[] PROGMEM = "Horn";
+const char SensorNameRateOfTurn[] PROGMEM = "Rate Of Turn";
+const char SensorNameBatteryVoltage[] PROGMEM = "Battery";
+const char SensorNameRelayCurrent[] PROGMEM = "Relay Current";
+
+const char SensorUnitNone[] PROGMEM = "";
+const char SensorUnitCelsius[] PROGMEM = "C";
+const char SensorUnitPercent[] PROGMEM = "%";
+const char SensorUnitDegrees[] PROGMEM = "deg";
+const char SensorUnitKnots[] PROGMEM = "kn";
+const char SensorUnitDegreesPerMinute[] PROGMEM = "deg/min";
+const char SensorUnitVolts[] PROGMEM = "V";
+const char SensorUnitAmps[] PROGMEM = "A";
+
+// Compass die temperature that raises HighCompassTemperature
+constexpr float CompassTemperatureWarningValue = 35;
+
+const SensorDescriptor SensorTable[] PROGMEM = {
+    // id, name, unit, format, warn low, warn high, publisher
+    { 0, SensorNameTemperature, SensorUnitCelsius, SensorFormats[0], NAN, NAN, publishTemperature },
+    { 1, SensorNameHumidity, SensorUnitPercent, SensorFormats[1], NAN, NAN, publishHumidity },
+    { 2, SensorNameBearing, SensorUnitDegrees, SensorFormats[2], NAN, NAN, publishBearing },
+    { 3, SensorNameDirection, SensorUnitNone, SensorFormats[3], NAN, NAN, publishDirection },
+    { 4, SensorNameSpeed, SensorUnitKnots, SensorFormats[4], NAN, NAN, publishSpeed },
+    { 5, SensorNameCompassTemperature, SensorUnitCelsius, SensorFormats[5], NAN, CompassTemperatureWarningValue, publishCompassTemperature },
+    { 6, SensorNameWaterLevel, SensorUnitNone, SensorFormats[6], NAN, NAN, publishWaterLevel },
+    { 7, SensorNameWaterPump, SensorUnitNone, SensorFormats[7], NAN, NAN, publishWaterPump },
+    { 8, SensorNameHorn, SensorUnitNone, SensorFormats[8], NAN, NAN, nullptr },
+    { 9, SensorNameRateOfTurn, SensorUnitDegreesPerMinute, SensorFormats[9], NAN, NAN, publishRateOfTurn },
+    { 10, SensorNameBatteryVoltage, SensorUnitVolts, SensorFormats[10], NAN, NAN, publishBatteryVoltage },
+    { 11, SensorNameRelayCurrent, SensorUnitAmps, SensorFormats[11], NAN, NAN, publishRelayCurrent }
+};
+
+static_assert(sizeof(SensorTable) / sizeof(SensorTable[0]) == SensorCount,
+    "SensorTable must have a row for each SensorId");
+
+bool SensorRegistry::getDescriptor(uint8_t id, SensorDescriptor& descriptor)
+{
+    if (id >= SensorCount)
+        return false;
+
+    memcpy_P(&descriptor, &SensorTable[id], sizeof(SensorDescriptor));
+    return true;
+}
+
+int16_t SensorRegistry::parseCommand(const String& command)
+{
+    // S followed by one or two digits
+    uint8_t length = command.length();
+
+    if (length < 2 || length > 3 || command[0] != 'S')
+        return -1;
+
+    int16_t id = 0;
+
+    for (uint8_t i = 1; i < length; i++)
+    {
+        if (!isDigit(command[i]))
+            return -1;
+
+        id = id * 10 + (command[i] - '0');
+    }
+
+    return id < SensorCount ? id : -1;
+}
+
+const String* SensorRegistry::commandNames()
+{
+    static String names[SensorCount];
+
+    if (names[0].length() == 0)
+    {
+        for (uint8_t i = 0; i < SensorCount; i++)
+            names[i] = String('S') + String(i);
+    }
+
+    return names;
+}
+
+void SensorRegistry::publish(const SensorDescriptor& descriptor, uint8_t channel, float value, const char* text)
+{
+    publishEvent(SensorReadingEvent{ descriptor.id, channel, value });
+
+    if (descriptor.publish != nullptr)
+        descriptor.publish(channel, value, text);
+}
+
+bool SensorRegistry::isOutsideLimits(SensorId id, float value)
+{
+    SensorDescriptor descriptor;
+
+    if (!getDescriptor(static_cast<uint8_t>(id), descriptor))
+        return false;
+
+    // comparisons with NAN are false, so a missing threshold never trips
+    return value < descriptor.warnLow || value > descriptor.warnHigh;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <SensorProtocol.h>
+
+/**
+ * @brief Publishes the typed event existing subscribers listen for.
+ * @param channel Channel index for SensorValueType::Channels, otherwise 0
+ * @param value Scaled value, NAN for text sensors
+ * @param text Received text, only valid during the call
+ */
+typedef void (*SensorPublisher)(uint8_t channel, float value, const char* text);
+
+/**
+ * @struct SensorDescriptor
+ * @brief One row of the sensor table, stored in flash.
+ */
+struct SensorDescriptor {
+    uint8_t id;                 // SensorId, also the row index
+    PGM_P name;                 // short display name
+    PGM_P unit;                 // display unit, empty if none
+    SensorFormat format;        // type, decimals and scale, shared with the fuse box
+    float warnLow;              // warning thresholds, NAN = none
+    float warnHigh;
+    SensorPublisher publish;    // typed event, nullptr = SensorReadingEvent only
+};
+
+/**
+ * @class SensorRegistry
+ * @brief Table driven description of every S<n> sensor.
+ *
+ * The table lives in flash and is indexed by SensorId, so finding the
+ * descriptor for a received command is a parse of the number and one
+ * copy out of PROGMEM. SensorCommandHandler decodes every sensor through
+ * the same path using the row's type and scale, then calls publish() which
+ * sends a generic SensorReadingEvent and the row's typed event.
+ *
+ * SensorId and the wire format of each row come from SensorProtocol.h,
+ * shared with the fuse box. Adding a sensor is a new SensorId and format
+ * there, a table row here and, if something needs a typed event, a
+ * publisher.
+ */
+class SensorRegistry
+{
+public:
+    /**
+     * @brief Copy a row out of flash.
+     * @return false if the id is not in the table
+     */
+    static bool getDescriptor(uint8_t id, SensorDescriptor& descriptor);
+
+    /**
+     * @brief Sensor id from a command name.
+     * @return The id for "S<n>", or -1 if the command is not a known sensor
+     */
+    static int16_t parseCommand(const String& command);
+
+    /**
+     * @brief Command names for every sensor, S0 to S<SensorCount - 1>.
+     */
+    static const String* commandNames();
+
+    /**
+     * @brief Publish a decoded reading on the EventBus.
+     */
+    static void publish(const SensorDescriptor& descriptor, uint8_t channel, float value, const char* text);
+
+    /**
+     * @brief Check a value against the row's warning thresholds.
+     * @return true if the value is below warnLow or above warnHigh
+     */
+    static bool isOutsideLimits(SensorId id, float value);
+};
@@ -1,9 +1,13 @@
 
 #include "SoundEmergencyPage.h"
 
-// Nextion Names/Ids on current Page
-constexpr uint8_t BtnSoS = 2; // b3
-constexpr uint8_t BtnBack = 3; // b4
+// Component registry, indexed by Nextion component id
+const PageComponent SoundEmergencyComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                         // 0 page
+    { "", ComponentRole::None, 0, nullptr },                         // 1
+    { "b3", ComponentRole::Command, 0, SoundSignalSoS },             // 2
+    { "b4", ComponentRole::Navigate, PageSoundSignals, nullptr }     // 3 back
+};
 
 constexpr unsigned long RefreshIntervalMs = 10000;
 
@@ -29,17 +33,10 @@ void SoundEmergencyPage::refresh(unsigned long now)
 // Handle touch events for buttons
 void SoundEmergencyPage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-	(void)eventType;
+    PageComponent component;
 
-    switch (compId)
+    if (readPageComponent(SoundEmergencyComponents, compId, component))
     {
-    case BtnSoS:
-        getCommandMgrLink()->sendCommand(SoundSignalSoS, "");
-        break;
-
-    case BtnBack:
-        setPage(PageSoundSignals);
-        break;
-
+        handleComponentTouch(component, eventType);
     }
 }
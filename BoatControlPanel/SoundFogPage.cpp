@@ -1,8 +1,14 @@
 #include "SoundFogPage.h"
 
-// Nextion Names/Ids on current Page
-constexpr uint8_t BtnFogHorn = 4; // b3
-constexpr uint8_t BtnBack = 5; // b4
+// Component registry, indexed by Nextion component id
+const PageComponent SoundFogComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                         // 0 page
+    { "", ComponentRole::None, 0, nullptr },                         // 1
+    { "", ComponentRole::None, 0, nullptr },                         // 2
+    { "", ComponentRole::None, 0, nullptr },                         // 3
+    { "b3", ComponentRole::Command, 0, SoundSignalFog },             // 4
+    { "b4", ComponentRole::Navigate, PageSoundSignals, nullptr }     // 5 back
+};
 
 constexpr unsigned long RefreshIntervalMs = 10000;
 
@@ -28,17 +34,10 @@ void SoundFogPage::refresh(unsigned long now)
 // Handle touch events for buttons
 void SoundFogPage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-	(void)eventType;
+    PageComponent component;
 
-    switch (compId)
+    if (readPageComponent(SoundFogComponents, compId, component))
     {
-    case BtnFogHorn:
-        getCommandMgrLink()->sendCommand(SoundSignalFog, "");
-        break;
-
-    case BtnBack:
-        setPage(PageSoundSignals);
-        break;
-
+        handleComponentTouch(component, eventType);
     }
 }
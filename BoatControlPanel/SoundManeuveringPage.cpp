@@ -2,12 +2,16 @@
 
 
 
-// Nextion Names/Ids on current Page
-constexpr uint8_t BtnStarboard = 2; // b0
-constexpr uint8_t BtnAstern = 3; // b1
-constexpr uint8_t BtnPort = 4; // b2
-constexpr uint8_t BtnDanger = 5; // b3
-constexpr uint8_t BtnBack = 6; // b4
+// Component registry, indexed by Nextion component id
+const PageComponent SoundManeuveringComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                          // 0 page
+    { "", ComponentRole::None, 0, nullptr },                          // 1
+    { "b0", ComponentRole::Command, 0, SoundSignalMoveStarboard },    // 2
+    { "b1", ComponentRole::Command, 0, SoundSignalMoveAstern },       // 3
+    { "b2", ComponentRole::Command, 0, SoundSignalMovePort },         // 4
+    { "b3", ComponentRole::Command, 0, SoundSignalMoveDanger },       // 5
+    { "b4", ComponentRole::Navigate, PageSoundSignals, nullptr }      // 6 back
+};
 
 constexpr unsigned long RefreshIntervalMs = 10000;
 
@@ -33,29 +37,10 @@ void SoundManeuveringPage::refresh(unsigned long now)
 // Handle touch events for buttons
 void SoundManeuveringPage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-	(void)eventType;
+    PageComponent component;
 
-    switch (compId)
+    if (readPageComponent(SoundManeuveringComponents, compId, component))
     {
-        case BtnStarboard:
-            getCommandMgrLink()->sendCommand(SoundSignalMoveStarboard, "");
-            break;
-
-        case BtnAstern:
-            getCommandMgrLink()->sendCommand(SoundSignalMoveAstern, "");
-            break;
-
-        case BtnPort:
-            getCommandMgrLink()->sendCommand(SoundSignalMovePort, "");
-            break;
-
-        case BtnDanger:
-            getCommandMgrLink()->sendCommand(SoundSignalMoveDanger, "");
-            break;
-
-        case BtnBack:
-            setPage(PageSoundSignals);
-            break;
-
+        handleComponentTouch(component, eventType);
     }
 }
@@ -1,9 +1,13 @@
 
 #include "SoundOtherPage.h"
 
-// Nextion Names/Ids on current Page
-constexpr uint8_t BtnSoS = 3; // b3
-constexpr uint8_t BtnBack = 2; // b4
+// Component registry, indexed by Nextion component id
+const PageComponent SoundOtherComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                         // 0 page
+    { "", ComponentRole::None, 0, nullptr },                         // 1
+    { "b4", ComponentRole::Navigate, PageSoundSignals, nullptr },    // 2 back
+    { "b3", ComponentRole::Command, 0, SoundSignalTest }             // 3
+};
 
 constexpr unsigned long RefreshIntervalMs = 10000;
 
@@ -29,17 +33,10 @@ void SoundOtherPage::refresh(unsigned long now)
 // Handle touch events for buttons
 void SoundOtherPage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-	(void)eventType;
+    PageComponent component;
 
-    switch (compId)
+    if (readPageComponent(SoundOtherComponents, compId, component))
     {
-    case BtnSoS:
-        getCommandMgrLink()->sendCommand(SoundSignalTest, "");
-        break;
-
-    case BtnBack:
-        setPage(PageSoundSignals);
-        break;
-
+        handleComponentTouch(component, eventType);
     }
 }
@@ -7,12 +7,16 @@
 
 
 
-// Nextion Names/Ids on current Page
-constexpr uint8_t BtnStarboard = 2; // b0
-constexpr uint8_t BtnConsent = 5; // b1
-constexpr uint8_t BtnPort = 3; // b2
-constexpr uint8_t BtnDanger = 4; // b3
-constexpr uint8_t BtnBack = 6; // b4
+// Component registry, indexed by Nextion component id
+const PageComponent SoundOvertakingComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                              // 0 page
+    { "", ComponentRole::None, 0, nullptr },                              // 1
+    { "b0", ComponentRole::Command, 0, SoundSignalOvertakeStarboard },    // 2
+    { "b2", ComponentRole::Command, 0, SoundSignalOvertakePort },         // 3
+    { "b3", ComponentRole::Command, 0, SoundSignalOvertakeDanger },       // 4
+    { "b1", ComponentRole::Command, 0, SoundSignalOvertakeConsent },      // 5
+    { "b4", ComponentRole::Navigate, PageSoundSignals, nullptr }          // 6 back
+};
 
 constexpr unsigned long RefreshIntervalMs = 10000;
 
@@ -38,29 +42,10 @@ void SoundOvertakingPage::refresh(unsigned long now)
 // Handle touch events for buttons
 void SoundOvertakingPage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-	(void)eventType;
+    PageComponent component;
 
-    switch (compId)
+    if (readPageComponent(SoundOvertakingComponents, compId, component))
     {
-    case BtnStarboard:
-        getCommandMgrLink()->sendCommand(SoundSignalOvertakeStarboard, "");
-        break;
-
-    case BtnConsent:
-        getCommandMgrLink()->sendCommand(SoundSignalOvertakeConsent, "");
-        break;
-
-    case BtnPort:
-        getCommandMgrLink()->sendCommand(SoundSignalOvertakePort, "");
-        break;
-
-    case BtnDanger:
-        getCommandMgrLink()->sendCommand(SoundSignalOvertakeDanger, "");
-        break;
-
-    case BtnBack:
-        setPage(PageSoundSignals);
-        break;
-
+        handleComponentTouch(component, eventType);
     }
 }
@@ -1,18 +1,21 @@
 #include "SoundSignalsPage.h"
 
 
-// Nextion Names/Ids on current Page
-constexpr uint8_t BtnManeuvering = 4; // b0
-constexpr uint8_t BtnFog = 6; // b2
-constexpr uint8_t BtnNarrowChannel = 5; // b1
-constexpr uint8_t BtnEmergency = 7; // b3
-constexpr uint8_t BtnOther = 8; // b4
-constexpr uint8_t BtnCancelAll = 9; // b5
-constexpr uint8_t ButtonNext = 3;
-constexpr uint8_t ButtonPrevious = 2;
-constexpr char CancelButton[] = "b5";
+// Component registry, indexed by Nextion component id
+const PageComponent SoundSignalsComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                                    // 0 page
+    { "", ComponentRole::None, 0, nullptr },                                    // 1
+    { "", ComponentRole::Navigate, PageRelay, nullptr },                        // 2 previous
+    { "", ComponentRole::Navigate, PageHome, nullptr },                         // 3 next
+    { "b0", ComponentRole::Navigate, PageSoundManeuveringSignals, nullptr },    // 4
+    { "b1", ComponentRole::Navigate, PageSoundOvertaking, nullptr },            // 5
+    { "b2", ComponentRole::Navigate, PageSoundFogSignals, nullptr },            // 6
+    { "b3", ComponentRole::Navigate, PageSoundEmergency, nullptr },             // 7
+    { "b4", ComponentRole::Navigate, PageSoundOther, nullptr },                 // 8
+    { "b5", ComponentRole::Command, 0, SoundSignalCancel }                      // 9 cancel all
+};
 
-constexpr unsigned long RefreshIntervalMs = 10000;
+constexpr char CancelButton[] = "b5";
 
 
 SoundSignalsPage::SoundSignalsPage(Stream* serialPort,
@@ -21,91 +24,72 @@ SoundSignalsPage::SoundSignalsPage(Stream* serialPort,
     SerialCommandManager* commandMgrComputer)
     : BaseBoatPage(serialPort, warningMgr, commandMgrLink, commandMgrComputer)
 {
+    EventBus<SoundSignalEvent>::subscribe<SoundSignalsPage, &SoundSignalsPage::onSoundSignal>(this);
 }
 
 void SoundSignalsPage::begin()
 {
-    setPicture(CancelButton, ImageButtonColorGrey + ImageButtonColorOffset);
-    setPicture2(CancelButton, ImageButtonColorGrey + ImageButtonColorOffset);
+    writePicture(CancelButton, ImageButtonColorGrey + ImageButtonColorOffset);
+    writePicture2(CancelButton, ImageButtonColorGrey + ImageButtonColorOffset);
 }
 
 void SoundSignalsPage::onEnterPage()
 {
+    // The fuse box pushes H1 whenever the signal starts or stops, only
+    // request the current state once when the page is shown
     getCommandMgrLink()->sendCommand(SoundSignalActive, "");
-    _lastRefreshTime = millis();
+    updateCancelButton();
 }
 
 void SoundSignalsPage::refresh(unsigned long now)
 {
-    if (now - _lastRefreshTime >= RefreshIntervalMs)
-    {
-        _lastRefreshTime = now;
-        getCommandMgrLink()->sendCommand(SoundSignalActive, "");
-    }
+    (void)now;
 }
 
 // Handle touch events for buttons
 void SoundSignalsPage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-	(void)eventType;
+    PageComponent component;
 
-    switch (compId)
+    if (readPageComponent(SoundSignalsComponents, compId, component))
     {
-    case BtnManeuvering:
-        setPage(PageSoundManeuveringSignals);
-        break;
-
-    case BtnFog:
-        setPage(PageSoundFogSignals);
-        break;
-
-    case BtnNarrowChannel:
-        setPage(PageSoundOvertaking);
-        break;
-
-    case BtnEmergency:
-        setPage(PageSoundEmergency);
-        break;
-
-    case BtnOther:
-        setPage(PageSoundOther);
-        break;
+        handleComponentTouch(component, eventType);
+    }
+}
 
-    case BtnCancelAll:
-		getCommandMgrLink()->sendCommand(SoundSignalCancel, "");
-        break;
+void SoundSignalsPage::onSoundSignal(const SoundSignalEvent& event)
+{
+    // Globals are written regardless of the visible page, the blast progress
+    // and blinking animations run in timer events on the display
+    if (event.soundType != _soundType)
+    {
+        _soundType = event.soundType;
+        setGlobalValue(GlobalSoundType, _soundType);
 
-    case ButtonNext:
-        setPage(PageHome);
-        return;
+        if (isCurrentPage())
+            updateCancelButton();
+    }
 
-    case ButtonPrevious:
-        setPage(PageRelay);
-        return;
+    if (event.soundState != _soundState)
+    {
+        _soundState = event.soundState;
+        setGlobalValue(GlobalSoundState, _soundState);
 
-    default:
-        return;
+        if (isCurrentPage())
+            updateCancelButton();
     }
 }
 
-void SoundSignalsPage::handleExternalUpdate(uint8_t updateType, const void* data)
+void SoundSignalsPage::updateCancelButton()
 {
-    // Call base class first to handle heartbeat ACKs
-    BaseBoatPage::handleExternalUpdate(updateType, data);
+    // red while the horn is sounding, blue during gaps and repeats
+    uint8_t color = ImageButtonColorGrey;
 
-    if (updateType == static_cast<uint8_t>(PageUpdateType::SoundSignal) && data != nullptr)
-    {
-        const BoolStateUpdate* update = static_cast<const BoolStateUpdate*>(data);
-
-        if (update->value)
-        {
-            setPicture(CancelButton, ImageButtonColorBlue + ImageButtonColorOffset);
-			setPicture2(CancelButton, ImageButtonColorBlue + ImageButtonColorOffset);
-        }
-        else
-        {
-            setPicture(CancelButton, ImageButtonColorGrey + ImageButtonColorOffset);
-            setPicture2(CancelButton, ImageButtonColorGrey + ImageButtonColorOffset);
-        }
-    }
+    if (_soundState == SoundStateBlastOn)
+        color = ImageButtonColorRed;
+    else if (_soundType != 0)
+        color = ImageButtonColorBlue;
+
+    writePicture(CancelButton, color + ImageButtonColorOffset);
+    writePicture2(CancelButton, color + ImageButtonColorOffset);
 }
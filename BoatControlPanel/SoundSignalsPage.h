@@ -12,7 +12,13 @@
 
 class SoundSignalsPage : public BaseBoatPage {
 private:
-    unsigned long _lastRefreshTime = 0;
+    uint8_t _soundType = 0;
+    uint8_t _soundState = 0;
+
+    void updateCancelButton();
+
+    // EventBus handlers
+    void onSoundSignal(const SoundSignalEvent& event);
 
 protected:
     // Required overrides
@@ -23,7 +29,6 @@ protected:
     //optional overrides
     void onEnterPage() override;
     void handleTouch(uint8_t compId, uint8_t eventType) override;
-    void handleExternalUpdate(uint8_t updateType, const void* data) override;
 
 public:
     explicit SoundSignalsPage(Stream* serialPort,
@@ -1,8 +1,13 @@
 
 #include "SystemCommandHandler.h"
 
-SystemCommandHandler::SystemCommandHandler(SerialCommandManager* commandMgrComputer, SerialCommandManager* commandMgrLink)
-    : _commandMgrComputer(commandMgrComputer), _commandMgrLink(commandMgrLink)
+// Buckets per F8 data line, keeps each line well inside the receive buffer of the other end
+constexpr uint8_t HistoryBucketsPerLine = 8;
+
+SystemCommandHandler::SystemCommandHandler(SerialCommandManager* commandMgrComputer, SerialCommandManager* commandMgrLink,
+    FixedRateSampler* compassSampler, TaskScheduler* scheduler, NmeaParser* gps, SensorHistory* history)
+    : _commandMgrComputer(commandMgrComputer), _commandMgrLink(commandMgrLink), _compassSampler(compassSampler),
+      _scheduler(scheduler), _gps(gps), _history(history)
 {
 
 }
@@ -14,16 +19,14 @@ SystemCommandHandler::~SystemCommandHandler()
 
 const String* SystemCommandHandler::supportedCommands(size_t& count) const
 {
-    static const String cmds[] = { SystemHeartbeatCommand, SystemInitialized, SystemFreeMemory };
+    static const String cmds[] = { SystemHeartbeatCommand, SystemInitialized, SystemFreeMemory, SystemSensorTiming, SystemTaskStats, SystemGpsStatus,
+        SystemSensorHistory };
     count = sizeof(cmds) / sizeof(cmds[0]);
     return cmds;
 }
 
 bool SystemCommandHandler::handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount)
 {
-    (void)params;
-    (void)paramCount;
-
     String cmd = command;
     cmd.trim();
 
@@ -41,6 +44,66 @@ bool SystemCommandHandler::handleCommand(SerialCommandManager* sender, const Str
         StringKeyValue param = { ValueParamName, String(freeRam()) };
         sendAckOk(sender, cmd, &param);
     }
+    else if (cmd == SystemSensorTiming)
+    {
+        if (!_compassSampler)
+        {
+            sendAckErr(sender, cmd, F("Sampler not configured"));
+            return true;
+        }
+
+        sendSamplerTiming(sender, cmd, _compassSampler);
+
+        // optional v=1 clears the statistics after reporting
+        if (paramCount > 0 && params[0].value == "1")
+        {
+            _compassSampler->resetStats();
+        }
+
+        sendAckOk(sender, cmd);
+    }
+    else if (cmd == SystemTaskStats)
+    {
+        if (!_scheduler)
+        {
+            sendAckErr(sender, cmd, F("Scheduler not configured"));
+            return true;
+        }
+
+        sendTaskStats(sender, cmd, _scheduler);
+
+        // optional v=1 clears the statistics after reporting
+        if (paramCount > 0 && params[0].value == "1")
+        {
+            _scheduler->resetStats();
+        }
+
+        sendAckOk(sender, cmd);
+    }
+    else if (cmd == SystemGpsStatus)
+    {
+        if (!_gps)
+        {
+            sendAckErr(sender, cmd, F("GPS not configured"));
+            return true;
+        }
+
+        sendGpsStatus(sender, cmd, _gps);
+        sendAckOk(sender, cmd);
+    }
+    else if (cmd == SystemSensorHistory)
+    {
+        if (!_history)
+        {
+            sendAckErr(sender, cmd, F("History not configured"));
+            return true;
+        }
+
+        if (sendSensorHistory(sender, cmd, params, paramCount))
+        {
+            sendAckOk(sender, cmd);
+        }
+    }
     else
     {
         sendAckErr(sender, cmd, F("Unknown system command"));
@@ -55,6 +118,141 @@ uint16_t SystemCommandHandler::freeRam() {
     return (int)&v - (__brkval == 0 ? (int)&__heap_start : (int)__brkval);
 }
 
+void SystemCommandHandler::sendSamplerTiming(SerialCommandManager* sender, const String& cmd, FixedRateSampler* sampler)
+{
+    StringKeyValue params[] = {
+        { F("p"), String(sampler->getPeriod()) },
+        { F("n"), String(sampler->getSampleCount()) },
+        { F("m"), String(sampler->getMissedCount()) },
+        { F("jmin"), String(sampler->getJitterMin()) },
+        { F("jmax"), String(sampler->getJitterMax()) },
+        { F("javg"), String(sampler->getJitterMean()) }
+    };
+
+    sender->sendCommand(cmd, "", "", params, sizeof(params) / sizeof(params[0]));
+}
+
+void SystemCommandHandler::sendTaskStats(SerialCommandManager* sender, const String& cmd, TaskScheduler* scheduler)
+{
+    // one line per task
+    for (uint8_t i = 0; i < scheduler->getTaskCount(); i++)
+    {
+        const ScheduledTask* task = scheduler->getTask(i);
+        uint32_t meanMicros = task->runCount ? task->totalMicros / task->runCount : 0;
+
+        StringKeyValue params[] = {
+            { F("t"), String(task->name) },
+            { F("n"), String(task->runCount) },
+            { F("us"), String(meanMicros) },
+            { F("usmax"), String(task->maxMicros) },
+            { F("late"), String(task->maxLateMs) },
+            { F("o"), String(task->overrunCount) }
+        };
+
+        sender->sendCommand(cmd, "", "", params, sizeof(params) / sizeof(params[0]));
+    }
+}
+
+void SystemCommandHandler::sendGpsStatus(SerialCommandManager* sender, const String& cmd, NmeaParser* gps)
+{
+    const NmeaFix& fix = gps->getFix();
+
+    StringKeyValue params[] = {
+        { F("fix"), String(fix.valid ? 1 : 0) },
+        { F("q"), String(fix.quality) },
+        { F("sat"), String(fix.satellites) },
+        { F("lat"), String(fix.latitudeE7) },
+        { F("lon"), String(fix.longitudeE7) },
+        { F("n"), String(gps->getSentenceCount()) },
+        { F("e"), String(gps->getChecksumErrorCount()) },
+        { F("i"), String(gps->getIgnoredCount()) }
+    };
+
+    sender->sendCommand(cmd, "", "", params, sizeof(params) / sizeof(params[0]));
+}
+
+bool SystemCommandHandler::sendSensorHistory(SerialCommandManager* sender, const String& cmd, const StringKeyValue params[], int paramCount)
+{
+    int sensorId = -1;
+    int resolution = static_cast<int>(HistoryResolution::Minute);
+
+    for (int i = 0; i < paramCount; i++)
+    {
+        if (params[i].key == "s")
+            sensorId = params[i].value.toInt();
+        else if (params[i].key == "r")
+            resolution = params[i].value.toInt();
+    }
+
+    if (sensorId < 0)
+    {
+        sendAckErr(sender, cmd, F("Missing param"));
+        return false;
+    }
+
+    if (resolution != static_cast<int>(HistoryResolution::Minute) && resolution != static_cast<int>(HistoryResolution::Quarter))
+    {
+        sendAckErr(sender, cmd, F("Invalid value"));
+        return false;
+    }
+
+    if (sensorId >= SensorCount || !_history->hasSeries(static_cast<uint8_t>(sensorId)))
+    {
+        sendAckErr(sender, cmd, F("Sensor has no history"));
+        return false;
+    }
+
+    uint8_t id = static_cast<uint8_t>(sensorId);
+    HistoryResolution res = static_cast<HistoryResolution>(resolution);
+    uint8_t count = _history->getBucketCount(id, res);
+
+    StringKeyValue header[] = {
+        { F("s"), String(id) },
+        { F("r"), String(resolution) },
+        { F("n"), String(count) },
+        { F("d"), String(_history->getDecimals(id)) },
+        { F("p"), String(res == HistoryResolution::Minute ? 1 : HistoryMinutesPerQuarter) }
+    };
+
+    sender->sendCommand(cmd, "", "", header, sizeof(header) / sizeof(header[0]));
+
+    // oldest first, several buckets per line as average_minimum_maximum
+    for (uint8_t offset = 0; offset < count; offset += HistoryBucketsPerLine)
+    {
+        String values;
+        values.reserve(HistoryBucketsPerLine * 18);
+
+        for (uint8_t i = offset; i < count && i < offset + HistoryBucketsPerLine; i++)
+        {
+            HistoryBucket bucket;
+
+            if (i > offset)
+                values += ',';
+
+            if (!_history->getBucket(id, res, i, bucket) || bucket.average == HistoryNoValue)
+            {
+                values += '-';
+                continue;
+            }
+
+            values += bucket.average;
+            values += '_';
+            values += bucket.minimum;
+            values += '_';
+            values += bucket.maximum;
+        }
+
+        StringKeyValue line[] = {
+            { F("o"), String(offset) },
+            { F("v"), values }
+        };
+
+        sender->sendCommand(cmd, "", "", line, sizeof(line) / sizeof(line[0]));
+    }
+
+    return true;
+}
+
 void SystemCommandHandler::broadcast(const String& cmd, const StringKeyValue* param)
 {
     if (_commandMgrLink != nullptr)
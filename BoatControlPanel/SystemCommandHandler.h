@@ -1,6 +1,10 @@
 #pragma once
+#include <TaskScheduler.h>
 #include "BaseCommandHandler.h"
 #include "BoatControlPanelConstants.h"
+#include "FixedRateSampler.h"
+#include "NmeaParser.h"
+#include "SensorHistory.h"
 
 // internal message handlers
 class SystemCommandHandler : public BaseCommandHandler
@@ -8,8 +12,14 @@ class SystemCommandHandler : public BaseCommandHandler
 private:
     SerialCommandManager* _commandMgrComputer;
     SerialCommandManager* _commandMgrLink;
+    FixedRateSampler* _compassSampler;
+    TaskScheduler* _scheduler;
+    NmeaParser* _gps;
+    SensorHistory* _history;
 public:
-    SystemCommandHandler(SerialCommandManager* commandMgrComputer, SerialCommandManager* commandMgrLink);
+    SystemCommandHandler(SerialCommandManager* commandMgrComputer, SerialCommandManager* commandMgrLink,
+        FixedRateSampler* compassSampler = nullptr, TaskScheduler* scheduler = nullptr, NmeaParser* gps = nullptr,
+        SensorHistory* history = nullptr);
     ~SystemCommandHandler();
     bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
 
@@ -17,4 +27,8 @@ public:
 private:
     void broadcast(const String& cmd, const StringKeyValue* param = nullptr);
     uint16_t freeRam();
+    void sendSamplerTiming(SerialCommandManager* sender, const String& cmd, FixedRateSampler* sampler);
+    void sendTaskStats(SerialCommandManager* sender, const String& cmd, TaskScheduler* scheduler);
+    void sendGpsStatus(SerialCommandManager* sender, const String& cmd, NmeaParser* gps);
+    bool sendSensorHistory(SerialCommandManager* sender, const String& cmd, const StringKeyValue params[], int paramCount);
 };
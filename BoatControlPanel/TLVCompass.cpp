@@ -1,31 +1,45 @@
 #include "TLVCompass.h"
 #include <Arduino.h>
 
+constexpr CompassReal Gravity = 9.81;
+
+// TLV493D-A1B6 conversion, 12 bit two's complement field and temperature
+constexpr double MilliTeslaPerLsb = 0.098;
+constexpr int16_t TemperatureOffsetLsb = 340;
+constexpr double DegreesPerLsb = 1.1;
+constexpr double TemperatureAt25 = 25.0;
+
+constexpr uint32_t I2CStandardClock = 100000;
+constexpr uint32_t I2CFastClock = 400000;
+
 // Directions array
 const char* TLVCompass::directions[16] = {
     "N", "NNE", "NE", "ENE", "E", "ESE", "SE", "SSE",
     "S", "SSW", "SW", "WSW", "W", "WNW", "NW", "NNW"
 };
 
-TLVCompass::TLVCompass(int filterSize)
+TLVCompass::TLVCompass(int filterSize, unsigned long headingTimeConstantMs)
 : sensor(Wire, TLx493D_IIC_ADDR_A0_e),
+  lastFrame(0xFF),
+  replaying(false),
   filterSize(filterSize > 32 ? 32 : filterSize),
   filterIndex(0), bxSum(0), bySum(0),
   bxFiltered(0), byFiltered(0),
-  heading(0), headingSum(0), headingIndex(0),
+  headingFilter(headingTimeConstantMs),
   pitch(0), roll(0),
   temp(0), bx(0), by(0), bz(0),
   ax(0), ay(0), az(0),
+  calibrating(false), calibrated(false),
   bxMin(0), bxMax(0), byMin(0), byMax(0), bzMin(0), bzMax(0),
   firstUpdate(true)
 {
-    for (int i = 0; i < 32; i++) headingBuffer[i] = 0;
+    clearCalibration();
 }
 
-bool TLVCompass::begin()
+bool TLVCompass::begin(bool fastMode)
 {
     Wire.begin();
-    Wire.setClock(100000);
+    Wire.setClock(fastMode ? I2CFastClock : I2CStandardClock);
     delay(500);
 
     // Magnetometer
@@ -52,48 +66,119 @@ bool TLVCompass::begin()
     return true;
 }
 
-bool TLVCompass::update(unsigned long now)
+bool TLVCompass::requestSample()
 {
-    double dt = (now - lastUpdate) / 1000.0;
-    lastUpdate = now;
+    return bus.startRead(TLV493DAddress, sampleBuffer, TLV493DSampleBytes);
+}
 
-    // Magnetometer
-    if (!sensor.getTemperature(&temp) || !sensor.getMagneticField(&bx, &by, &bz))
+bool TLVCompass::poll(unsigned long now)
+{
+    if (bus.poll() != AsyncI2CState::Complete || !decodeSample())
     {
         return false;
     }
 
-    if (firstUpdate)
+    processSample(now);
+    return true;
+}
+
+bool TLVCompass::decodeSample()
+{
+    const uint8_t* data = sampleBuffer;
+
+    // Channel bits non zero while a conversion is in progress
+    if (data[3] & 0x03)
     {
-        bxMin = bxMax = bx;
-        byMin = byMax = by;
-        bzMin = bzMax = bz;
-        firstUpdate = false;
+        return false;
     }
-    else
+
+    // Frame counter unchanged means the sensor has not converted since the last read
+    uint8_t frame = (data[3] >> 2) & 0x03;
+    if (frame == lastFrame)
     {
-        if (bx < bxMin)
-            bxMin = bx; 
+        return false;
+    }
+    lastFrame = frame;
+
+    // Shift the 12 bit values to the top of an int16_t, then back down to sign extend
+    int16_t rawX = static_cast<int16_t>((data[0] << 8) | (data[4] & 0xF0)) >> 4;
+    int16_t rawY = static_cast<int16_t>((data[1] << 8) | ((data[4] & 0x0F) << 4)) >> 4;
+    int16_t rawZ = static_cast<int16_t>((data[2] << 8) | ((data[5] & 0x0F) << 4)) >> 4;
+    int16_t rawT = static_cast<int16_t>(((data[3] & 0xF0) << 8) | (data[6] << 4)) >> 4;
+
+    bx = rawX * MilliTeslaPerLsb;
+    by = rawY * MilliTeslaPerLsb;
+    bz = rawZ * MilliTeslaPerLsb;
+    temp = (rawT - TemperatureOffsetLsb) * DegreesPerLsb + TemperatureAt25;
 
-        if (bx > bxMax) 
-            bxMax = bx;
+    return true;
+}
+
+void TLVCompass::processSample(unsigned long now)
+{
+    unsigned long elapsedMs = now - lastUpdate;
+    lastUpdate = now;
 
-        if (by < byMin)
-            byMin = by;
+    if (elapsedMs > CompassMaxDtMs)
+        elapsedMs = CompassMaxDtMs;
 
-        if (by > byMax)
-            byMax = by;
+    CompassReal dt = CompassReal(static_cast<long>(elapsedMs)) / CompassReal(1000);
 
-        if (bz < bzMin)
-            bzMin = bz;
+    CompassReal bxReal = bx;
+    CompassReal byReal = by;
+    CompassReal bzReal = bz;
 
-        if (bz > bzMax)
-            bzMax = bz;
+    if (calibrating)
+    {
+        calibration.addSample(static_cast<float>(bx), static_cast<float>(by), static_cast<float>(bz));
     }
 
-    double bxCal = bx - (bxMin + bxMax) / 2;
-    double byCal = by - (byMin + byMax) / 2;
-    double bzCal = bz - (bzMin + bzMax) / 2;
+    CompassReal bxCal, byCal, bzCal;
+
+    if (calibrated)
+    {
+        CompassReal dx = bxReal - magOffset[0];
+        CompassReal dy = byReal - magOffset[1];
+        CompassReal dz = bzReal - magOffset[2];
+
+        bxCal = magTransform[0][0] * dx + magTransform[0][1] * dy + magTransform[0][2] * dz;
+        byCal = magTransform[1][0] * dx + magTransform[1][1] * dy + magTransform[1][2] * dz;
+        bzCal = magTransform[2][0] * dx + magTransform[2][1] * dy + magTransform[2][2] * dz;
+    }
+    else
+    {
+        if (firstUpdate)
+        {
+            bxMin = bxMax = bxReal;
+            byMin = byMax = byReal;
+            bzMin = bzMax = bzReal;
+            firstUpdate = false;
+        }
+        else
+        {
+            if (bxReal < bxMin)
+                bxMin = bxReal;
+
+            if (bxReal > bxMax)
+                bxMax = bxReal;
+
+            if (byReal < byMin)
+                byMin = byReal;
+
+            if (byReal > byMax)
+                byMax = byReal;
+
+            if (bzReal < bzMin)
+                bzMin = bzReal;
+
+            if (bzReal > bzMax)
+                bzMax = bzReal;
+        }
+
+        bxCal = bxReal - (bxMin + bxMax) / CompassReal(2);
+        byCal = byReal - (byMin + byMax) / CompassReal(2);
+        bzCal = bzReal - (bzMin + bzMax) / CompassReal(2);
+    }
 
     smooth(bxCal, byCal);
 
@@ -102,16 +187,25 @@ bool TLVCompass::update(unsigned long now)
     // Accelerometer
     sensors_event_t a, g, t;
 
+    if (replaying)
+    {
+        // Recorded traces carry the magnetometer only, hold the sensor level
+        memset(&a, 0, sizeof(a));
+        memset(&g, 0, sizeof(g));
+        a.acceleration.z = compassToDouble(Gravity);
+    }
+    else
+    {
+        mpu.getEvent(&a, &g, &t);
+    }
 
-    mpu.getEvent(&a, &g, &t);
-
-    ax = a.acceleration.x / 9.81; // normalize back to g
-    ay = a.acceleration.y / 9.81;
-    az = a.acceleration.z / 9.81;
+    CompassReal ax_ms2_meas = a.acceleration.x;
+    CompassReal ay_ms2_meas = a.acceleration.y;
+    CompassReal az_ms2_meas = a.acceleration.z;
 
-    double ax_ms2_meas = a.acceleration.x;
-    double ay_ms2_meas = a.acceleration.y;
-    double az_ms2_meas = a.acceleration.z;
+    ax = ax_ms2_meas / Gravity; // normalize back to g
+    ay = ay_ms2_meas / Gravity;
+    az = az_ms2_meas / Gravity;
 
     // Calibration
     if (!accelCalibrated)
@@ -122,50 +216,64 @@ bool TLVCompass::update(unsigned long now)
         accelCalCount++;
         if (accelCalCount >= accelCalSamples)
         {
-            accelBiasX = accelCalSumX / accelCalCount;
-            accelBiasY = accelCalSumY / accelCalCount;
-            accelBiasZ = accelCalSumZ / accelCalCount;
+            accelBiasX = accelCalSumX / CompassReal(accelCalCount);
+            accelBiasY = accelCalSumY / CompassReal(accelCalCount);
+            accelBiasZ = accelCalSumZ / CompassReal(accelCalCount);
             accelCalibrated = true;
             Serial.println("Accel calibration complete.");
         }
-        return true;
+        return;
     }
 #else
-    double ax_ms2_meas = 0;
-    double ay_ms2_meas = 0;
-    double az_ms2_meas = 0;
+    CompassReal ax_ms2_meas = 0;
+    CompassReal ay_ms2_meas = 0;
+    CompassReal az_ms2_meas = 0;
   
 #endif
 
     // Gravity removal
-    pitch = atan2(-ax, sqrt(ay*ay + az*az));
-    roll  = atan2(ay, az);
+#if defined(Mcu_Module) && COMPASS_ATTITUDE_FILTER
+    // Gyro carries the tilt through wave motion, accelerometer corrects drift
+    attitude.update(g.gyro.x, g.gyro.y, g.gyro.z,
+        a.acceleration.x, a.acceleration.y, a.acceleration.z,
+        static_cast<float>(compassToDouble(dt)));
+    pitch = attitude.getPitch();
+    roll = attitude.getRoll();
+#else
+    pitch = compassAtan2(-ax, compassSqrt(ay*ay + az*az));
+    roll  = compassAtan2(ay, az);
+#endif
+
+    CompassReal sinPitch = compassSin(pitch);
+    CompassReal cosPitch = compassCos(pitch);
+    CompassReal sinRoll = compassSin(roll);
+    CompassReal cosRoll = compassCos(roll);
 
-    double g_x = -sin(pitch);
-    double g_y = sin(roll) * cos(pitch);
-    double g_z = cos(roll) * cos(pitch);
+    CompassReal g_x = -sinPitch;
+    CompassReal g_y = sinRoll * cosPitch;
+    CompassReal g_z = cosRoll * cosPitch;
 
-    double grav_x_ms2 = g_x * 9.81;
-    double grav_y_ms2 = g_y * 9.81;
-    double grav_z_ms2 = g_z * 9.81;
+    CompassReal grav_x_ms2 = g_x * Gravity;
+    CompassReal grav_y_ms2 = g_y * Gravity;
+    CompassReal grav_z_ms2 = g_z * Gravity;
 
-    double ax_lin = ax_ms2_meas - grav_x_ms2 - (accelBiasX - grav_x_ms2);
-    double ay_lin = ay_ms2_meas - grav_y_ms2 - (accelBiasY - grav_y_ms2);
-    double az_lin = az_ms2_meas - grav_z_ms2 - (accelBiasZ - grav_z_ms2);
+    CompassReal ax_lin = ax_ms2_meas - grav_x_ms2 - (accelBiasX - grav_x_ms2);
+    CompassReal ay_lin = ay_ms2_meas - grav_y_ms2 - (accelBiasY - grav_y_ms2);
+    CompassReal az_lin = az_ms2_meas - grav_z_ms2 - (accelBiasZ - grav_z_ms2);
 
-    if (fabs(ax_lin) < motionThreshold) ax_lin = 0;
-    if (fabs(ay_lin) < motionThreshold) ay_lin = 0;
-    if (fabs(az_lin) < motionThreshold) az_lin = 0;
+    if (compassAbs(ax_lin) < motionThreshold) ax_lin = 0;
+    if (compassAbs(ay_lin) < motionThreshold) ay_lin = 0;
+    if (compassAbs(az_lin) < motionThreshold) az_lin = 0;
 
-    double linNorm = sqrt(ax_lin*ax_lin + ay_lin*ay_lin + az_lin*az_lin);
-    if (linNorm == 0.0)
+    CompassReal linNorm = compassSqrt(ax_lin*ax_lin + ay_lin*ay_lin + az_lin*az_lin);
+    if (linNorm == CompassReal(0))
     {
         if (!isStationary)
         {
             if (stationarySince == 0) stationarySince = now;
             else if ((now - stationarySince) >= stationaryTime)
             {
-                vx = vy = vz = 0.0;
+                vx = vy = vz = 0;
                 isStationary = true;
             }
         }
@@ -179,18 +287,45 @@ bool TLVCompass::update(unsigned long now)
         vz += az_lin * dt;
     }
 
-    // Heading
-    heading = atan2(
-        byFiltered * cos(pitch) - bzCal * sin(pitch),
-        bxFiltered * cos(roll) + byFiltered * sin(roll) * sin(pitch) + bzCal * sin(roll) * cos(pitch)
-    ) * 180.0 / M_PI;
-    if (heading < 0) heading += 360.0;
-    smoothHeading(heading);
+    // Heading vector, sin/cos of pitch and roll are computed once above
+    CompassReal headingY, headingX;
+    compassTiltCompensate(bxFiltered, byFiltered, bzCal, sinPitch, cosPitch, sinRoll, cosRoll, headingY, headingX);
+    headingFilter.update(headingY, headingX, dt);
+}
 
-    return true;
+void TLVCompass::resetState(unsigned long now)
+{
+    // The next dt is measured from the clock now runs on, replay and live
+    // samples use different clocks
+    lastUpdate = now;
+
+    bxSum = bySum = 0;
+    bxFiltered = byFiltered = 0;
+    filterIndex = 0;
+    headingFilter.reset();
+    firstUpdate = true;
+    vx = vy = vz = 0;
+    stationarySince = 0;
+    isStationary = false;
+
+#if defined(Mcu_Module) && COMPASS_ATTITUDE_FILTER
+    attitude.reset();
+#endif
+}
+
+void TLVCompass::replaySample(double replayBx, double replayBy, double replayBz, double replayTemp, unsigned long now)
+{
+    bx = replayBx;
+    by = replayBy;
+    bz = replayBz;
+    temp = replayTemp;
+
+    replaying = true;
+    processSample(now);
+    replaying = false;
 }
 
-void TLVCompass::smooth(double newBx, double newBy)
+void TLVCompass::smooth(CompassReal newBx, CompassReal newBy)
 {
     bxSum -= bxFiltered;
     bySum -= byFiltered;
@@ -203,33 +338,100 @@ void TLVCompass::smooth(double newBx, double newBy)
 
     filterIndex = (filterIndex + 1) % filterSize;
 
-    bxFiltered = bxSum / filterSize;
-    byFiltered = bySum / filterSize;
+    bxFiltered = bxSum / CompassReal(filterSize);
+    byFiltered = bySum / CompassReal(filterSize);
 }
 
-void TLVCompass::smoothHeading(double newHeading)
+void TLVCompass::setHeadingTimeConstant(unsigned long timeConstantMs)
 {
-    headingSum -= headingBuffer[headingIndex];
-    headingBuffer[headingIndex] = newHeading;
-    headingSum += newHeading;
+    headingFilter.setTimeConstant(timeConstantMs);
+}
 
-    headingIndex = (headingIndex + 1) % filterSize;
+void TLVCompass::configUpdated(const Config* config)
+{
+    if (!config || !config->compassCalibrated)
+    {
+        clearCalibration();
+        return;
+    }
+
+    // Config is packed, copy out rather than pointing into it
+    float offset[3];
+    float transform[3][3];
+    memcpy(offset, config->compassOffset, sizeof(offset));
+    memcpy(transform, config->compassTransform, sizeof(transform));
+    setCalibration(offset, transform);
+}
+
+void TLVCompass::setCalibration(const float offset[3], const float transform[3][3])
+{
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        magOffset[i] = offset[i];
+
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            magTransform[i][j] = transform[i][j];
+        }
+    }
 
-    heading = headingSum / filterSize;
+    calibrated = true;
+}
+
+void TLVCompass::clearCalibration()
+{
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        magOffset[i] = 0;
+
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            magTransform[i][j] = (i == j) ? 1 : 0;
+        }
+    }
+
+    // Restart the running min/max when falling back from a calibration
+    if (calibrated)
+    {
+        firstUpdate = true;
+    }
+
+    calibrated = false;
+}
+
+void TLVCompass::startCalibration()
+{
+    calibration.begin();
+    calibrating = true;
+}
+
+bool TLVCompass::finishCalibration(float offset[3], float transform[3][3])
+{
+    calibrating = false;
+
+    if (!calibration.solve(offset, transform))
+    {
+        return false;
+    }
+
+    setCalibration(offset, transform);
+    return true;
 }
 
 // Getters
-double TLVCompass::getHeading() const { return heading; }
+double TLVCompass::getHeading() const { return compassToDouble(headingFilter.getHeading()); }
 
 const char* TLVCompass::getDirection() const {
     int index = (int)((getHeading() + 11.25) / 22.5) % 16;
     return directions[index];
 }
 
+double TLVCompass::getRateOfTurn() const { return compassToDouble(headingFilter.getRateOfTurn()) * 60.0; }
+
 double TLVCompass::getTemperature() const { return temp; }
-double TLVCompass::getBx() const { return bxFiltered; }
-double TLVCompass::getBy() const { return byFiltered; }
+double TLVCompass::getBx() const { return compassToDouble(bxFiltered); }
+double TLVCompass::getBy() const { return compassToDouble(byFiltered); }
 double TLVCompass::getBz() const { return bz; }
-double TLVCompass::getAx() const { return ax; }
-double TLVCompass::getAy() const { return ay; }
-double TLVCompass::getAz() const { return az; }
+double TLVCompass::getAx() const { return compassToDouble(ax); }
+double TLVCompass::getAy() const { return compassToDouble(ay); }
+double TLVCompass::getAz() const { return compassToDouble(az); }
@@ -8,22 +8,54 @@
 #ifdef Mcu_Module
 #include <Adafruit_MPU6050.h>
 #include <Adafruit_Sensor.h>
+
+// Fuse gyro and accelerometer for pitch/roll, 0 uses the accelerometer alone
+#ifndef COMPASS_ATTITUDE_FILTER
+#define COMPASS_ATTITUDE_FILTER 1
+#endif
+
+#if COMPASS_ATTITUDE_FILTER
+#include "AttitudeFilter.h"
+#endif
 #endif
 
 #include "TLx493D_inc.hpp"
+#include "CompassMath.h"
+#include "HeadingFilter.h"
+#include "CompassCalibration.h"
+#include "Config.h"
+#include "AsyncI2C.h"
 
 using namespace ifx::tlx493d;
 
+// TLV493D-A1B6 7-bit bus address and the bytes holding one complete sample
+constexpr uint8_t TLV493DAddress = 0x5E;
+constexpr uint8_t TLV493DSampleBytes = 7;
+
+// Longest sample interval fed to the filters, a stalled bus or a clock
+// switch must not integrate a huge dt (and Q16.16 holds at most 32767 ms)
+constexpr unsigned long CompassMaxDtMs = 1000;
+
 
 class TLVCompass {
 public:
-    TLVCompass(int filterSize = 5);
+    TLVCompass(int filterSize = 5, unsigned long headingTimeConstantMs = DefaultHeadingTimeConstantMs);
+
+    bool begin(bool fastMode = false);  // Initialize sensors, fastMode runs the bus at 400 kHz
+    bool requestSample();               // Start a background magnetometer read
+    bool poll(unsigned long now);       // Advance the read, true when a new sample was processed
+    uint32_t getReadErrorCount() const { return bus.getErrorCount(); }
 
-    bool begin();                       // Initialize sensors
-    bool update(unsigned long now);     // Read sensors & update state
+    // Trace replay, feeds recorded magnetometer readings through the same
+    // pipeline as live samples (motion sensor held level while replaying)
+    void resetState(unsigned long now); // Restart filters and running min/max from the clock now, keeps calibration
+    void replaySample(double replayBx, double replayBy, double replayBz, double replayTemp, unsigned long now);
 
     double getHeading() const;          // Tilt-compensated heading in degrees
+    void setHeadingTimeConstant(unsigned long timeConstantMs);
+    unsigned long getHeadingTimeConstant() const { return headingFilter.getTimeConstant(); }
     const char* getDirection() const;   // N, NNE, NE, etc.
+    double getRateOfTurn() const;       // Degrees per minute, positive turning to starboard
     double getTemperature() const;
     double getBx() const;
     double getBy() const;
@@ -32,64 +64,91 @@ public:
     double getAy() const;
     double getAz() const;
 
+    // Hard/soft iron calibration
+    void configUpdated(const Config* config);                  // Apply calibration stored in config
+    void setCalibration(const float offset[3], const float transform[3][3]);
+    void clearCalibration();
+    bool isCalibrated() const { return calibrated; }
+    void startCalibration();                                    // Collect samples while the sensor is rotated
+    bool finishCalibration(float offset[3], float transform[3][3]); // Solve and apply, false if the fit failed
+    bool isCalibrating() const { return calibrating; }
+    uint16_t getCalibrationSampleCount() const { return calibration.getSampleCount(); }
+
     // Velocity
-    double getVx() const { return vx; }
-    double getVy() const { return vy; }
-    double getVz() const { return vz; }
+    double getVx() const { return compassToDouble(vx); }
+    double getVy() const { return compassToDouble(vy); }
+    double getVz() const { return compassToDouble(vz); }
 
 private:
     static const char* directions[16];
 
-    // Magnetometer
+    // Magnetometer, the library configures the sensor and samples are read
+    // in the background so loop() never waits on the bus
     TLx493D_A1B6 sensor;
+    AsyncI2C bus;
+    uint8_t sampleBuffer[TLV493DSampleBytes];
+    uint8_t lastFrame;
+    bool replaying;
 
 #ifdef Mcu_Module
     // Accelerometer/Gyro
     Adafruit_MPU6050 mpu;
+
+#if COMPASS_ATTITUDE_FILTER
+    AttitudeFilter attitude;
+#endif
 #endif
 
-    // Smoothing
+    // Smoothing (numeric type selected by COMPASS_MATH, see CompassMath.h)
     int filterSize;
     int filterIndex;
-    double bxSum, bySum;
-    double bxFiltered, byFiltered;
-    double heading;
-    double headingSum;
-    int headingIndex;
-    double headingBuffer[32];
-    double pitch, roll;
-
-    // Raw readings
-    double temp, bx, by, bz;
-    double ax, ay, az;
+    CompassReal bxSum, bySum;
+    CompassReal bxFiltered, byFiltered;
+
+    // Heading filter, exponential average of the heading unit vector so
+    // 359 and 1 degrees average to 0 rather than 180, and the rate of turn
+    HeadingFilter headingFilter;
+    CompassReal pitch, roll;
 
-    // Auto-calibration
-    double bxMin, bxMax;
-    double byMin, byMax;
-    double bzMin, bzMax;
+    // Raw readings (the sensor library reports double)
+    double temp, bx, by, bz;
+    CompassReal ax, ay, az;
+
+    // Hard/soft iron calibration, replaces the running min/max once set
+    CompassCalibration calibration;
+    bool calibrating;
+    bool calibrated;
+    CompassReal magOffset[3];
+    CompassReal magTransform[3][3];
+
+    // Auto-calibration, used until a calibration has been set
+    CompassReal bxMin, bxMax;
+    CompassReal byMin, byMax;
+    CompassReal bzMin, bzMax;
     bool firstUpdate;
 
     // Accel calibration
-    double accelBiasX = 0.0;
-    double accelBiasY = 0.0;
-    double accelBiasZ = 0.0;
+    CompassReal accelBiasX = 0.0;
+    CompassReal accelBiasY = 0.0;
+    CompassReal accelBiasZ = 0.0;
     bool accelCalibrated = false;
     int accelCalSamples = 200;
     int accelCalCount = 0;
-    double accelCalSumX = 0;
-    double accelCalSumY = 0;
-    double accelCalSumZ = 0;
+    CompassReal accelCalSumX = 0;
+    CompassReal accelCalSumY = 0;
+    CompassReal accelCalSumZ = 0;
 
     // Velocity & ZUPT
-    double vx = 0.0;
-    double vy = 0.0;
-    double vz = 0.0;
+    CompassReal vx = 0.0;
+    CompassReal vy = 0.0;
+    CompassReal vz = 0.0;
     unsigned long lastUpdate = 0;
-    const double motionThreshold = 0.1;
+    const CompassReal motionThreshold = 0.1;
     unsigned long stationaryTime = 500;
     unsigned long stationarySince = 0;
     bool isStationary = false;
 
-    void smooth(double newBx, double newBy);
-    void smoothHeading(double newHeading);
+    bool decodeSample();
+    void processSample(unsigned long now);
+    void smooth(CompassReal newBx, CompassReal newBy);
 };
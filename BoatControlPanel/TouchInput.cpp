@@ -0,0 +1,145 @@
+#include "TouchInput.h"
+
+TouchInput::TouchInput(unsigned long coalesceWindowMs, unsigned long longPressMs)
+    : _head(0),
+      _count(0),
+      _coalesceWindowMs(coalesceWindowMs),
+      _longPressMs(longPressMs),
+      _isHeld(false),
+      _heldCompId(0),
+      _pressTime(0),
+      _longPressReported(false),
+      _longPressEnded(false)
+{
+}
+
+void TouchInput::press(uint8_t compId, unsigned long now)
+{
+    _isHeld = true;
+    _heldCompId = compId;
+    _pressTime = now;
+    _longPressReported = false;
+    _longPressEnded = false;
+}
+
+void TouchInput::release(uint8_t compId, unsigned long now)
+{
+    bool wasLongPress = _isHeld && _heldCompId == compId && _longPressReported;
+    _isHeld = false;
+
+    // The long press has already been reported, the release ends it
+    if (wasLongPress)
+    {
+        _longPressEnded = true;
+        return;
+    }
+
+    // A release without a matching press is still treated as a tap, the
+    // display may be configured to only send release events
+    addTap(compId, now);
+}
+
+void TouchInput::addTap(uint8_t compId, unsigned long now)
+{
+    // Collapse into the follow up of a pending tap for the same component
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        PendingTap& pending = _queue[(_head + i) % TouchQueueSize];
+
+        if (pending.compId == compId)
+        {
+            if (pending.tapCount < 0xFF)
+                pending.tapCount++;
+
+            pending.lastTapTime = now;
+            return;
+        }
+    }
+
+    // Queue full, the tap is dropped so link traffic stays bounded
+    if (_count >= TouchQueueSize)
+        return;
+
+    PendingTap& pending = _queue[(_head + _count) % TouchQueueSize];
+    pending.compId = compId;
+    pending.tapCount = 0;
+    pending.lastTapTime = now;
+    pending.firstReported = false;
+    _count++;
+}
+
+bool TouchInput::poll(unsigned long now, TouchAction& action)
+{
+    // Long press is reported while the component is still held
+    if (_isHeld && !_longPressReported && now - _pressTime >= _longPressMs)
+    {
+        _longPressReported = true;
+
+        action.compId = _heldCompId;
+        action.gesture = TouchGesture::LongPress;
+        action.tapCount = 0;
+        return true;
+    }
+
+    if (_longPressEnded)
+    {
+        _longPressEnded = false;
+
+        action.compId = _heldCompId;
+        action.gesture = TouchGesture::LongPressEnd;
+        action.tapCount = 0;
+        return true;
+    }
+
+    // The first tap on a component is reported without waiting
+    for (uint8_t i = 0; i < _count; i++)
+    {
+        PendingTap& pending = _queue[(_head + i) % TouchQueueSize];
+
+        if (!pending.firstReported)
+        {
+            pending.firstReported = true;
+
+            action.compId = pending.compId;
+            action.gesture = TouchGesture::Tap;
+            action.tapCount = 1;
+            return true;
+        }
+    }
+
+    // Further taps settle in order, once no tap arrives within the window
+    while (_count > 0)
+    {
+        PendingTap& pending = _queue[_head];
+
+        if (now - pending.lastTapTime < _coalesceWindowMs)
+            return false;
+
+        _head = (_head + 1) % TouchQueueSize;
+        _count--;
+
+        if (pending.tapCount > 0)
+        {
+            action.compId = pending.compId;
+            action.gesture = TouchGesture::Tap;
+            action.tapCount = pending.tapCount;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool TouchInput::isLongPressActive() const
+{
+    return _isHeld && _longPressReported;
+}
+
+void TouchInput::clear()
+{
+    _head = 0;
+    _count = 0;
+    _isHeld = false;
+    _longPressReported = false;
+    _longPressEnded = false;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Taps on the same component within this window of the previous one are
+// collapsed into one follow up action
+constexpr unsigned long TouchCoalesceWindowMs = 300;
+
+// Time a component must be held before a long press is reported
+constexpr unsigned long TouchLongPressMs = 800;
+
+// Maximum number of distinct components with pending taps
+constexpr uint8_t TouchQueueSize = 4;
+
+/**
+ * @enum TouchGesture
+ * @brief Gesture recognised by TouchInput.
+ */
+enum class TouchGesture : uint8_t {
+    Tap,            // One or more taps, see TouchAction::tapCount
+    LongPress,      // Component held for TouchLongPressMs
+    LongPressEnd    // Component released after a LongPress
+};
+
+/**
+ * @struct TouchAction
+ * @brief Settled touch action returned by TouchInput::poll().
+ */
+struct TouchAction {
+    uint8_t compId;         // Nextion component id
+    TouchGesture gesture;   // Recognised gesture
+    uint8_t tapCount;       // Number of taps in this action (Tap only), see TouchInput
+};
+
+/**
+ * @class TouchInput
+ * @brief Queues Nextion touch events and turns them into settled actions.
+ *
+ * Press and release events are recorded with timestamps instead of being
+ * acted on inline. The first tap on a component is reported straight away
+ * as a Tap with a tapCount of 1, so a toggle button responds without delay.
+ * Further taps on the same component within the coalesce window are
+ * collapsed and reported once the window has passed as a single Tap whose
+ * tapCount is the number of further taps, so a burst of taps on a toggle
+ * button produces the first command and at most one corrective command.
+ * Pages toggle on an odd tapCount and ignore an even one.
+ *
+ * A component held down for the long press time is reported as a
+ * LongPress while it is still held, and its release is reported as
+ * LongPressEnd instead of a tap, so hold actions (the horn) can be stopped.
+ *
+ * Usage:
+ * @code
+ * // handleTouch()
+ * if (eventType == EventPress)
+ *     _touchInput.press(compId, millis());
+ * else
+ *     _touchInput.release(compId, millis());
+ *
+ * // refresh()
+ * TouchAction action;
+ * while (_touchInput.poll(now, action))
+ *     handleTouchAction(action);
+ * @endcode
+ */
+class TouchInput
+{
+private:
+    struct PendingTap
+    {
+        uint8_t compId;
+        uint8_t tapCount;           // Taps after the first
+        unsigned long lastTapTime;
+        bool firstReported;
+    };
+
+    PendingTap _queue[TouchQueueSize];
+    uint8_t _head;
+    uint8_t _count;
+
+    unsigned long _coalesceWindowMs;
+    unsigned long _longPressMs;
+
+    // Component currently held down
+    bool _isHeld;
+    uint8_t _heldCompId;
+    unsigned long _pressTime;
+    bool _longPressReported;
+    bool _longPressEnded;
+
+    void addTap(uint8_t compId, unsigned long now);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param coalesceWindowMs Window in which taps on the same component are collapsed
+     * @param longPressMs Hold time before a long press is reported
+     */
+    explicit TouchInput(unsigned long coalesceWindowMs = TouchCoalesceWindowMs,
+        unsigned long longPressMs = TouchLongPressMs);
+
+    /**
+     * @brief Record a press event.
+     * @param compId Nextion component id
+     * @param now Current time in milliseconds
+     */
+    void press(uint8_t compId, unsigned long now);
+
+    /**
+     * @brief Record a release event.
+     * @param compId Nextion component id
+     * @param now Current time in milliseconds
+     */
+    void release(uint8_t compId, unsigned long now);
+
+    /**
+     * @brief Get the next settled action.
+     *
+     * Call repeatedly from refresh() until it returns false.
+     * @param now Current time in milliseconds
+     * @param action Receives the action
+     * @return true if an action was returned
+     */
+    bool poll(unsigned long now, TouchAction& action);
+
+    /**
+     * @brief Check if a long press has been reported and not yet released.
+     * @return true while the held component's long press action is active
+     */
+    bool isLongPressActive() const;
+
+    /**
+     * @brief Discard all pending taps, any held component and any pending
+     * long press end.
+     */
+    void clear();
+};
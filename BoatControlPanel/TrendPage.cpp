@@ -0,0 +1,231 @@
+#include "TrendPage.h"
+
+// Page specific actions, PageComponent::value for ComponentRole::Action
+constexpr uint8_t TrendActionNextSensor = 0;
+constexpr uint8_t TrendActionResolution = 1;
+
+// Nextion id of the waveform and its channels
+constexpr uint8_t TrendWaveformId = 1;
+constexpr uint8_t TrendChannelAverage = 0;
+constexpr uint8_t TrendChannelMinimum = 1;
+constexpr uint8_t TrendChannelMaximum = 2;
+
+// Waveform height in pixels, points are scaled into 0..TrendWaveHeight - 1
+constexpr uint8_t TrendWaveHeight = 200;
+
+// One bucket (three points) per interval keeps the display serial from backing up
+constexpr unsigned long TrendPointIntervalMs = 40;
+
+// Component registry, indexed by Nextion component id
+const PageComponent TrendComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                                    // 0 page
+    { "s0", ComponentRole::None, 0, nullptr },                                  // 1 waveform
+    { "t0", ComponentRole::None, 0, nullptr },                                  // 2 sensor and period
+    { "t1", ComponentRole::None, 0, nullptr },                                  // 3 range
+    { "b0", ComponentRole::Action, TrendActionNextSensor, nullptr },            // 4 next sensor
+    { "b1", ComponentRole::Action, TrendActionResolution, nullptr },            // 5 1h / 24h
+    { "b2", ComponentRole::Navigate, PageHome, nullptr }                        // 6 back
+};
+
+const char TrendPeriodHour[] PROGMEM = " 1h";
+const char TrendPeriodDay[] PROGMEM = " 24h";
+const char TrendRangeSeparator[] PROGMEM = " - ";
+const char TrendNoData[] PROGMEM = "No data";
+
+constexpr char TrendTitleName[] = "t0";
+constexpr char TrendRangeName[] = "t1";
+
+// Writes a value scaled by 10^decimals, e.g. 1234 with 2 decimals as "12.34"
+static void formatScaled(char* buffer, size_t size, int16_t value, uint8_t decimals)
+{
+    int32_t scale = 1;
+    for (uint8_t i = 0; i < decimals; i++)
+        scale *= 10;
+
+    int32_t magnitude = value < 0 ? -static_cast<int32_t>(value) : value;
+    int length = snprintf(buffer, size, "%s%ld", value < 0 ? "-" : "", static_cast<long>(magnitude / scale));
+
+    if (decimals == 0 || length < 0 || static_cast<size_t>(length) + decimals + 1 >= size)
+        return;
+
+    // fraction digits written by hand, leading zeros kept
+    buffer[length++] = '.';
+
+    for (int32_t divisor = scale / 10; divisor > 0; divisor /= 10)
+        buffer[length++] = '0' + (magnitude / divisor) % 10;
+
+    buffer[length] = '\0';
+}
+
+
+TrendPage::TrendPage(Stream* serialPort,
+    WarningManager* warningMgr,
+    SensorHistory* history,
+    SerialCommandManager* commandMgrLink,
+    SerialCommandManager* commandMgrComputer)
+    : BaseBoatPage(serialPort, warningMgr, commandMgrLink, commandMgrComputer),
+      _history(history), _series(0), _resolution(HistoryResolution::Minute),
+      _drawnMinutes(0), _drawIndex(0), _drawCount(0), _rangeLow(0), _rangeHigh(0), _lastPointTime(0)
+{
+}
+
+void TrendPage::begin()
+{
+
+}
+
+void TrendPage::onEnterPage()
+{
+    startRedraw();
+}
+
+void TrendPage::refresh(unsigned long now)
+{
+    if (!_history)
+        return;
+
+    // a new minute bucket moves the whole plot along by one
+    if (_history->getClosedMinutes() != _drawnMinutes)
+    {
+        startRedraw();
+    }
+
+    if (_drawIndex < _drawCount && now - _lastPointTime >= TrendPointIntervalMs)
+    {
+        drawNextBucket();
+        _lastPointTime = now;
+    }
+}
+
+void TrendPage::startRedraw()
+{
+    if (!_history)
+        return;
+
+    uint8_t sensorId = _history->getSeriesSensorId(_series);
+
+    _drawnMinutes = _history->getClosedMinutes();
+    _drawIndex = 0;
+    _drawCount = _history->getBucketCount(sensorId, _resolution);
+
+    // common scale for all three channels, one pass over at most 96 buckets
+    _rangeLow = HistoryNoValue;
+    _rangeHigh = HistoryNoValue;
+
+    HistoryBucket bucket;
+
+    for (uint8_t i = 0; i < _drawCount; i++)
+    {
+        if (!_history->getBucket(sensorId, _resolution, i, bucket) || bucket.average == HistoryNoValue)
+            continue;
+
+        if (_rangeLow == HistoryNoValue || bucket.minimum < _rangeLow)
+            _rangeLow = bucket.minimum;
+
+        if (_rangeHigh == HistoryNoValue || bucket.maximum > _rangeHigh)
+            _rangeHigh = bucket.maximum;
+    }
+
+    clearWaveform(TrendWaveformId, 255);
+    updateLabels();
+}
+
+void TrendPage::drawNextBucket()
+{
+    HistoryBucket bucket;
+    uint8_t sensorId = _history->getSeriesSensorId(_series);
+
+    if (!_history->getBucket(sensorId, _resolution, _drawIndex++, bucket) || bucket.average == HistoryNoValue)
+    {
+        // keeps later points in the right place, drawn along the bottom
+        bucket.average = _rangeLow;
+        bucket.minimum = _rangeLow;
+        bucket.maximum = _rangeLow;
+    }
+
+    addWaveformPoint(TrendWaveformId, TrendChannelAverage, scalePoint(bucket.average));
+    addWaveformPoint(TrendWaveformId, TrendChannelMinimum, scalePoint(bucket.minimum));
+    addWaveformPoint(TrendWaveformId, TrendChannelMaximum, scalePoint(bucket.maximum));
+}
+
+uint8_t TrendPage::scalePoint(int16_t value) const
+{
+    if (_rangeLow == HistoryNoValue || _rangeHigh <= _rangeLow)
+        return TrendWaveHeight / 2;
+
+    int32_t offset = static_cast<int32_t>(value) - _rangeLow;
+    int32_t span = static_cast<int32_t>(_rangeHigh) - _rangeLow;
+
+    return static_cast<uint8_t>(offset * (TrendWaveHeight - 1) / span);
+}
+
+void TrendPage::updateLabels()
+{
+    uint8_t sensorId = _history->getSeriesSensorId(_series);
+    SensorDescriptor descriptor;
+
+    if (!SensorRegistry::getDescriptor(sensorId, descriptor))
+        return;
+
+    beginText(TrendTitleName);
+    appendTextP(descriptor.name);
+    appendTextP(_resolution == HistoryResolution::Minute ? TrendPeriodHour : TrendPeriodDay);
+    endText();
+
+    beginText(TrendRangeName);
+
+    if (_rangeLow == HistoryNoValue)
+    {
+        appendTextP(TrendNoData);
+    }
+    else
+    {
+        char buffer[10];
+        uint8_t decimals = _history->getDecimals(sensorId);
+
+        formatScaled(buffer, sizeof(buffer), _rangeLow, decimals);
+        appendText(buffer);
+        appendTextP(TrendRangeSeparator);
+        formatScaled(buffer, sizeof(buffer), _rangeHigh, decimals);
+        appendText(buffer);
+
+        if (descriptor.unit && pgm_read_byte(descriptor.unit) != '\0')
+        {
+            appendText(" ");
+            appendTextP(descriptor.unit);
+        }
+    }
+
+    endText();
+}
+
+// Handle touch events for buttons
+void TrendPage::handleTouch(uint8_t compId, uint8_t eventType)
+{
+    PageComponent component;
+
+    if (!readPageComponent(TrendComponents, compId, component))
+        return;
+
+    if (handleComponentTouch(component, eventType))
+        return;
+
+    if (component.role != ComponentRole::Action || eventType != EventRelease)
+        return;
+
+    switch (component.value)
+    {
+        case TrendActionNextSensor:
+            _series = (_series + 1) % HistorySeriesCount;
+            break;
+
+        case TrendActionResolution:
+            _resolution = _resolution == HistoryResolution::Minute ? HistoryResolution::Quarter : HistoryResolution::Minute;
+            break;
+
+        default:
+            return;
+    }
+
+    startRedraw();
+}
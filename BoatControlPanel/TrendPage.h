@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SerialCommandManager.h>
+#include <NextionControl.h>
+#include <stdint.h>
+
+#include "BaseBoatPage.h"
+#include "NextionIds.h"
+#include "BoatControlPanelConstants.h"
+#include "SensorHistory.h"
+
+
+/**
+ * @class TrendPage
+ * @brief Optional page plotting the sensor history on a waveform.
+ *
+ * Shows the average, minimum and maximum of each bucket for one tracked
+ * sensor at either resolution. The waveform is cleared and redrawn when
+ * the page is entered, the sensor or resolution changes or a new minute
+ * closes. Points are sent a bucket at a time from refresh() so a redraw
+ * never holds up the loop waiting on the display serial.
+ */
+class TrendPage : public BaseBoatPage {
+private:
+    SensorHistory* _history;
+    uint8_t _series;
+    HistoryResolution _resolution;
+
+    // Redraw state, _drawIndex == _drawCount when nothing is pending
+    uint32_t _drawnMinutes;
+    uint8_t _drawIndex;
+    uint8_t _drawCount;
+    int16_t _rangeLow;
+    int16_t _rangeHigh;
+    unsigned long _lastPointTime;
+
+    void startRedraw();
+    void drawNextBucket();
+    void updateLabels();
+    uint8_t scalePoint(int16_t value) const;
+
+protected:
+    // Required overrides
+    uint8_t getPageId() const override { return PageTrend; }
+    void begin() override;
+    void refresh(unsigned long now) override;
+
+    //optional overrides
+    void onEnterPage() override;
+    void handleTouch(uint8_t compId, uint8_t eventType) override;
+
+public:
+    explicit TrendPage(Stream* serialPort,
+        WarningManager* warningMgr,
+        SensorHistory* history,
+        SerialCommandManager* commandMgrLink = nullptr,
+        SerialCommandManager* commandMgrComputer = nullptr);
+};
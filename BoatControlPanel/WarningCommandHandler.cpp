@@ -8,8 +8,8 @@ const char WarningsClear[] = "W3";
 const char WarningsAdd[] = "W4";
 
 
-WarningCommandHandler::WarningCommandHandler(SerialCommandManager* computerCommandManager, NextionControl* nextionControl, WarningManager* warningManager)
-    : BaseBoatCommandHandler(computerCommandManager, nextionControl, warningManager)
+WarningCommandHandler::WarningCommandHandler(SerialCommandManager* computerCommandManager, WarningManager* warningManager)
+    : BaseBoatCommandHandler(computerCommandManager, warningManager)
 {
 }
 
@@ -28,12 +28,11 @@ bool WarningCommandHandler::handleCommand(SerialCommandManager* sender, const St
 
     if (cmd == WarningsActive && paramCount == 0)
     {
+        uint32_t activeWarnings = _warningManager->getActiveWarnings();
         uint8_t count = 0;
         for (uint8_t i = 1; i < WarningCount; i++)
         {
-            WarningType type = static_cast<WarningType>(i);
-
-            if (_warningManager->isWarningActive(type))
+            if (activeWarnings & (1UL << i))
             {
                 count++;
             }
@@ -47,10 +46,11 @@ bool WarningCommandHandler::handleCommand(SerialCommandManager* sender, const St
     {
         // Send list of all defined warning types with their active status
 
+        uint32_t activeWarnings = _warningManager->getActiveWarnings();
+
         for (uint8_t i = 1; i < WarningCount; i++)  // Start at 1 to skip WarningType::None
         {
-            WarningType type = static_cast<WarningType>(i);
-            bool isActive = _warningManager->isWarningActive(type);
+            bool isActive = (activeWarnings & (1UL << i)) != 0;
 
             StringKeyValue param = { String(i), isActive ? "1" : "0" };
             sendAckOk(sender, cmd, &param);
@@ -10,8 +10,8 @@ class WarningCommandHandler : public BaseBoatCommandHandler
 private:
 	bool convertWarningTypeFromString(const String& str, WarningType& outType);
 public:
-    // Constructor: pass the NextionControl pointer so we can notify the current page
-    explicit WarningCommandHandler(SerialCommandManager* computerCommandManager, NextionControl* nextionControl, WarningManager* warningManager);
+    // Constructor: updates are published on the EventBus for any interested subscriber
+    explicit WarningCommandHandler(SerialCommandManager* computerCommandManager, WarningManager* warningManager);
 
     bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
     const String* supportedCommands(size_t& count) const override;
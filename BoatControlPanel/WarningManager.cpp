@@ -1,5 +1,29 @@
 #include "WarningManager.h"
 
+// Warning descriptions, stored in flash and indexed by WarningType
+const char WarningTextNone[] PROGMEM = "No Warning";
+const char WarningTextDefaultConfiguration[] PROGMEM = "Using Default Configuration";
+const char WarningTextConnectionLost[] PROGMEM = "Connection Lost To Fuse Box";
+const char WarningTextHighCompassTemperature[] PROGMEM = "High Compass Temperature";
+const char WarningTextLowBattery[] PROGMEM = "Low Battery";
+const char WarningTextSensorFailure[] PROGMEM = "Sensor Failure";
+const char WarningTextCompassFailure[] PROGMEM = "Compass Failure";
+const char WarningTextRelayTripped[] PROGMEM = "Relay Over Current Trip";
+
+const char* const WarningDescriptions[] PROGMEM = {
+    WarningTextNone,                    // None
+    WarningTextDefaultConfiguration,    // DefaultConfiguration
+    WarningTextConnectionLost,          // ConnectionLost
+    WarningTextHighCompassTemperature,  // HighCompassTemperature
+    WarningTextLowBattery,              // LowBattery
+    WarningTextSensorFailure,           // SensorFailure
+    WarningTextCompassFailure,          // CompassFailure
+    WarningTextRelayTripped             // RelayTripped
+};
+
+static_assert(sizeof(WarningDescriptions) / sizeof(WarningDescriptions[0]) == WarningCount,
+    "WarningDescriptions must have an entry for each WarningType");
+
 WarningManager::WarningManager(SerialCommandManager* commandMgr, unsigned long heartbeatInterval, unsigned long heartbeatTimeout)
     : _commandMgr(commandMgr),
       _activeWarnings(0),
@@ -9,6 +33,7 @@ WarningManager::WarningManager(SerialCommandManager* commandMgr, unsigned long h
       _lastHeartbeatReceived(0),
       _heartbeatEnabled(heartbeatInterval > 0)
 {
+    EventBus<HeartbeatAckEvent>::subscribe<WarningManager, &WarningManager::onHeartbeatAck>(this);
 }
 
 void WarningManager::update(unsigned long now)
@@ -35,7 +60,7 @@ void WarningManager::raiseWarning(WarningType type)
     uint8_t bit = static_cast<uint8_t>(type);
     if (bit < 32)  // Ensure we don't overflow the bitmap
     {
-        _activeWarnings |= (1UL << bit);
+        setActiveWarnings(_activeWarnings | (1UL << bit));
     }
 }
 
@@ -47,13 +72,13 @@ void WarningManager::clearWarning(WarningType type)
     uint8_t bit = static_cast<uint8_t>(type);
     if (bit < 32)
     {
-        _activeWarnings &= ~(1UL << bit);
+        setActiveWarnings(_activeWarnings & ~(1UL << bit));
     }
 }
 
 void WarningManager::clearAllWarnings()
 {
-    _activeWarnings = 0;
+    setActiveWarnings(0);
 }
 
 bool WarningManager::hasWarnings() const
@@ -75,6 +100,33 @@ bool WarningManager::isWarningActive(WarningType type) const
     return false;
 }
 
+PGM_P WarningManager::getWarningDescription(WarningType type)
+{
+    uint8_t index = static_cast<uint8_t>(type);
+
+    if (index >= WarningCount)
+        return nullptr;
+
+    return static_cast<PGM_P>(pgm_read_ptr(&WarningDescriptions[index]));
+}
+
+void WarningManager::setActiveWarnings(uint32_t activeWarnings)
+{
+    if (activeWarnings == _activeWarnings)
+        return;
+
+    _activeWarnings = activeWarnings;
+
+    WarningsChangedEvent event = { _activeWarnings };
+    publishEvent(event);
+}
+
+void WarningManager::onHeartbeatAck(const HeartbeatAckEvent& event)
+{
+    (void)event;
+    notifyHeartbeatAck();
+}
+
 void WarningManager::sendHeartbeat()
 {
     if (_commandMgr)
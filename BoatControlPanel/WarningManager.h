@@ -4,6 +4,8 @@
 #include <SerialCommandManager.h>
 #include <stdint.h>
 #include "BoatControlPanelConstants.h"
+#include "EventBus.h"
+#include "BoatEvents.h"
 
 /**
  * @enum WarningType
@@ -20,11 +22,12 @@ enum class WarningType : uint8_t {
     LowBattery = 0x04,              // Battery voltage low
     SensorFailure = 0x05,           // Sensor communication failure
     CompassFailure = 0x06,          // Compass failed to initialize
+    RelayTripped = 0x07,            // Relay switched off by an overcurrent trip
     
-    // Add new warning types here (0x07 - 0xFF)
+    // Add new warning types here (0x08 - 0xFF)
 };
 
-const uint8_t WarningCount = 7; // Update this if you add more warning types
+const uint8_t WarningCount = 8; // Update this if you add more warning types
 
 /**
  * @class WarningManager
@@ -39,6 +42,8 @@ const uint8_t WarningCount = 7; // Update this if you add more warning types
  * - Built-in heartbeat monitoring with automatic F0 command transmission
  * - Extensible WarningType enum for adding new warnings
  * - Query methods to check active warnings
+ * - Publishes WarningsChangedEvent whenever the active warnings change
+ * - Subscribes to HeartbeatAckEvent to track the link connection
  * 
  * Usage:
  * @code
@@ -47,7 +52,7 @@ const uint8_t WarningCount = 7; // Update this if you add more warning types
  * // In loop or refresh:
  * warningMgr.update(millis());
  * 
- * // When ACK:F0=ok received:
+ * // When ACK:F0=ok received (or publish a HeartbeatAckEvent):
  * warningMgr.notifyHeartbeatAck();
  * 
  * // Raise other warnings from anywhere:
@@ -112,6 +117,19 @@ public:
      */
     bool isWarningActive(WarningType type) const;
 
+    /**
+     * @brief Get the bitmap of active warnings.
+     * @return Bitmap with one bit per WarningType (bit n = WarningType n)
+     */
+    uint32_t getActiveWarnings() const { return _activeWarnings; }
+
+    /**
+     * @brief Get the description of a warning type.
+     * @param type The warning type
+     * @return Pointer to the description in flash (PROGMEM), or nullptr if the type is out of range
+     */
+    static PGM_P getWarningDescription(WarningType type);
+
 private:
     SerialCommandManager* _commandMgr;      // For sending heartbeat commands
     uint32_t _activeWarnings;               // Bitmap of active warnings (bit per WarningType)
@@ -128,6 +146,17 @@ private:
      */
     void sendHeartbeat();
 
+    /**
+     * @brief Store a new warnings bitmap, publishing a change event if it differs.
+     * @param activeWarnings New bitmap of active warnings
+     */
+    void setActiveWarnings(uint32_t activeWarnings);
+
+    /**
+     * @brief EventBus handler for heartbeat acknowledgements.
+     */
+    void onHeartbeatAck(const HeartbeatAckEvent& event);
+
     /**
      * @brief Update connection state based on heartbeat.
      * @param now Current time in milliseconds
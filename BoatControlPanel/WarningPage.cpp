@@ -1,11 +1,20 @@
 #include "WarningPage.h"
 #include <NextionControl.h>
 
-// Nextion Names/Ids on Warning Page
-constexpr uint8_t ButtonPrevious = 2;
-constexpr uint8_t ButtonNext = 3;
+// Component registry, indexed by Nextion component id
+const PageComponent WarningComponents[] PROGMEM = {
+    { "", ComponentRole::None, 0, nullptr },                // 0 page
+    { "", ComponentRole::None, 0, nullptr },                // 1
+    { "", ComponentRole::Navigate, PageHome, nullptr },     // 2 previous
+    { "", ComponentRole::Navigate, PageRelay, nullptr }     // 3 next
+};
+
+// Nextion Names on Warning Page
 constexpr char WarningListComponentName[] = "t1";
 constexpr char WarningHeader[] = "t2";
+constexpr char WarningSeparator[] = "\r\n";
+const char WarningHeaderText[] PROGMEM = "System Warnings";
+const char NoActiveWarningsText[] PROGMEM = "No Active Warnings";
 
 
 WarningPage::WarningPage(Stream* serialPort,
@@ -13,150 +22,88 @@ WarningPage::WarningPage(Stream* serialPort,
     SerialCommandManager* commandMgrLink,
     SerialCommandManager* commandMgrComputer)
     : BaseBoatPage(serialPort, warningMgr, commandMgrLink, commandMgrComputer),
-      _lastActiveWarnings(0),
-      _lastUpdateTime(0)
+      _lastActiveWarnings(0)
 {
-
+    EventBus<WarningsChangedEvent>::subscribe<WarningPage, &WarningPage::onWarningsChanged>(this);
 }
 
 void WarningPage::begin()
 {
     _lastActiveWarnings = 0;
-    _lastUpdateTime = 0;
 }
 
 void WarningPage::onEnterPage()
 {
-    // Force update when entering the page
-    _lastActiveWarnings = 0;
-    _lastUpdateTime = 0;
-    updateWarningDisplay();
-}
+    WarningManager* warningMgr = getWarningManager();
 
-// Helper function to convert WarningType enum to string
-String warningTypeToString(WarningType type)
-{
-    switch (type)
-    {
-    case WarningType::DefaultConfiguration:
-        return F("Using Default Configuration");
-    case WarningType::ConnectionLost:
-        return F("Connection Lost To Fuse Box");
-    case WarningType::HighCompassTemperature:
-        return F("High Compass Temperature");
-    case WarningType::LowBattery:
-        return F("Low Battery");
-    case WarningType::SensorFailure:
-        return F("Sensor Failure");
-    case WarningType::CompassFailure:
-        return F("Compass Failure");
-    default:
-        return F("Unknown Warning");
-    }
+    if (!warningMgr)
+        return;
+
+    // Components are reset when the page loads, redraw everything
+    beginText(WarningHeader);
+    appendTextP(WarningHeaderText);
+    endText();
+
+    updateWarningDisplay(warningMgr->getActiveWarnings(), true);
 }
 
-void WarningPage::updateWarningDisplay()
+void WarningPage::updateWarningDisplay(uint32_t activeWarnings, bool force)
 {
-    sendText(WarningHeader, F("System Warnings"));
-    WarningManager* warningMgr = getWarningManager();
-
-    if (!warningMgr)
+    if (!force && activeWarnings == _lastActiveWarnings)
         return;
 
-    String warningText;
-    bool firstWarning = true;
+    _lastActiveWarnings = activeWarnings;
 
-    // Iterate through all defined warning types (skip None)
-    for (uint8_t i = 1; i < WarningCount; i++)
+    beginText(WarningListComponentName);
+
+    // If no warnings are active, display a message
+    if (activeWarnings == 0)
     {
-        WarningType type = static_cast<WarningType>(i);
+        appendTextP(NoActiveWarningsText);
+    }
+    else
+    {
+        bool firstWarning = true;
 
-        if (warningMgr->isWarningActive(type))
+        // Iterate through all defined warning types (skip None)
+        for (uint8_t i = 1; i < WarningCount; i++)
         {
+            if ((activeWarnings & (1UL << i)) == 0)
+                continue;
+
             // Add separator before subsequent warnings
             if (!firstWarning)
-            {
-                warningText += "\r\n";
-            }
-            
-            warningText += warningTypeToString(type);
+                appendText(WarningSeparator);
+
+            appendTextP(WarningManager::getWarningDescription(static_cast<WarningType>(i)));
             firstWarning = false;
         }
     }
 
-    // If no warnings are active, display a message
-    if (warningText.length() == 0)
-    {
-        warningText = F("No Active Warnings");
-    }
-
-    // Send the formatted warning list to the Nextion control
-    sendText(WarningListComponentName, warningText);
+    endText();
 }
 
 void WarningPage::refresh(unsigned long now)
 {
-    WarningManager* warningMgr = getWarningManager();
-    if (!warningMgr)
-        return;
-
-    // Get current active warnings bitmap
-    // Note: This assumes WarningManager has a method to get the bitmap
-    // If not available, we can iterate through warnings to build it
-    uint32_t currentWarnings = 0;
-    for (uint8_t i = 1; i < WarningCount; i++)
-    {
-        WarningType type = static_cast<WarningType>(i);
-        if (warningMgr->isWarningActive(type))
-        {
-            currentWarnings |= (1UL << i);
-        }
-    }
-
-    // Check if warnings changed OR 10 seconds elapsed
-    bool warningsChanged = (currentWarnings != _lastActiveWarnings);
-    bool timeoutElapsed = (now - _lastUpdateTime >= UpdateIntervalMs);
-
-    if (warningsChanged || timeoutElapsed)
-    {
-        updateWarningDisplay();
-        _lastActiveWarnings = currentWarnings;
-        _lastUpdateTime = now;
-    }
+    // Display is updated from WarningsChangedEvent, nothing to poll
+    (void)now;
 }
 
 // Handle touch events for buttons
 void WarningPage::handleTouch(uint8_t compId, uint8_t eventType)
 {
-    // Only handle release events
-    if (eventType != EventRelease) {
-        return;
-    }
+    PageComponent component;
 
-    // Map component ID to button index
-    switch (compId)
+    if (readPageComponent(WarningComponents, compId, component))
     {
-    case ButtonPrevious:
-        setPage(PageHome);
-        break;
-
-    case ButtonNext:
-        setPage(PageRelay);
-        break;
+        handleComponentTouch(component, eventType);
     }
 }
 
-void WarningPage::handleExternalUpdate(uint8_t updateType, const void* data)
+void WarningPage::onWarningsChanged(const WarningsChangedEvent& event)
 {
-    // Call base class first to handle heartbeat ACKs
-    BaseBoatPage::handleExternalUpdate(updateType, data);
+    if (!isCurrentPage())
+        return;
 
-    // If warning state changed, force immediate update
-    if (updateType == static_cast<uint8_t>(PageUpdateType::Warning))
-    {
-        // Reset the cached state to force an update
-        _lastActiveWarnings = 0;
-        updateWarningDisplay();
-        _lastUpdateTime = millis();
-    }
+    updateWarningDisplay(event.activeWarnings, false);
 }
\ No newline at end of file
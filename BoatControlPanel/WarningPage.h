@@ -7,12 +7,13 @@
 class WarningPage : public BaseBoatPage
 {
 private:
-    uint32_t _lastActiveWarnings;      // Cache of last active warnings bitmap
-    unsigned long _lastUpdateTime;      // Timestamp of last display update
-    static const unsigned long UpdateIntervalMs = 10000; // 10 seconds
+    uint32_t _lastActiveWarnings;      // Bitmap currently shown on the display
     
-    // Shared function to update warning display
-    void updateWarningDisplay();
+    // Stream the warning list to the display, only if the bitmap differs or force is set
+    void updateWarningDisplay(uint32_t activeWarnings, bool force);
+
+    // EventBus handlers
+    void onWarningsChanged(const WarningsChangedEvent& event);
     
 public:
     WarningPage(Stream* serialPort,
@@ -24,7 +25,6 @@ public:
     void onEnterPage() override;
     void refresh(unsigned long now) override;
     void handleTouch(uint8_t compId, uint8_t eventType) override;
-    void handleExternalUpdate(uint8_t updateType, const void* data) override;
     
     uint8_t getPageId() const override { return PageWarning; }
 };
\ No newline at end of file
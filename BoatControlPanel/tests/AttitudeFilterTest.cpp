@@ -0,0 +1,154 @@
+//
+// Host test of the Mahony attitude filter against known rotations.
+//
+// Gyro and accelerometer samples are generated from a known roll/pitch
+// history (accelerometer reads +1 g on z when level, gyro in rad/s), so the
+// estimate can be compared with the truth: static tilt, a constant roll
+// rate, rolling in a seaway with sway accelerations on the accelerometer,
+// and a constant gyro bias.
+//
+
+#include "../AttitudeFilter.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+constexpr float DegToRad = 0.017453293f;
+constexpr float RadToDeg = 57.29578f;
+constexpr float TwoPi = 6.2831853f;
+
+// 25 Hz, the default compass sample rate
+constexpr float SampleDt = 0.04f;
+
+static int failures = 0;
+
+static void check(bool condition, const char* name, float value)
+{
+    printf("  %-52s %8.3f  %s\n", name, value, condition ? "ok" : "FAIL");
+
+    if (!condition)
+        failures++;
+}
+
+// Gravity in the body frame for a pitch and roll, as TLVCompass removes it
+static void gravity(float pitch, float roll, float& ax, float& ay, float& az)
+{
+    ax = -sinf(pitch);
+    ay = sinf(roll) * cosf(pitch);
+    az = cosf(roll) * cosf(pitch);
+}
+
+static void testStaticTilt()
+{
+    AttitudeFilter filter;
+    float ax, ay, az;
+    gravity(10 * DegToRad, -5 * DegToRad, ax, ay, az);
+
+    for (int i = 0; i < 25 * 5; i++)
+        filter.update(0, 0, 0, ax, ay, az, SampleDt);
+
+    check(fabsf(filter.getPitch() * RadToDeg - 10) < 0.1f, "static tilt: pitch error (deg)", filter.getPitch() * RadToDeg - 10);
+    check(fabsf(filter.getRoll() * RadToDeg + 5) < 0.1f, "static tilt: roll error (deg)", filter.getRoll() * RadToDeg + 5);
+}
+
+// Roll to 30 degrees at 10 degrees per second and hold
+static void testConstantRollRate()
+{
+    AttitudeFilter filter;
+    float roll = 0;
+    float worst = 0;
+    float ax, ay, az;
+
+    for (int i = 0; i < 25 * 5; i++)
+    {
+        float rate = roll < 30 * DegToRad ? 10 * DegToRad : 0;
+        roll += rate * SampleDt;
+
+        gravity(0, roll, ax, ay, az);
+        filter.update(rate, 0, 0, ax, ay, az, SampleDt);
+
+        float error = fabsf(filter.getRoll() - roll) * RadToDeg;
+        if (error > worst)
+            worst = error;
+    }
+
+    check(worst < 0.5f, "roll rate 10 deg/s: worst roll error (deg)", worst);
+    check(fabsf(filter.getPitch()) * RadToDeg < 0.1f, "roll rate 10 deg/s: pitch cross talk (deg)", filter.getPitch() * RadToDeg);
+}
+
+// +/-15 degrees of roll at 0.2 Hz with 0.15 g of sway on the accelerometer,
+// the gyro carries the roll where the accelerometer alone is thrown off
+static void testSeaway()
+{
+    AttitudeFilter filter;
+    float worstFilter = 0;
+    float worstAccel = 0;
+    float ax, ay, az;
+
+    const float amplitude = 15 * DegToRad;
+    const float omega = TwoPi * 0.2f;
+
+    for (int i = 0; i < 25 * 60; i++)
+    {
+        float t = i * SampleDt;
+        float roll = amplitude * sinf(omega * t);
+        float rate = amplitude * omega * cosf(omega * t);
+
+        gravity(0, roll, ax, ay, az);
+        ay += 0.15f * sinf(omega * t);
+
+        filter.update(rate, 0, 0, ax, ay, az, SampleDt);
+
+        // first 10 s let the filter settle from the disturbed start
+        if (t < 10)
+            continue;
+
+        float filterError = fabsf(filter.getRoll() - roll) * RadToDeg;
+        float accelError = fabsf(atan2f(ay, az) - roll) * RadToDeg;
+
+        if (filterError > worstFilter)
+            worstFilter = filterError;
+
+        if (accelError > worstAccel)
+            worstAccel = accelError;
+    }
+
+    printf("  seaway: accelerometer alone worst roll error %.2f deg\n", worstAccel);
+    check(worstFilter < 3.0f, "seaway: worst roll error (deg)", worstFilter);
+    check(worstFilter < worstAccel / 2, "seaway: error ratio to accel only", worstFilter / worstAccel);
+}
+
+// 1 deg/s gyro bias while level, the integral term learns it
+static void testGyroBias()
+{
+    AttitudeFilter filter;
+    float ax, ay, az;
+    gravity(0, 0, ax, ay, az);
+
+    const float bias = 1 * DegToRad;
+    float worst = 0;
+
+    for (int i = 0; i < 25 * 300; i++)
+    {
+        filter.update(bias, 0, 0, ax, ay, az, SampleDt);
+
+        float error = fabsf(filter.getRoll()) * RadToDeg;
+        if (error > worst)
+            worst = error;
+    }
+
+    check(worst < 3.0f, "gyro bias 1 deg/s: worst roll error (deg)", worst);
+    check(fabsf(filter.getRoll()) * RadToDeg < 0.2f, "gyro bias 1 deg/s: roll after 300 s (deg)", filter.getRoll() * RadToDeg);
+}
+
+int main()
+{
+    printf("AttitudeFilterTest\n");
+
+    testStaticTilt();
+    testConstantRollRate();
+    testSeaway();
+    testGyroBias();
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
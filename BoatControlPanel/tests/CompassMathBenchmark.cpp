@@ -0,0 +1,195 @@
+//
+// Host benchmark of the compass math backends (see CompassMath.h).
+//
+// Built once per backend by the Makefile (COMPASS_MATH=0/1/2). Each build
+// runs the per sample heading math of TLVCompass::processSample (pitch and
+// roll from the accelerometer, tilt compensation, normalise, atan2) over a
+// synthetic sweep of headings and tilts, and reports the time per update
+// and the heading error against the same pipeline in double with libm.
+// Host timings only rank the backends, they are not AVR cycle counts.
+//
+
+#include "../CompassMath.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCHMARK_HAS_TSC 1
+#else
+#define BENCHMARK_HAS_TSC 0
+#endif
+
+constexpr double DegToRad = 0.017453292519943295;
+constexpr double RadToDegD = 57.29577951308232;
+
+// Field in mT with a 65 degree inclination, tens of LSB as the sketch sees it
+constexpr double FieldHorizontal = 2.1;
+constexpr double FieldVertical = 4.5;
+
+constexpr int SampleCount = 3600;
+constexpr int Repeats = 200;
+
+struct Sample
+{
+    double bx, by, bz;
+    double ax, ay, az;
+};
+
+// Tolerances per backend, fixed point uses polynomial atan2/sin/cos and
+// the pitch and roll errors add to the heading error at full tilt
+#if COMPASS_MATH == COMPASS_MATH_FIXED
+constexpr double MaxErrorDegrees = 1.5;
+const char* BackendName = "fixed";
+#elif COMPASS_MATH == COMPASS_MATH_FLOAT
+constexpr double MaxErrorDegrees = 0.01;
+const char* BackendName = "float";
+#else
+constexpr double MaxErrorDegrees = 1e-9;
+const char* BackendName = "double";
+#endif
+
+static Sample samples[SampleCount];
+
+// Body frame field and gravity for a heading with the boat pitched and rolled
+static void makeSample(double headingDeg, double pitchDeg, double rollDeg, Sample& sample)
+{
+    double h = headingDeg * DegToRad;
+    double p = pitchDeg * DegToRad;
+    double r = rollDeg * DegToRad;
+
+    // Level body frame, x forward (north at heading 0), y to starboard, z down
+    double nx = FieldHorizontal * cos(h);
+    double ny = -FieldHorizontal * sin(h);
+    double nz = FieldVertical;
+
+    // Pitch about y, then roll about x
+    double x1 = nx * cos(p) - nz * sin(p);
+    double z1 = nx * sin(p) + nz * cos(p);
+    double y2 = ny * cos(r) + z1 * sin(r);
+    double z2 = -ny * sin(r) + z1 * cos(r);
+
+    sample.bx = x1;
+    sample.by = y2;
+    sample.bz = z2;
+    sample.ax = -sin(p);
+    sample.ay = sin(r) * cos(p);
+    sample.az = cos(r) * cos(p);
+}
+
+static double backendHeading(const Sample& sample)
+{
+    // CompassReal is a plain float/double or Fixed16, the benchmarked code
+    // is the backend the sketch is built with
+    CompassReal bx = sample.bx, by = sample.by, bz = sample.bz;
+    CompassReal ax = sample.ax, ay = sample.ay, az = sample.az;
+
+    CompassReal pitch = compassAtan2(-ax, compassSqrt(ay * ay + az * az));
+    CompassReal roll = compassAtan2(ay, az);
+
+    CompassReal sinPitch = compassSin(pitch);
+    CompassReal cosPitch = compassCos(pitch);
+    CompassReal sinRoll = compassSin(roll);
+    CompassReal cosRoll = compassCos(roll);
+
+    CompassReal east, north;
+    compassTiltCompensate(bx, by, bz, sinPitch, cosPitch, sinRoll, cosRoll, east, north);
+
+    CompassReal magnitude = compassSqrt(east * east + north * north);
+    east = east / magnitude;
+    north = north / magnitude;
+
+    CompassReal heading = compassAtan2(east, north) * CompassReal(RadToDegD);
+    if (heading < CompassReal(0))
+        heading += CompassReal(360);
+
+    return compassToDouble(heading);
+}
+
+static double referenceHeading(const Sample& sample)
+{
+    double pitch = atan2(-sample.ax, sqrt(sample.ay * sample.ay + sample.az * sample.az));
+    double roll = atan2(sample.ay, sample.az);
+
+    double east = sample.by * cos(pitch) - sample.bz * sin(pitch);
+    double north = sample.bx * cos(roll) + sample.by * sin(roll) * sin(pitch) + sample.bz * sin(roll) * cos(pitch);
+
+    double heading = atan2(east, north) * RadToDegD;
+    return heading < 0 ? heading + 360 : heading;
+}
+
+static double headingError(double a, double b)
+{
+    double delta = fabs(a - b);
+    return delta > 180 ? 360 - delta : delta;
+}
+
+int main()
+{
+#if COMPASS_MATH == COMPASS_MATH_FIXED
+    // Millisecond intervals beyond the Q16.16 range must saturate, not wrap
+    if (Fixed16(40000L).raw != INT32_MAX || Fixed16(-40000L).raw != INT32_MIN || Fixed16(1000L).raw != 1000L * 65536L)
+    {
+        printf("FAIL: Fixed16(long) does not saturate\n");
+        return EXIT_FAILURE;
+    }
+#endif
+
+    // Sweep the compass round ten times with up to +/-20 degrees of pitch and roll
+    for (int i = 0; i < SampleCount; i++)
+    {
+        double heading = (i * 360.0 * 10) / SampleCount;
+        while (heading >= 360)
+            heading -= 360;
+
+        makeSample(heading, 20 * sin(i * 0.013), 20 * sin(i * 0.021), samples[i]);
+    }
+
+    double maxError = 0;
+    double sumError = 0;
+
+    for (int i = 0; i < SampleCount; i++)
+    {
+        double error = headingError(backendHeading(samples[i]), referenceHeading(samples[i]));
+        sumError += error;
+
+        if (error > maxError)
+            maxError = error;
+    }
+
+    // Timed separately so the reference does not count
+    volatile double sink = 0;
+    auto start = std::chrono::steady_clock::now();
+#if BENCHMARK_HAS_TSC
+    unsigned long long startCycles = __rdtsc();
+#endif
+
+    for (int repeat = 0; repeat < Repeats; repeat++)
+    {
+        for (int i = 0; i < SampleCount; i++)
+            sink = sink + backendHeading(samples[i]);
+    }
+
+#if BENCHMARK_HAS_TSC
+    unsigned long long cycles = __rdtsc() - startCycles;
+#endif
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double updates = static_cast<double>(SampleCount) * Repeats;
+    double nanos = std::chrono::duration<double, std::nano>(elapsed).count() / updates;
+
+    printf("%-6s ns/update %7.1f", BackendName, nanos);
+#if BENCHMARK_HAS_TSC
+    printf("  cycles/update %7.1f", cycles / updates);
+#endif
+    printf("  error mean %.5f max %.5f deg\n", sumError / SampleCount, maxError);
+
+    if (maxError > MaxErrorDegrees)
+    {
+        printf("FAIL: %s heading error %.5f exceeds %.5f degrees\n", BackendName, maxError, MaxErrorDegrees);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
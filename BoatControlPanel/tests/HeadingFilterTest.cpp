@@ -0,0 +1,128 @@
+//
+// Host regression test for the heading filter wrapping at north.
+//
+// Steps and sweeps the heading across 359/0 degrees and checks the filtered
+// heading never swings through south, which the old moving average of
+// degrees did. Built once per COMPASS_MATH backend by the Makefile.
+//
+
+#include "../HeadingFilter.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+constexpr double DegToRad = 0.017453292519943295;
+
+// 25 Hz, the default compass sample rate of the sketch
+constexpr double SampleDt = 0.04;
+
+static int failures = 0;
+
+static void check(bool condition, const char* name, double value)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s (%.3f)\n", name, value);
+        failures++;
+    }
+}
+
+// Angular distance between two headings, 0..180
+static double angleBetween(double a, double b)
+{
+    double delta = fabs(a - b);
+    return delta > 180 ? 360 - delta : delta;
+}
+
+static double offNorth(double heading)
+{
+    return angleBetween(heading, 0);
+}
+
+static void feed(HeadingFilter& filter, double headingDeg)
+{
+    filter.update(CompassReal(sin(headingDeg * DegToRad)), CompassReal(cos(headingDeg * DegToRad)), CompassReal(SampleDt));
+}
+
+// Step from 350 to 10 degrees, the output turns the short way through north
+static void testStepAcrossNorth()
+{
+    HeadingFilter filter(500);
+    double worst = 0;
+
+    for (int i = 0; i < 50; i++)
+        feed(filter, 350);
+
+    for (int i = 0; i < 100; i++)
+    {
+        feed(filter, 10);
+        double off = offNorth(compassToDouble(filter.getHeading()));
+
+        if (off > worst)
+            worst = off;
+    }
+
+    check(worst <= 10.5, "step 350 -> 10 stays within 10 degrees of north", worst);
+    check(angleBetween(compassToDouble(filter.getHeading()), 10) < 0.5, "step 350 -> 10 settles on 10", compassToDouble(filter.getHeading()));
+}
+
+// Readings alternating 359 and 1 average to north, not south
+static void testJitterAtNorth()
+{
+    HeadingFilter filter(500);
+    double worst = 0;
+
+    for (int i = 0; i < 200; i++)
+    {
+        feed(filter, (i % 2) ? 1 : 359);
+        double off = offNorth(compassToDouble(filter.getHeading()));
+
+        if (off > worst)
+            worst = off;
+    }
+
+    check(worst <= 1.1, "359/1 jitter stays at north", worst);
+}
+
+// Slow turn to starboard through north and back, rate of turn keeps its sign
+static void testSweepThroughNorth()
+{
+    HeadingFilter filter(500);
+    double heading = 340;
+    double worst = 0;
+    bool rateSignOk = true;
+
+    for (int i = 0; i < 25 * 20; i++)
+    {
+        // 2 degrees per second to starboard for 20 s
+        heading += 2 * SampleDt;
+        if (heading >= 360)
+            heading -= 360;
+
+        feed(filter, heading);
+        double off = offNorth(compassToDouble(filter.getHeading()));
+
+        if (off > worst)
+            worst = off;
+
+        if (i > 25 * 5 && compassToDouble(filter.getRateOfTurn()) <= 0)
+            rateSignOk = false;
+    }
+
+    check(worst <= 21, "sweep 340 -> 20 never leaves the northern sector", worst);
+    check(rateSignOk, "rate of turn stays positive crossing north", compassToDouble(filter.getRateOfTurn()));
+    check(fabs(compassToDouble(filter.getRateOfTurn()) - 2) < 0.3, "rate of turn settles on 2 deg/s", compassToDouble(filter.getRateOfTurn()));
+}
+
+int main()
+{
+    testStepAcrossNorth();
+    testJitterAtNorth();
+    testSweepThroughNorth();
+
+    if (failures)
+        return EXIT_FAILURE;
+
+    printf("HeadingFilterTest (COMPASS_MATH=%d) passed\n", COMPASS_MATH);
+    return EXIT_SUCCESS;
+}
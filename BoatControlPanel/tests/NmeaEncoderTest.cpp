@@ -0,0 +1,150 @@
+//
+// Host test of the NMEA 0183 sentence encoder.
+//
+// Checks number formatting without printf float support (rounding into
+// the next whole number, no "-0.0"), headings wrapped to 0.0..359.9 so a
+// heading just under north is never sent as 360.0, and that every encoded
+// sentence carries a checksum the panel's own parser accepts.
+//
+
+#include "../NmeaEncoder.h"
+#include "../NmeaParser.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+static void check(bool condition, const char* name, const char* value)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s (%s)\n", name, value ? value : "null");
+        failures++;
+    }
+}
+
+static void checkSentence(const char* sentence, const char* expected)
+{
+    check(sentence && strcmp(sentence, expected) == 0, expected, sentence);
+}
+
+static const char* encodeFloat(NmeaEncoder& encoder, float value, uint8_t decimals)
+{
+    encoder.begin("XDR");
+    encoder.addFloat(value, decimals);
+    return encoder.finish();
+}
+
+// First field after the address, e.g. "12.3" from "$IIHDM,12.3,M*hh"
+static const char* firstField(const char* sentence, char* field, size_t size)
+{
+    const char* start = sentence ? strchr(sentence, ',') : nullptr;
+    const char* end = start ? strpbrk(start + 1, ",*") : nullptr;
+
+    if (!start || !end || end <= start)
+        return "";
+
+    size_t length = end - start - 1;
+    if (length >= size)
+        length = size - 1;
+
+    memcpy(field, start + 1, length);
+    field[length] = '\0';
+    return field;
+}
+
+static void checkFloat(float value, uint8_t decimals, const char* expected)
+{
+    NmeaEncoder encoder;
+    char field[16];
+    const char* text = firstField(encodeFloat(encoder, value, decimals), field, sizeof(field));
+    check(strcmp(text, expected) == 0, expected, text);
+}
+
+static void checkHeading(float heading, const char* expected)
+{
+    NmeaEncoder encoder;
+    char field[16];
+    const char* text = firstField(encoder.encodeHdm(heading), field, sizeof(field));
+    check(strcmp(text, expected) == 0, expected, text);
+}
+
+static void testNumbers()
+{
+    checkFloat(12.34f, 1, "12.3");
+    checkFloat(9.96f, 1, "10.0");
+    checkFloat(-3.25f, 2, "-3.25");
+    checkFloat(0.0f, 1, "0.0");
+    checkFloat(-0.01f, 1, "0.0");
+    checkFloat(-0.4f, 0, "0");
+    checkFloat(-0.06f, 1, "-0.1");
+    checkFloat(512.0f, 0, "512");
+    checkFloat(NAN, 1, "");
+}
+
+static void testHeadings()
+{
+    checkHeading(0.0f, "0.0");
+    checkHeading(123.44f, "123.4");
+    checkHeading(359.94f, "359.9");
+    checkHeading(359.96f, "0.0");
+    checkHeading(360.0f, "0.0");
+    checkHeading(-0.02f, "0.0");
+    checkHeading(-10.0f, "350.0");
+    checkHeading(370.0f, "10.0");
+}
+
+static void testSentences()
+{
+    NmeaEncoder encoder;
+    checkSentence(encoder.encodeHdm(359.96f), "$IIHDM,0.0,M*22\r\n");
+    checkSentence(encoder.encodeHdg(87.5f), "$IIHDG,87.5,,,,*73\r\n");
+
+    // The panel's parser verifies the checksum of anything it decodes, so
+    // a sentence it would accept proves the encoder's checksum
+    NmeaParser parser;
+    encoder.begin("RMC");
+    encoder.addText("120000.00");
+    encoder.addText("A");
+    encoder.addText("5047.50052");
+    encoder.addText("N");
+    encoder.addText("00105.99290");
+    encoder.addText("W");
+    encoder.addFloat(-0.01f, 1);
+    encoder.addFloat(158.75f, 2);
+    const char* sentence = encoder.finish();
+
+    NmeaSentence decoded = NmeaSentence::None;
+    for (const char* c = sentence; c && *c; c++)
+    {
+        NmeaSentence result = parser.feed(*c);
+
+        if (result != NmeaSentence::None)
+            decoded = result;
+    }
+
+    check(decoded == NmeaSentence::Rmc, "encoded RMC accepted by the parser", sentence);
+    check(parser.getFix().speedKnots == 0.0f && !signbit(parser.getFix().speedKnots), "speed decoded as 0.0", sentence);
+
+    // Longer than NMEA allows, dropped rather than truncated
+    encoder.begin("XDR");
+    for (int i = 0; i < 20; i++)
+        encoder.addText("COMPASS");
+    check(encoder.finish() == nullptr, "overlong sentence dropped", "");
+}
+
+int main()
+{
+    testNumbers();
+    testHeadings();
+    testSentences();
+
+    if (failures)
+        return EXIT_FAILURE;
+
+    printf("NmeaEncoderTest passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,296 @@
+//
+// Host test and throughput benchmark of the NMEA 0183 parser.
+//
+// Decodes known RMC, VTG and GGA sentences, checks corrupted, unterminated
+// and overlong sentences never change the fix, then replays the sentence
+// log in data/ (a five minute passage at 1 Hz as a multi constellation
+// receiver emits it, with GSA/GSV/GLL the parser skips and a short loss of
+// fix) clean, with bytes corrupted, and repeatedly for the time per byte.
+// Host timings only show the cost relative to the byte rate, they are not
+// AVR cycle counts.
+//
+
+#include "../NmeaParser.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCHMARK_HAS_TSC 1
+#else
+#define BENCHMARK_HAS_TSC 0
+#endif
+
+constexpr const char* DefaultLogPath = "data/SolentPassage.nmea";
+
+// Supported and skipped sentences in the log, one of each per second
+constexpr uint32_t LogSentences = 900;
+constexpr uint32_t LogSkipped = 1200;
+constexpr uint32_t LogNoFixRmc = 12;
+
+// Last RMC of the log, 5047.50052N 00105.99290W
+constexpr int32_t LogLastLatitudeE7 = 507916753;
+constexpr int32_t LogLastLongitudeE7 = -10998816;
+
+constexpr int Repeats = 200;
+
+static int failures = 0;
+
+static void check(bool condition, const char* name, double value)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s (%.3f)\n", name, value);
+        failures++;
+    }
+}
+
+static bool near(float value, float expected)
+{
+    return fabsf(value - expected) < 0.001f;
+}
+
+static NmeaSentence feedText(NmeaParser& parser, const char* text)
+{
+    NmeaSentence last = NmeaSentence::None;
+
+    for (const char* c = text; *c; c++)
+    {
+        NmeaSentence sentence = parser.feed(*c);
+
+        if (sentence != NmeaSentence::None)
+            last = sentence;
+    }
+
+    return last;
+}
+
+// Wraps a sentence body in $ and a valid checksum
+static NmeaSentence feedBody(NmeaParser& parser, const char* body)
+{
+    uint8_t checksum = 0;
+
+    for (const char* c = body; *c; c++)
+        checksum ^= static_cast<uint8_t>(*c);
+
+    char sentence[128];
+    snprintf(sentence, sizeof(sentence), "$%s*%02X\r\n", body, checksum);
+    return feedText(parser, sentence);
+}
+
+static void testKnownSentences()
+{
+    NmeaParser parser;
+
+    NmeaSentence sentence = feedText(parser, "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n");
+    const NmeaFix& fix = parser.getFix();
+
+    check(sentence == NmeaSentence::Rmc, "RMC decoded", static_cast<int>(sentence));
+    check(fix.valid, "RMC status A is valid", fix.valid);
+    check(fix.latitudeE7 == 481173000L, "RMC latitude", fix.latitudeE7);
+    check(fix.longitudeE7 == 115166666L, "RMC longitude", fix.longitudeE7);
+    check(near(fix.speedKnots, 22.4f), "RMC speed", fix.speedKnots);
+    check(near(fix.courseDegrees, 84.4f), "RMC course", fix.courseDegrees);
+
+    sentence = feedText(parser, "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n");
+    check(sentence == NmeaSentence::Vtg, "VTG decoded", static_cast<int>(sentence));
+    check(near(fix.speedKnots, 5.5f), "VTG speed", fix.speedKnots);
+    check(near(fix.courseDegrees, 54.7f), "VTG course", fix.courseDegrees);
+    check(fix.latitudeE7 == 481173000L, "VTG keeps the position", fix.latitudeE7);
+
+    sentence = feedText(parser, "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n");
+    check(sentence == NmeaSentence::Gga, "GGA decoded", static_cast<int>(sentence));
+    check(fix.quality == 1, "GGA quality", fix.quality);
+    check(fix.satellites == 8, "GGA satellites", fix.satellites);
+
+    // South and west are negative, any talker is accepted
+    sentence = feedBody(parser, "GNRMC,081836,A,3751.65,S,14507.36,W,000.0,360.0,130998,011.3,E");
+    check(sentence == NmeaSentence::Rmc, "GN talker decoded", static_cast<int>(sentence));
+    check(fix.latitudeE7 == -378608333L, "south latitude", fix.latitudeE7);
+    check(fix.longitudeE7 == -1451226666L, "west longitude", fix.longitudeE7);
+
+    // Empty speed and course clear them, position is kept
+    feedBody(parser, "GNRMC,081837,A,3751.65,S,14507.36,W,,,130998,,,A");
+    check(isnan(fix.speedKnots), "empty speed is NAN", fix.speedKnots);
+    check(isnan(fix.courseDegrees), "empty course is NAN", fix.courseDegrees);
+
+    feedBody(parser, "GNRMC,081838,V,,,,,,,130998,,,N");
+    check(!fix.valid, "RMC status V is not valid", fix.valid);
+    check(fix.latitudeE7 == -378608333L, "no fix keeps the last position", fix.latitudeE7);
+}
+
+static void testRejectedSentences()
+{
+    NmeaParser parser;
+    feedText(parser, "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n");
+    const NmeaFix& fix = parser.getFix();
+
+    // One digit of the speed changed, checksum no longer matches
+    NmeaSentence sentence = feedText(parser, "$GPRMC,123520,A,4807.038,N,01131.000,E,092.4,084.4,230394,003.1,W*6A\r\n");
+    check(sentence == NmeaSentence::None, "bad checksum rejected", static_cast<int>(sentence));
+    check(near(fix.speedKnots, 22.4f), "bad checksum keeps the fix", fix.speedKnots);
+    check(parser.getChecksumErrorCount() == 1, "checksum error counted", parser.getChecksumErrorCount());
+
+    sentence = feedText(parser, "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K\r\n");
+    check(sentence == NmeaSentence::None, "missing checksum rejected", static_cast<int>(sentence));
+    check(near(fix.speedKnots, 22.4f), "missing checksum keeps the fix", fix.speedKnots);
+
+    // A sentence cut off by a new $ is dropped and the new one decoded
+    sentence = feedText(parser, "$GPVTG,054.7,T,034.4,M,0$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n");
+    check(sentence == NmeaSentence::Vtg, "resynchronised on $", static_cast<int>(sentence));
+    check(near(fix.speedKnots, 5.5f), "resynchronised sentence decoded", fix.speedKnots);
+
+    std::string overlong = "$GPRMC,123519,A,4807.038,N,01131.000,E,001.0,084.4,230394,003.1,W";
+    overlong.append(NmeaMaxSentenceLength, '0');
+    overlong += "*00\r\n";
+    sentence = feedText(parser, overlong.c_str());
+    check(sentence == NmeaSentence::None, "overlong sentence rejected", static_cast<int>(sentence));
+    check(near(fix.speedKnots, 5.5f), "overlong sentence keeps the fix", fix.speedKnots);
+
+    uint32_t ignored = parser.getIgnoredCount();
+    sentence = feedText(parser, "$GPGSV,3,1,10,05,41,289,38,13,62,092,42,15,30,054,36,18,22,312,31*7B\r\n");
+    check(sentence == NmeaSentence::None, "GSV skipped", static_cast<int>(sentence));
+    check(parser.getIgnoredCount() == ignored + 1, "GSV counted as ignored", parser.getIgnoredCount());
+}
+
+static bool loadLog(const char* path, std::string& log)
+{
+    FILE* file = fopen(path, "rb");
+
+    if (!file)
+        return false;
+
+    char buffer[4096];
+    size_t read;
+
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        log.append(buffer, read);
+
+    fclose(file);
+    return true;
+}
+
+static void testLogReplay(const std::string& log)
+{
+    NmeaParser parser;
+    uint32_t noFix = 0;
+
+    for (char c : log)
+    {
+        if (parser.feed(c) == NmeaSentence::Rmc && !parser.getFix().valid)
+            noFix++;
+    }
+
+    const NmeaFix& fix = parser.getFix();
+
+    check(parser.getSentenceCount() == LogSentences, "log sentences decoded", parser.getSentenceCount());
+    check(parser.getChecksumErrorCount() == 0, "log checksum errors", parser.getChecksumErrorCount());
+    check(parser.getIgnoredCount() == LogSkipped, "log sentences skipped", parser.getIgnoredCount());
+    check(noFix == LogNoFixRmc, "log RMC without a fix", noFix);
+    check(fix.valid, "log ends with a fix", fix.valid);
+    check(fix.latitudeE7 == LogLastLatitudeE7, "log last latitude", fix.latitudeE7);
+    check(fix.longitudeE7 == LogLastLongitudeE7, "log last longitude", fix.longitudeE7);
+}
+
+static void testCorruptedReplay(const std::string& log)
+{
+    // Change one digit in every fifth supported sentence, as a noisy line would
+    std::string corrupted = log;
+    uint32_t supported = 0;
+    uint32_t damaged = 0;
+    size_t start = 0;
+
+    while ((start = corrupted.find('$', start)) != std::string::npos)
+    {
+        size_t end = corrupted.find('*', start);
+        const char* type = corrupted.c_str() + start + 3;
+        bool isSupported = strncmp(type, "RMC", 3) == 0 || strncmp(type, "VTG", 3) == 0 || strncmp(type, "GGA", 3) == 0;
+
+        if (isSupported && supported++ % 5 == 0)
+        {
+            for (size_t i = start + 7; i < end; i++)
+            {
+                if (corrupted[i] >= '0' && corrupted[i] <= '9')
+                {
+                    corrupted[i] = corrupted[i] == '9' ? '0' : corrupted[i] + 1;
+                    damaged++;
+                    break;
+                }
+            }
+        }
+
+        start = end;
+    }
+
+    NmeaParser parser;
+
+    for (char c : corrupted)
+        parser.feed(c);
+
+    check(damaged > 0, "corrupted sentences in the log", damaged);
+    check(parser.getChecksumErrorCount() == damaged, "corrupted sentences rejected", parser.getChecksumErrorCount());
+    check(parser.getSentenceCount() == LogSentences - damaged, "clean sentences decoded", parser.getSentenceCount());
+}
+
+static void benchmark(const std::string& log)
+{
+    NmeaParser parser;
+    uint32_t decoded = 0;
+
+    auto start = std::chrono::steady_clock::now();
+#if BENCHMARK_HAS_TSC
+    unsigned long long startCycles = __rdtsc();
+#endif
+
+    for (int repeat = 0; repeat < Repeats; repeat++)
+    {
+        for (char c : log)
+        {
+            if (parser.feed(c) != NmeaSentence::None)
+                decoded++;
+        }
+    }
+
+#if BENCHMARK_HAS_TSC
+    double cycles = static_cast<double>(__rdtsc() - startCycles);
+#endif
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double bytes = static_cast<double>(log.size()) * Repeats;
+
+    printf("NmeaParser ns/byte %6.2f", std::chrono::duration<double, std::nano>(elapsed).count() / bytes);
+#if BENCHMARK_HAS_TSC
+    printf("  cycles/byte %6.2f", cycles / bytes);
+#endif
+    printf("  sentences %u of %u\n", static_cast<unsigned>(decoded), static_cast<unsigned>(LogSentences * Repeats));
+
+    check(decoded == LogSentences * Repeats, "benchmark sentences decoded", decoded);
+}
+
+int main(int argc, char** argv)
+{
+    const char* path = argc > 1 ? argv[1] : DefaultLogPath;
+    std::string log;
+
+    if (!loadLog(path, log))
+    {
+        printf("FAIL: cannot read %s\n", path);
+        return EXIT_FAILURE;
+    }
+
+    testKnownSentences();
+    testRejectedSentences();
+    testLogReplay(log);
+    testCorruptedReplay(log);
+    benchmark(log);
+
+    if (failures)
+        return EXIT_FAILURE;
+
+    printf("NmeaParserTest passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+#include "BatteryMonitor.h"
+
+// analogRead() resolution left at the core default, the water sensor shares the ADC
+constexpr uint8_t BatteryAdcBits = 10;
+constexpr float BatteryAdcReferenceVolts = 5.0f;
+
+// Config stores the divider ratio and thresholds as integers
+constexpr float BatteryDividerScale = 1000.0f;
+constexpr float BatteryMillivoltScale = 1000.0f;
+
+// 4^6 conversions already takes several seconds at the task rate
+constexpr uint8_t BatteryMaxExtraBits = 6;
+
+BatteryMonitor::BatteryMonitor(uint8_t sensePin, uint8_t extraBits)
+	: _sensePin(sensePin),
+	  _extraBits(extraBits > BatteryMaxExtraBits ? BatteryMaxExtraBits : extraBits),
+	  _samplesPerReading(1U << (2 * _extraBits)),
+	  _samplesTaken(0), _sampleSum(0), _rawValue(0),
+	  _dividerRatio(DefaultBatteryDivider / BatteryDividerScale),
+	  _lowVolts(DefaultBatteryLowMv / BatteryMillivoltScale),
+	  _recoverVolts(DefaultBatteryRecoverMv / BatteryMillivoltScale),
+	  _low(false)
+{
+}
+
+void BatteryMonitor::begin()
+{
+	pinMode(_sensePin, INPUT);
+
+	_samplesTaken = 0;
+	_sampleSum = 0;
+	_readings.clear();
+	_low = false;
+}
+
+void BatteryMonitor::configUpdated(const Config* config)
+{
+	if (config == nullptr)
+		return;
+
+	_dividerRatio = config->batteryDivider / BatteryDividerScale;
+	_lowVolts = config->batteryLowMv / BatteryMillivoltScale;
+	_recoverVolts = config->batteryRecoverMv / BatteryMillivoltScale;
+
+	// readings scaled with the old ratio would skew the average
+	_readings.clear();
+}
+
+float BatteryMonitor::countsToVolts(uint16_t counts) const
+{
+	uint32_t fullScale = 1UL << (BatteryAdcBits + _extraBits);
+	return counts * (BatteryAdcReferenceVolts / fullScale) * _dividerRatio;
+}
+
+float BatteryMonitor::getVoltage() const
+{
+	return _readings.count() > 0 ? _readings.mean() : NAN;
+}
+
+bool BatteryMonitor::update()
+{
+	_sampleSum += analogRead(_sensePin);
+	_samplesTaken++;
+
+	if (_samplesTaken < _samplesPerReading)
+		return false;
+
+	// decimate, 4^n samples shifted by n keeps n bits of the averaged noise
+	_rawValue = (uint16_t)(_sampleSum >> _extraBits);
+	_samplesTaken = 0;
+	_sampleSum = 0;
+
+	_readings.push(countsToVolts(_rawValue));
+
+	// no decision until the window is full, one noisy reading at power up is not a flat battery
+	if (!_readings.isFull())
+		return true;
+
+	float average = _readings.mean();
+
+	if (!_low && average < _lowVolts)
+		_low = true;
+	else if (_low && average > _recoverVolts)
+		_low = false;
+
+	return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <RingStats.h>
+#include "Config.h"
+
+// Decimated readings in the running average
+constexpr uint8_t BatteryAverageReadings = 8;
+
+// Supply voltage measured through a resistor divider on an analog pin.
+// One conversion is taken per update() so sampling is spread over many loop
+// passes. 4^n conversions are summed and shifted right by n, which with the
+// ADC noise as dither gives n extra effective bits over the 10 bit reading.
+// Decimated readings feed a running average, and the low battery state
+// only changes when the average crosses the low or recover threshold, so a
+// voltage sitting on a threshold does not flap the warning.
+class BatteryMonitor
+{
+private:
+	uint8_t _sensePin;
+	uint8_t _extraBits;
+	uint16_t _samplesPerReading;
+
+	uint16_t _samplesTaken;
+	uint32_t _sampleSum;
+	uint16_t _rawValue;
+
+	float _dividerRatio;
+	float _lowVolts;
+	float _recoverVolts;
+
+	RingStats<float, BatteryAverageReadings> _readings;
+	bool _low;
+
+	float countsToVolts(uint16_t counts) const;
+
+public:
+	BatteryMonitor(uint8_t sensePin, uint8_t extraBits = 3);
+
+	void begin();
+
+	// Picks up divider ratio and thresholds
+	void configUpdated(const Config* config);
+
+	// Takes one conversion, returns true when a new decimated reading is available
+	bool update();
+
+	// Running average in volts, NAN until the first reading
+	float getVoltage() const;
+
+	// Last decimated reading in ADC counts (10 + extra bits)
+	uint16_t getRawValue() const { return _rawValue; }
+
+	bool isLow() const { return _low; }
+	uint8_t getReadingCount() const { return _readings.count(); }
+};
@@ -13,17 +13,29 @@ enum class VesselType : uint8_t {
     Yacht = 0x03,                   // Yacht
 };
 
+// Battery sense defaults, 47k over 10k divider (5.7) reads up to 28.5V
+constexpr uint16_t DefaultBatteryDivider = 5700;
+constexpr uint16_t DefaultBatteryLowMv = 11800;
+constexpr uint16_t DefaultBatteryRecoverMv = 12400;
+
+// Relay trip current in tenths of an amp, 0 disables the trip
+constexpr uint16_t DefaultRelayCurrentLimit = 150;
+
 //
 // Layout:
 // - version (uint8_t)
 // - vesselType (VesselType)
 // - hornRelayIndex (uint8_t) 0..7 or 0xFF = none
 // - soundStartDelayMs (uint16_t)
+// - batteryDivider (uint16_t) divider ratio * 1000
+// - batteryLowMv (uint16_t) low battery warning below this
+// - batteryRecoverMv (uint16_t) warning cleared above this
+// - relayCurrentLimit (uint16_t[8]) trip current per relay, amps * 10, 0 = no trip
 // - checksum (uint16_t)
 //
 // Keep struct packed and stable. Increase 'VERSION' when you change layout.
 // Packed POD for persistent configuration.
-constexpr uint8_t ConfigVersion = 3;
+constexpr uint8_t ConfigVersion = 5;
 constexpr uint8_t ConfigRelayCount = 8;
 
 struct Config {
@@ -31,5 +43,9 @@ struct Config {
     VesselType vesselType;
     uint8_t hornRelayIndex; // 0..7 or 0xFF = none
     uint16_t soundStartDelayMs;
+    uint16_t batteryDivider;
+    uint16_t batteryLowMv;
+    uint16_t batteryRecoverMv;
+    uint16_t relayCurrentLimit[ConfigRelayCount];
     uint16_t checksum;
 } __attribute__((packed));
@@ -6,9 +6,21 @@ constexpr char ConfigResetSettings[] = "C2";
 constexpr char ConfigBoatType[] = "C7";
 constexpr char ConfigSoundRelayId[] = "C8";
 constexpr char ConfigSoundStartDelay[] = "C9";
+constexpr char ConfigBattery[] = "C12";
+constexpr char ConfigCurrentLimits[] = "C13";
 
-ConfigCommandHandler::ConfigCommandHandler(SoundManager* soundManager)
-    : _soundManager(soundManager)
+// Accepted battery settings, ratio * 1000 and millivolts
+constexpr uint16_t BatteryDividerMin = 1000;
+constexpr uint16_t BatteryDividerMax = 20000;
+constexpr uint16_t BatteryThresholdMinMv = 1000;
+constexpr uint16_t BatteryThresholdMaxMv = 30000;
+
+// Relay trip current, amps * 10, the 20A hall sensors saturate above this
+constexpr uint16_t CurrentLimitMax = 200;
+
+ConfigCommandHandler::ConfigCommandHandler(SoundManager* soundManager, BatteryMonitor* batteryMonitor,
+    CurrentMonitor* currentMonitor)
+    : _soundManager(soundManager), _batteryMonitor(batteryMonitor), _currentMonitor(currentMonitor)
 {
 }
 
@@ -74,6 +86,12 @@ bool ConfigCommandHandler::handleCommand(SerialCommandManager* sender, const Str
         // C9 Sound start delay
         sender->sendCommand(ConfigSoundStartDelay, String(config->soundStartDelayMs));
 
+        // C12 Battery divider and thresholds
+        sendBattery(sender, ConfigBattery, config);
+
+        // C13 Relay current limits
+        sendCurrentLimits(sender, ConfigCurrentLimits, config);
+
         sendAckOk(sender, cmd);
     }
     else if (cmd == ConfigBoatType)
@@ -116,10 +134,25 @@ bool ConfigCommandHandler::handleCommand(SerialCommandManager* sender, const Str
             sendAckErr(sender, cmd, F("Invalid parameters"));
         }
     }
+    else if (cmd == ConfigBattery)
+    {
+        handleBattery(sender, cmd, config, params, paramCount);
+    }
+    else if (cmd == ConfigCurrentLimits)
+    {
+        handleCurrentLimits(sender, cmd, config, params, paramCount);
+    }
     else if (cmd == ConfigResetSettings)
     {
         // Reset to defaults
         ConfigManager::resetToDefaults();
+
+        if (_batteryMonitor != nullptr)
+            _batteryMonitor->configUpdated(ConfigManager::getConfigPtr());
+
+        if (_currentMonitor != nullptr)
+            _currentMonitor->configUpdated(ConfigManager::getConfigPtr());
+
         sendAckOk(sender, cmd);
     }
     else
@@ -133,7 +166,7 @@ bool ConfigCommandHandler::handleCommand(SerialCommandManager* sender, const Str
 const String* ConfigCommandHandler::supportedCommands(size_t& count) const
 {
     static const String cmds[] = { ConfigSaveSettings, ConfigGetSettings, 
-        ConfigResetSettings, ConfigBoatType, ConfigSoundRelayId, ConfigSoundStartDelay };
+        ConfigResetSettings, ConfigBoatType, ConfigSoundRelayId, ConfigSoundStartDelay, ConfigBattery, ConfigCurrentLimits };
     count = sizeof(cmds) / sizeof(cmds[0]);
     return cmds;
 }
@@ -144,4 +177,141 @@ void ConfigCommandHandler::updateSoundManagerConfig(Config* config)
     {
         _soundManager->configUpdated(config);
     }
-}
\ No newline at end of file
+}
+
+void ConfigCommandHandler::handleBattery(SerialCommandManager* sender, const String& cmd, Config* config, const StringKeyValue params[], int paramCount)
+{
+    // no params reports the current settings
+    if (paramCount == 0)
+    {
+        sendBattery(sender, cmd, config);
+        sendAckOk(sender, cmd);
+        return;
+    }
+
+    uint16_t divider = config->batteryDivider;
+    uint16_t lowMv = config->batteryLowMv;
+    uint16_t recoverMv = config->batteryRecoverMv;
+
+    for (int i = 0; i < paramCount; i++)
+    {
+        String key = params[i].key;
+        key.trim();
+        long value = params[i].value.toInt();
+
+        if (key == "d")
+        {
+            if (value < BatteryDividerMin || value > BatteryDividerMax)
+            {
+                sendAckErr(sender, cmd, F("Invalid divider"), &params[i]);
+                return;
+            }
+
+            divider = static_cast<uint16_t>(value);
+        }
+        else if (key == "l" || key == "h")
+        {
+            if (value < BatteryThresholdMinMv || value > BatteryThresholdMaxMv)
+            {
+                sendAckErr(sender, cmd, F("Invalid threshold"), &params[i]);
+                return;
+            }
+
+            if (key == "l")
+                lowMv = static_cast<uint16_t>(value);
+            else
+                recoverMv = static_cast<uint16_t>(value);
+        }
+        else
+        {
+            sendAckErr(sender, cmd, F("Unknown param"), &params[i]);
+            return;
+        }
+    }
+
+    // the gap between the thresholds is the hysteresis
+    if (recoverMv <= lowMv)
+    {
+        sendAckErr(sender, cmd, F("Recover must be above low"));
+        return;
+    }
+
+    config->batteryDivider = divider;
+    config->batteryLowMv = lowMv;
+    config->batteryRecoverMv = recoverMv;
+
+    if (_batteryMonitor != nullptr)
+        _batteryMonitor->configUpdated(config);
+
+    sendBattery(sender, cmd, config);
+    sendAckOk(sender, cmd);
+}
+
+void ConfigCommandHandler::sendBattery(SerialCommandManager* sender, const String& cmd, const Config* config)
+{
+    StringKeyValue params[] = {
+        { F("d"), String(config->batteryDivider) },
+        { F("l"), String(config->batteryLowMv) },
+        { F("h"), String(config->batteryRecoverMv) }
+    };
+
+    sender->sendCommand(cmd, "", "", params, sizeof(params) / sizeof(params[0]));
+}
+
+void ConfigCommandHandler::handleCurrentLimits(SerialCommandManager* sender, const String& cmd, Config* config, const StringKeyValue params[], int paramCount)
+{
+    // no params reports the current settings
+    if (paramCount == 0)
+    {
+        sendCurrentLimits(sender, cmd, config);
+        sendAckOk(sender, cmd);
+        return;
+    }
+
+    uint16_t limits[ConfigRelayCount];
+    memcpy(limits, config->relayCurrentLimit, sizeof(limits));
+
+    // <relay>=<amps>, all validated before any is applied
+    for (int i = 0; i < paramCount; i++)
+    {
+        String key = params[i].key;
+        key.trim();
+
+        if (key.length() != 1 || !isDigit(key[0]) || key[0] - '0' >= ConfigRelayCount)
+        {
+            sendAckErr(sender, cmd, F("Relay out of range"), &params[i]);
+            return;
+        }
+
+        long limit = lroundf(params[i].value.toFloat() * 10);
+
+        if (limit < 0 || limit > CurrentLimitMax)
+        {
+            sendAckErr(sender, cmd, F("Invalid limit"), &params[i]);
+            return;
+        }
+
+        limits[key[0] - '0'] = static_cast<uint16_t>(limit);
+    }
+
+    memcpy(config->relayCurrentLimit, limits, sizeof(limits));
+
+    if (_currentMonitor != nullptr)
+        _currentMonitor->configUpdated(config);
+
+    sendCurrentLimits(sender, cmd, config);
+    sendAckOk(sender, cmd);
+}
+
+void ConfigCommandHandler::sendCurrentLimits(SerialCommandManager* sender, const String& cmd, const Config* config)
+{
+    StringKeyValue params[ConfigRelayCount];
+
+    for (uint8_t i = 0; i < ConfigRelayCount; i++)
+    {
+        params[i].key = String(i);
+        params[i].value = String(config->relayCurrentLimit[i] / 10.0f, 1);
+    }
+
+    sender->sendCommand(cmd, "", "", params, ConfigRelayCount);
+}
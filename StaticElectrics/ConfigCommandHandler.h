@@ -6,16 +6,25 @@
 #include "ConfigManager.h"
 #include "BaseCommandHandler.h"
 #include "SoundManager.h"
+#include "BatteryMonitor.h"
+#include "CurrentMonitor.h"
 
 class ConfigCommandHandler : public BaseCommandHandler
 {
 private:
 	SoundManager* _soundManager;
+	BatteryMonitor* _batteryMonitor;
+	CurrentMonitor* _currentMonitor;
 
 	void updateSoundManagerConfig(Config* config);
+	void handleBattery(SerialCommandManager* sender, const String& cmd, Config* config, const StringKeyValue params[], int paramCount);
+	void sendBattery(SerialCommandManager* sender, const String& cmd, const Config* config);
+	void handleCurrentLimits(SerialCommandManager* sender, const String& cmd, Config* config, const StringKeyValue params[], int paramCount);
+	void sendCurrentLimits(SerialCommandManager* sender, const String& cmd, const Config* config);
 public:
 	// Constructor: pass the HomePage pointer so we can notify UI when saved/updated
-	explicit ConfigCommandHandler(SoundManager* soundManager);
+	explicit ConfigCommandHandler(SoundManager* soundManager, BatteryMonitor* batteryMonitor = nullptr,
+		CurrentMonitor* currentMonitor = nullptr);
 
 	bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
 	const String* supportedCommands(size_t& count) const override;
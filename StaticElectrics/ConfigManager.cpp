@@ -79,6 +79,13 @@ void ConfigManager::resetToDefaults()
     _cfg.hornRelayIndex = 0xFF; // none
 	_cfg.soundStartDelayMs = 300; // 300ms delay to avoid relay/horn clipping
 
+    _cfg.batteryDivider = DefaultBatteryDivider;
+    _cfg.batteryLowMv = DefaultBatteryLowMv;
+    _cfg.batteryRecoverMv = DefaultBatteryRecoverMv;
+
+    for (uint8_t i = 0; i < ConfigRelayCount; i++)
+        _cfg.relayCurrentLimit[i] = DefaultRelayCurrentLimit;
+
     // compute checksum
     _cfg.checksum = 0;
     _cfg.checksum = calcChecksum(_cfg);
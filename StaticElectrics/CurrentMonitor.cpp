@@ -0,0 +1,184 @@
+#include "CurrentMonitor.h"
+#include <SPI.h>
+#include <math.h>
+
+// MCP3208, 12 bit, referenced to the 5V supply the sensors run from
+constexpr uint32_t CurrentAdcClockHz = 1000000;
+constexpr float CurrentAdcFullScale = 4096.0f;
+constexpr float CurrentAdcReferenceMv = 5000.0f;
+
+// ACS712-20A output, mV per amp
+constexpr float CurrentSensorMvPerAmp = 100.0f;
+
+// Samples averaged per channel for the zero offset
+constexpr uint8_t CurrentZeroSamples = 16;
+
+// Config stores limits in tenths of an amp
+constexpr float CurrentLimitScale = 10.0f;
+
+CurrentMonitor::CurrentMonitor(uint8_t csPin, uint8_t channelCount, uint8_t channelsPerUpdate)
+	: _csPin(csPin),
+	  _channelCount(channelCount > CurrentMaxChannels ? CurrentMaxChannels : channelCount),
+	  _channelsPerUpdate(channelsPerUpdate > 0 ? channelsPerUpdate : 1),
+	  _nextChannel(0)
+{
+	memset(_channels, 0, sizeof(_channels));
+}
+
+void CurrentMonitor::begin()
+{
+	pinMode(_csPin, OUTPUT);
+	digitalWrite(_csPin, HIGH);
+	SPI.begin();
+
+	for (uint8_t i = 0; i < _channelCount; i++)
+	{
+		uint32_t sum = 0;
+
+		for (uint8_t s = 0; s < CurrentZeroSamples; s++)
+			sum += readChannel(i);
+
+		_channels[i].zeroCounts = (uint16_t)((sum + CurrentZeroSamples / 2) / CurrentZeroSamples);
+		_channels[i].overCount = 0;
+	}
+
+	resetWindow();
+}
+
+void CurrentMonitor::configUpdated(const Config* config)
+{
+	if (config == nullptr)
+		return;
+
+	for (uint8_t i = 0; i < _channelCount && i < ConfigRelayCount; i++)
+	{
+		_channels[i].limitAmps = config->relayCurrentLimit[i] / CurrentLimitScale;
+		_channels[i].overCount = 0;
+	}
+}
+
+uint16_t CurrentMonitor::readChannel(uint8_t channel)
+{
+	// start bit, single ended, then the 3 bit channel straddling the first two bytes
+	uint8_t command = 0x06 | (channel >> 2);
+	uint8_t select = (channel & 0x03) << 6;
+
+	SPI.beginTransaction(SPISettings(CurrentAdcClockHz, MSBFIRST, SPI_MODE0));
+	digitalWrite(_csPin, LOW);
+
+	SPI.transfer(command);
+	uint8_t high = SPI.transfer(select);
+	uint8_t low = SPI.transfer(0x00);
+
+	digitalWrite(_csPin, HIGH);
+	SPI.endTransaction();
+
+	return ((uint16_t)(high & 0x0F) << 8) | low;
+}
+
+float CurrentMonitor::countsToAmps(uint8_t channel, uint16_t counts) const
+{
+	float mv = ((int16_t)counts - (int16_t)_channels[channel].zeroCounts) * (CurrentAdcReferenceMv / CurrentAdcFullScale);
+	return mv / CurrentSensorMvPerAmp;
+}
+
+uint8_t CurrentMonitor::update(unsigned long now)
+{
+	uint8_t tripped = 0;
+
+	for (uint8_t n = 0; n < _channelsPerUpdate && n < _channelCount; n++)
+	{
+		uint8_t i = _nextChannel;
+		_nextChannel = (_nextChannel + 1) % _channelCount;
+
+		CurrentChannel& channel = _channels[i];
+		float amps = countsToAmps(i, readChannel(i));
+
+		channel.lastAmps = amps;
+		channel.sumAmps += amps;
+		channel.sumSquares += amps * amps;
+		channel.samples++;
+
+		float magnitude = fabsf(amps);
+
+		if (magnitude > channel.peakAmps)
+			channel.peakAmps = magnitude;
+
+		if (channel.blanking && (long)(now - channel.blankUntil) >= 0)
+			channel.blanking = false;
+
+		// sensors are bidirectional, a load wired backwards still trips
+		if (!channel.blanking && channel.limitAmps > 0 && magnitude > channel.limitAmps)
+		{
+			if (channel.overCount < CurrentTripSamples)
+				channel.overCount++;
+		}
+		else
+		{
+			channel.overCount = 0;
+		}
+
+		if (channel.overCount >= CurrentTripSamples)
+			tripped |= (1 << i);
+	}
+
+	return tripped;
+}
+
+void CurrentMonitor::clearTrip(uint8_t channel)
+{
+	if (channel < _channelCount)
+		_channels[channel].overCount = 0;
+}
+
+void CurrentMonitor::blankInrush(uint8_t channel, unsigned long now)
+{
+	if (channel >= _channelCount)
+		return;
+
+	_channels[channel].overCount = 0;
+	_channels[channel].blanking = true;
+	_channels[channel].blankUntil = now + CurrentInrushBlankMs;
+}
+
+float CurrentMonitor::getLastAmps(uint8_t channel) const
+{
+	return channel < _channelCount ? _channels[channel].lastAmps : 0;
+}
+
+float CurrentMonitor::getAverageAmps(uint8_t channel) const
+{
+	if (channel >= _channelCount || _channels[channel].samples == 0)
+		return 0;
+
+	return _channels[channel].sumAmps / _channels[channel].samples;
+}
+
+float CurrentMonitor::getRmsAmps(uint8_t channel) const
+{
+	if (channel >= _channelCount || _channels[channel].samples == 0)
+		return 0;
+
+	return sqrtf(_channels[channel].sumSquares / _channels[channel].samples);
+}
+
+float CurrentMonitor::getPeakAmps(uint8_t channel) const
+{
+	return channel < _channelCount ? _channels[channel].peakAmps : 0;
+}
+
+float CurrentMonitor::getLimitAmps(uint8_t channel) const
+{
+	return channel < _channelCount ? _channels[channel].limitAmps : 0;
+}
+
+void CurrentMonitor::resetWindow()
+{
+	for (uint8_t i = 0; i < _channelCount; i++)
+	{
+		_channels[i].sumAmps = 0;
+		_channels[i].sumSquares = 0;
+		_channels[i].peakAmps = 0;
+		_channels[i].samples = 0;
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "Config.h"
+
+// Channels on the external ADC, one per relay
+constexpr uint8_t CurrentMaxChannels = 8;
+
+// Consecutive samples over the limit before a channel reports a trip
+constexpr uint8_t CurrentTripSamples = 3;
+
+// After a relay switches on its limit is not checked for this long, motors
+// and lamps draw several times their running current while they start
+constexpr unsigned long CurrentInrushBlankMs = 150;
+
+struct CurrentChannel
+{
+	uint16_t zeroCounts;    // ADC reading with the relay off
+	float lastAmps;         // most recent sample
+	float limitAmps;        // trip level, 0 = no trip
+	uint8_t overCount;      // consecutive samples over the limit
+	bool blanking;          // inrush, limit not checked until blankUntil
+	unsigned long blankUntil;
+
+	// report window, cleared by resetWindow()
+	float sumAmps;
+	float sumSquares;
+	float peakAmps;
+	uint16_t samples;
+};
+
+// Per relay load current from hall effect sensors (ACS712 style, output
+// centred on half supply) read through an MCP3208 8 channel SPI ADC.
+// update() converts a few channels round robin so a scan is spread over
+// several loop passes, each channel is revisited every few milliseconds.
+// Every sample is checked against the channel limit straight away, except
+// during the inrush window after a relay switches on, and average, RMS and
+// peak are accumulated for the periodic report.
+class CurrentMonitor
+{
+private:
+	uint8_t _csPin;
+	uint8_t _channelCount;
+	uint8_t _channelsPerUpdate;
+	uint8_t _nextChannel;
+	CurrentChannel _channels[CurrentMaxChannels];
+
+	uint16_t readChannel(uint8_t channel);
+	float countsToAmps(uint8_t channel, uint16_t counts) const;
+
+public:
+	CurrentMonitor(uint8_t csPin, uint8_t channelCount, uint8_t channelsPerUpdate = 2);
+
+	// Call with every relay off, the zero current offset is measured per channel
+	void begin();
+
+	// Picks up the per relay current limits
+	void configUpdated(const Config* config);
+
+	// Samples the next channels, returns a bit per channel that has been over
+	// its limit for CurrentTripSamples consecutive samples
+	uint8_t update(unsigned long now);
+
+	// Relay was switched off by a trip, start counting again
+	void clearTrip(uint8_t channel);
+
+	// Relay has just switched on, ignore its limit for CurrentInrushBlankMs
+	void blankInrush(uint8_t channel, unsigned long now);
+
+	float getLastAmps(uint8_t channel) const;
+	float getAverageAmps(uint8_t channel) const;
+	float getRmsAmps(uint8_t channel) const;
+	float getPeakAmps(uint8_t channel) const;
+	float getLimitAmps(uint8_t channel) const;
+
+	// Clears average, RMS and peak after they have been reported
+	void resetWindow();
+
+	uint8_t getChannelCount() const { return _channelCount; }
+};
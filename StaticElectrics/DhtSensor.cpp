@@ -0,0 +1,204 @@
+#include "DhtSensor.h"
+#include "StaticElectricConstants.h"
+
+// Sensor needs this long after power up before the first reading
+constexpr unsigned long DhtPowerUpMs = 2000;
+
+// Host start signal, at least 18ms low
+constexpr unsigned long DhtStartSignalMs = 20;
+
+// Whole frame takes about 5ms, give up after this
+constexpr unsigned long DhtFrameTimeoutMs = 10;
+
+// Falling edge to falling edge, ~78us for a 0 bit and ~120us for a 1 bit
+constexpr unsigned long DhtBitThresholdUs = 100;
+constexpr unsigned long DhtBitMinUs = 60;
+constexpr unsigned long DhtBitMaxUs = 160;
+
+// DHT11 datasheet, no more than one reading a second
+constexpr unsigned long DhtMinIntervalMs = 1000;
+
+DhtSensor* DhtSensor::_instance = nullptr;
+
+DhtSensor::DhtSensor(uint8_t pin, unsigned long intervalMs)
+	: _pin(pin), _intervalMs(intervalMs),
+	  _state(DhtState::Idle), _stateStartTime(0), _nextReadingTime(0),
+	  _edgeCount(0),
+	  _temperature(NAN), _humidity(NAN),
+	  _readCount(0), _failureCount(0)
+{
+}
+
+bool DhtSensor::begin(unsigned long now)
+{
+	if (digitalPinToInterrupt(_pin) == NOT_AN_INTERRUPT)
+	{
+		setState(DhtState::Disabled, now);
+		return false;
+	}
+
+	_instance = this;
+
+	pinMode(_pin, INPUT_PULLUP);
+	_nextReadingTime = now + DhtPowerUpMs;
+	setState(DhtState::Idle, now);
+	return true;
+}
+
+void DhtSensor::setInterval(unsigned long intervalMs)
+{
+	if (intervalMs < DhtMinIntervalMs)
+		intervalMs = DhtMinIntervalMs;
+
+	if (_state == DhtState::Idle)
+		_nextReadingTime = _nextReadingTime - _intervalMs + intervalMs;
+
+	_intervalMs = intervalMs;
+}
+
+void DhtSensor::handleEdge()
+{
+	DhtSensor* sensor = _instance;
+	uint8_t count = sensor->_edgeCount;
+
+	if (count < DhtFrameEdges)
+	{
+		sensor->_edges[count] = micros();
+		sensor->_edgeCount = count + 1;
+	}
+}
+
+void DhtSensor::setState(DhtState state, unsigned long now)
+{
+	_state = state;
+	_stateStartTime = now;
+}
+
+bool DhtSensor::update(unsigned long now)
+{
+	switch (_state)
+	{
+		case DhtState::Idle:
+			if ((long)(now - _nextReadingTime) < 0)
+				return false;
+
+			// wake the sensor, the low is held by the next state's deadline
+			pinMode(_pin, OUTPUT);
+			digitalWrite(_pin, LOW);
+			setState(DhtState::StartSignal, now);
+			return false;
+
+		case DhtState::StartSignal:
+			if (now - _stateStartTime < DhtStartSignalMs)
+				return false;
+
+			_edgeCount = 0;
+			attachInterrupt(digitalPinToInterrupt(_pin), handleEdge, FALLING);
+			pinMode(_pin, INPUT_PULLUP);
+			setState(DhtState::Receiving, now);
+			return false;
+
+		case DhtState::Receiving:
+			if (_edgeCount < DhtFrameEdges && now - _stateStartTime < DhtFrameTimeoutMs)
+				return false;
+
+			detachInterrupt(digitalPinToInterrupt(_pin));
+
+			{
+				bool valid = decodeFrame();
+				finishReading(now);
+				return valid;
+			}
+
+		case DhtState::Disabled:
+			return false;
+	}
+
+	return false;
+}
+
+unsigned long DhtSensor::msUntilNextEvent(unsigned long now) const
+{
+	unsigned long elapsed = now - _stateStartTime;
+
+	switch (_state)
+	{
+		case DhtState::Idle:
+			return (long)(now - _nextReadingTime) >= 0 ? 0 : _nextReadingTime - now;
+
+		case DhtState::StartSignal:
+			return elapsed >= DhtStartSignalMs ? 0 : DhtStartSignalMs - elapsed;
+
+		case DhtState::Receiving:
+			// edges arrive by interrupt, which also wakes an idle loop
+			if (_edgeCount >= DhtFrameEdges)
+				return 0;
+
+			return elapsed >= DhtFrameTimeoutMs ? 0 : DhtFrameTimeoutMs - elapsed;
+
+		case DhtState::Disabled:
+			return NoPendingEvent;
+	}
+
+	return 0;
+}
+
+void DhtSensor::finishReading(unsigned long now)
+{
+	_nextReadingTime += _intervalMs;
+
+	// resynchronise rather than catch up if readings fell behind
+	if ((long)(now - _nextReadingTime) >= 0)
+		_nextReadingTime = now + _intervalMs;
+
+	setState(DhtState::Idle, now);
+}
+
+bool DhtSensor::decodeFrame()
+{
+	_readCount++;
+
+	uint8_t count = _edgeCount;
+
+	// the response edge may be missed, the bits are the last 40 intervals
+	if (count < DhtFrameBits + 1)
+	{
+		_failureCount++;
+		return false;
+	}
+
+	uint8_t data[5] = { 0, 0, 0, 0, 0 };
+	uint8_t first = count - (DhtFrameBits + 1);
+
+	for (uint8_t bit = 0; bit < DhtFrameBits; bit++)
+	{
+		unsigned long interval = _edges[first + bit + 1] - _edges[first + bit];
+
+		if (interval < DhtBitMinUs || interval > DhtBitMaxUs)
+		{
+			_failureCount++;
+			return false;
+		}
+
+		data[bit / 8] <<= 1;
+
+		if (interval > DhtBitThresholdUs)
+			data[bit / 8] |= 1;
+	}
+
+	uint8_t checksum = data[0] + data[1] + data[2] + data[3];
+	if (checksum != data[4])
+	{
+		_failureCount++;
+		return false;
+	}
+
+	_humidity = data[0] + data[1] * 0.1f;
+	_temperature = data[2] + (data[3] & 0x7F) * 0.1f;
+
+	// bit 7 of the decimal byte marks below zero
+	if (data[3] & 0x80)
+		_temperature = -_temperature;
+
+	return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Falling edges in a complete frame: response, start of first bit, then one per bit
+constexpr uint8_t DhtFrameEdges = 42;
+constexpr uint8_t DhtFrameBits = 40;
+
+enum class DhtState : uint8_t
+{
+	Idle,           // waiting for the next reading
+	StartSignal,    // host holding the line low to wake the sensor
+	Receiving,      // line released, edges captured by the pin interrupt
+	Disabled        // pin has no interrupt, never read
+};
+
+// DHT11 temperature/humidity sensor read without busy waiting.
+//
+// The start signal is held for its 20ms as a deadline, then the line is
+// released and a pin interrupt timestamps every falling edge. Each bit is a
+// 50us low followed by a short (0) or long (1) high, so the time between
+// consecutive falling edges decodes the bit. The frame is decoded from
+// update() once all edges have arrived, or discarded on timeout.
+//
+// The pin must be a pin with an external interrupt (see
+// digitalPinToInterrupt), begin() refuses any other pin. Only one instance
+// is supported, the interrupt handler is static.
+class DhtSensor
+{
+private:
+	static DhtSensor* _instance;
+	static void handleEdge();
+
+	uint8_t _pin;
+	unsigned long _intervalMs;
+
+	DhtState _state;
+	unsigned long _stateStartTime;
+	unsigned long _nextReadingTime;
+
+	volatile unsigned long _edges[DhtFrameEdges];
+	volatile uint8_t _edgeCount;
+
+	float _temperature;
+	float _humidity;
+	uint32_t _readCount;
+	uint32_t _failureCount;
+
+	void setState(DhtState state, unsigned long now);
+	void finishReading(unsigned long now);
+	bool decodeFrame();
+
+public:
+	DhtSensor(uint8_t pin, unsigned long intervalMs);
+
+	// False when the pin cannot raise an interrupt, the sensor stays disabled
+	bool begin(unsigned long now);
+
+	// Advances the read, returns true when a reading passed its checksum
+	bool update(unsigned long now);
+
+	// Milliseconds until update() has work to do, NoPendingEvent when disabled
+	unsigned long msUntilNextEvent(unsigned long now) const;
+
+	// Changes the time between readings, a reading already waiting is moved.
+	// Clamped to the DHT11's one second minimum
+	void setInterval(unsigned long intervalMs);
+
+	float getTemperature() const { return _temperature; }
+	float getHumidity() const { return _humidity; }
+	uint32_t getReadCount() const { return _readCount; }
+	uint32_t getFailureCount() const { return _failureCount; }
+};
@@ -7,20 +7,23 @@ constexpr char RelayTurnAllOn[] = "R1";
 constexpr char RelayRetrieveStates[] = "R2";
 constexpr char RelaySetState[] = "R3";
 constexpr char RelayStatusGet[] = "R4";
+constexpr char RelayTripStatus[] = "R5";
 
 
 RelayCommandHandler::RelayCommandHandler(SerialCommandManager* commandMgrComputer, SerialCommandManager* commandMgrLink, const uint8_t* relayPins, uint8_t totalRelays)
-    : _relayStatus(nullptr), _relays(nullptr), _relayCount(totalRelays), _reservedSoundRelay(DefaultValue), 
+    : _relayStatus(nullptr), _relayTripped(nullptr), _relays(nullptr), _relayCount(totalRelays), _reservedSoundRelay(DefaultValue), 
     _commandMgrComputer(commandMgrComputer), _commandMgrLink(commandMgrLink)
 {
     _relays = new uint8_t[_relayCount];
     memcpy(_relays, relayPins, sizeof(uint8_t) * _relayCount);
 
     _relayStatus = new bool[_relayCount];
+    _relayTripped = new bool[_relayCount];
 
     for (uint8_t i = 0; i < totalRelays; i++)
     {
         _relayStatus[i] = false;
+        _relayTripped[i] = false;
     }
 }
 
@@ -28,12 +31,13 @@ RelayCommandHandler::~RelayCommandHandler()
 {
     delete[] _relays;
     delete[] _relayStatus;
+    delete[] _relayTripped;
 }
 
 const String* RelayCommandHandler::supportedCommands(size_t& count) const
 {
     static const String cmds[] = { RelayTurnAllOff, RelayTurnAllOn, RelayRetrieveStates, 
-        RelaySetState, RelayStatusGet };
+        RelaySetState, RelayStatusGet, RelayTripStatus };
     count = sizeof(cmds) / sizeof(cmds[0]);
     return cmds;
 }
@@ -153,6 +157,23 @@ bool RelayCommandHandler::handleCommand(SerialCommandManager* sender, const Stri
 			return true;
         }
 	}
+    else if (cmd == RelayTripStatus)
+    {
+        if (paramCount == 0)
+        {
+            // 1 for each relay switched off by an overcurrent trip
+            for (uint8_t i = 0; i < _relayCount; i++)
+            {
+                StringKeyValue param = { String(i), _relayTripped[i] ? "1" : "0" };
+                sendAckOk(sender, cmd, &param);
+            }
+        }
+        else
+        {
+            sendAckErr(sender, cmd, F("Invalid parameters"));
+            return true;
+        }
+    }
     else
     {
         sendAckErr(sender, cmd, F("Unknown relay command"));
@@ -168,6 +189,7 @@ void RelayCommandHandler::setup()
     for (uint8_t i = 0; i < _relayCount; i++)
     {
         _relayStatus[i] = false;
+        _relayTripped[i] = false;
         pinMode(_relays[i], OUTPUT);
         digitalWrite(_relays[i], HIGH);
     }
@@ -195,9 +217,60 @@ RelayResult RelayCommandHandler::setRelayStatus(uint8_t relayIndex, bool isOn)
     _relayStatus[relayIndex] = isOn;
     digitalWrite(_relays[relayIndex], isOn ? LOW : HIGH);
 
+    // switching back on is the reset after a trip
+    if (isOn)
+    {
+        _relayTripped[relayIndex] = false;
+    }
+
 	return RelayResult::Success;
 }
 
+RelayResult RelayCommandHandler::tripRelay(uint8_t relayIndex, float amps)
+{
+    if (relayIndex >= _relayCount)
+    {
+        return RelayResult::InvalidIndex;
+    }
+
+    // the reserved sound relay is tripped as well, a short is a short
+    _relayTripped[relayIndex] = true;
+    _relayStatus[relayIndex] = false;
+    digitalWrite(_relays[relayIndex], HIGH);
+
+    // R2 state format so the panel updates its buttons
+    StringKeyValue state = { String(relayIndex), "0" };
+    broadcastRelayStatus(RelayRetrieveStates, &state);
+
+    if (_commandMgrComputer != nullptr)
+    {
+        StringKeyValue trip = { String(relayIndex), String(amps, 1) };
+        _commandMgrComputer->sendCommand(RelayTripStatus, "", "", &trip, 1);
+    }
+
+    return RelayResult::Success;
+}
+
+bool RelayCommandHandler::isRelayTripped(uint8_t relayIndex) const
+{
+    return relayIndex < _relayCount && _relayTripped[relayIndex];
+}
+
+uint8_t RelayCommandHandler::getTrippedCount() const
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < _relayCount; i++)
+    {
+        if (_relayTripped[i])
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
 uint8_t RelayCommandHandler::getRelayStatus(uint8_t relayIndex) const
 {
     if (relayIndex >= _relayCount)
@@ -15,6 +15,7 @@ class RelayCommandHandler : public BaseCommandHandler
 {
 private:
     bool* _relayStatus;
+    bool* _relayTripped;
     uint8_t* _relays;
     uint8_t _relayCount;
     uint8_t _reservedSoundRelay;
@@ -30,6 +31,11 @@ public:
     void setup();
     RelayResult setRelayStatus(uint8_t relayIndex, bool isOn);
 	uint8_t getRelayStatus(uint8_t relayIndex) const;
+
+    // Switches a relay off after an overcurrent, it stays tripped until switched on again
+    RelayResult tripRelay(uint8_t relayIndex, float amps);
+    bool isRelayTripped(uint8_t relayIndex) const;
+    uint8_t getTrippedCount() const;
 private:
     void broadcastRelayStatus(const String& cmd, const StringKeyValue* param = nullptr);
 };
@@ -0,0 +1,93 @@
+#include "SensorPolicy.h"
+#include <math.h>
+
+SensorPolicy::SensorPolicy()
+	: _publishedCount(0), _suppressedCount(0)
+{
+	memset(_state, 0, sizeof(_state));
+	memset(_channelsSent, 0, sizeof(_channelsSent));
+}
+
+bool SensorPolicy::isDue(const SensorDescriptor* descriptor, const State& state, bool moved, unsigned long now) const
+{
+	// nothing sent yet, the panel has no value at all
+	if (!state.sent)
+		return true;
+
+	unsigned long elapsed = now - state.lastSentTime;
+
+	if (descriptor->maxIntervalMs > 0 && elapsed >= descriptor->maxIntervalMs)
+		return true;
+
+	return moved && elapsed >= descriptor->minIntervalMs;
+}
+
+bool SensorPolicy::shouldPublish(SensorId id, float value, unsigned long now, bool force)
+{
+	const SensorDescriptor* descriptor = SensorRegistry::getDescriptor(id);
+
+	if (descriptor == nullptr)
+		return false;
+
+	State& state = _state[static_cast<uint8_t>(id)];
+	bool moved = fabsf(value - state.lastSent) > descriptor->deadband;
+
+	if (!force && !isDue(descriptor, state, moved, now))
+	{
+		_suppressedCount++;
+		return false;
+	}
+
+	state.lastSent = value;
+	state.lastSentTime = now;
+	state.sent = true;
+	_publishedCount++;
+	return true;
+}
+
+bool SensorPolicy::shouldPublishChannels(SensorId id, const float* values, uint8_t count, unsigned long now)
+{
+	const SensorDescriptor* descriptor = SensorRegistry::getDescriptor(id);
+
+	if (descriptor == nullptr)
+		return false;
+
+	State& state = _state[static_cast<uint8_t>(id)];
+	bool moved = false;
+
+	count = min(count, SensorMaxChannels);
+
+	for (uint8_t i = 0; i < count && !moved; i++)
+		moved = fabsf(values[i] - _channelsSent[i]) > descriptor->deadband;
+
+	if (!isDue(descriptor, state, moved, now))
+	{
+		_suppressedCount++;
+		return false;
+	}
+
+	memcpy(_channelsSent, values, count * sizeof(float));
+	state.lastSentTime = now;
+	state.sent = true;
+	_publishedCount++;
+	return true;
+}
+
+unsigned long SensorPolicy::sampleIntervalMs(SensorId id, float sample, unsigned long slowMs, unsigned long fastMs)
+{
+	const SensorDescriptor* descriptor = SensorRegistry::getDescriptor(id);
+
+	if (descriptor == nullptr)
+		return slowMs;
+
+	State& state = _state[static_cast<uint8_t>(id)];
+
+	// compared reading to reading, so a slow drift stays at the slow rate
+	if (fabsf(sample - state.lastSample) > descriptor->deadband)
+		state.fastSamples = SensorFastSampleCount;
+	else if (state.fastSamples > 0)
+		state.fastSamples--;
+
+	state.lastSample = sample;
+	return state.fastSamples > 0 ? fastMs : slowMs;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "SensorRegistry.h"
+
+// Readings taken at the fast rate after a value last moved beyond its deadband
+constexpr uint8_t SensorFastSampleCount = 5;
+
+// Publish on change with a heartbeat, per sensor, using the minIntervalMs,
+// maxIntervalMs and deadband columns of the sensor table.
+//
+// A value is sent when it has moved more than the deadband from the last
+// value sent, but not sooner than minIntervalMs after that send, and is
+// sent regardless once maxIntervalMs has passed so the panel can tell the
+// link is alive and pick values up after a restart. A steady sensor costs
+// one message per heartbeat instead of one per reading.
+//
+// sampleIntervalMs() drives adaptive sampling, a sensor whose readings move
+// beyond the deadband is read at its fast interval for the next few readings.
+class SensorPolicy
+{
+private:
+	struct State
+	{
+		float lastSent;
+		unsigned long lastSentTime;
+		float lastSample;
+		uint8_t fastSamples;
+		bool sent;
+	};
+
+	State _state[SensorCount];
+
+	// the fuse box has a single channel sensor, RelayCurrent
+	float _channelsSent[SensorMaxChannels];
+
+	uint32_t _publishedCount;
+	uint32_t _suppressedCount;
+
+	bool isDue(const SensorDescriptor* descriptor, const State& state, bool moved, unsigned long now) const;
+
+public:
+	SensorPolicy();
+
+	// true when the value should be sent now, the value is then recorded as sent.
+	// force sends regardless of the policy, e.g. alongside a warning change
+	bool shouldPublish(SensorId id, float value, unsigned long now, bool force = false);
+
+	// As shouldPublish(), any channel beyond the deadband sends them all
+	bool shouldPublishChannels(SensorId id, const float* values, uint8_t count, unsigned long now);
+
+	// Interval until the next reading, fastMs while the value is moving
+	unsigned long sampleIntervalMs(SensorId id, float sample, unsigned long slowMs, unsigned long fastMs);
+
+	uint32_t getPublishedCount() const { return _publishedCount; }
+	uint32_t getSuppressedCount() const { return _suppressedCount; }
+};
@@ -0,0 +1,47 @@
+#include "SensorRegistry.h"
+#include <math.h>
+
+// const keeps the table in flash on the R4, no PROGMEM reads needed
+const SensorDescriptor SensorTable[] =
+{
+	// id, format, min ms, heartbeat ms, deadband
+	{ 0, SensorFormats[0], 2000, 60000, 0.3f },    // Temperature
+	{ 1, SensorFormats[1], 2000, 60000, 2.0f },    // Humidity
+	{ 2, SensorFormats[2], 0, 0, 0.0f },           // Bearing
+	{ 3, SensorFormats[3], 0, 0, 0.0f },           // Direction
+	{ 4, SensorFormats[4], 0, 0, 0.0f },           // Speed
+	{ 5, SensorFormats[5], 0, 0, 0.0f },           // CompassTemp
+	{ 6, SensorFormats[6], 1000, 60000, 8.0f },    // WaterLevel
+	{ 7, SensorFormats[7], 0, 0, 0.0f },           // WaterPump
+	{ 8, SensorFormats[8], 0, 0, 0.0f },           // Horn
+	{ 9, SensorFormats[9], 0, 0, 0.0f },           // RateOfTurn
+	{ 10, SensorFormats[10], 2000, 60000, 0.05f }, // Battery
+	{ 11, SensorFormats[11], 1000, 30000, 0.2f }   // RelayCurrent
+};
+
+static_assert(sizeof(SensorTable) / sizeof(SensorTable[0]) == SensorCount,
+	"SensorTable must have a row for each SensorId");
+
+const SensorDescriptor* SensorRegistry::getDescriptor(SensorId id)
+{
+	uint8_t index = static_cast<uint8_t>(id);
+	return index < SensorCount ? &SensorTable[index] : nullptr;
+}
+
+String SensorRegistry::commandName(SensorId id)
+{
+	return String('S') + String(static_cast<uint8_t>(id));
+}
+
+String SensorRegistry::formatValue(const SensorDescriptor* descriptor, float value)
+{
+	if (descriptor == nullptr)
+		return String(value);
+
+	float sent = value / descriptor->format.scale;
+
+	if (descriptor->format.decimals == 0)
+		return String(lroundf(sent));
+
+	return String(sent, (unsigned int)descriptor->format.decimals);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <SensorProtocol.h>
+
+// One row of the sensor table
+struct SensorDescriptor
+{
+	uint8_t id;                 // SensorId, also the row index
+	SensorFormat format;        // type, decimals and scale, shared with the panel
+	uint16_t minIntervalMs;     // least time between sends while the value changes
+	uint16_t maxIntervalMs;     // heartbeat, sent at least this often, 0 = none
+	float deadband;             // change from the last sent value that is worth sending
+};
+
+// Table driven description of every S<n> sensor. Sensor tasks hand their
+// reading to the sketch's publishSensor(), which looks the row up by id and
+// encodes the command from it, so precision and publish policy (see
+// SensorPolicy) live in one table rather than in each read function.
+class SensorRegistry
+{
+public:
+	// Row for an id, nullptr if the id is not in the table
+	static const SensorDescriptor* getDescriptor(SensorId id);
+
+	// "S<n>" for the id
+	static String commandName(SensorId id);
+
+	// Value scaled and formatted with the row's decimals
+	static String formatValue(const SensorDescriptor* descriptor, float value);
+};
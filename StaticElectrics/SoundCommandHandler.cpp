@@ -18,10 +18,12 @@ constexpr char SoundOvertakePort[] = "H9";
 constexpr char SoundOvertakeConsent[] = "H10";
 constexpr char SoundOvertakeDanger[] = "H11";
 constexpr char SoundTest[] = "H12";
+constexpr char SoundHorn[] = "H13";
 
 SoundCommandHandler::SoundCommandHandler(SerialCommandManager* commandMgrComputer, SerialCommandManager* commandMgrLink, 
     SoundManager* soundManager)
-	: _commandMgrComputer(commandMgrComputer), _commandMgrLink(commandMgrLink), _soundManager(soundManager)
+	: _commandMgrComputer(commandMgrComputer), _commandMgrLink(commandMgrLink), _soundManager(soundManager),
+    _lastSoundType(SoundType::None), _lastSoundState(SoundState::Idle)
 {
 
 }
@@ -31,7 +33,7 @@ const String* SoundCommandHandler::supportedCommands(size_t& count) const
     static const String cmds[] = { SoundCancellAll, SoundIsActive, SoundDangerSos, SoundFog,
         SoundManeuverAstern, SoundManeuverDanger, SoundManeuverPort, SoundManeuverStarboard, 
         SoundOvertakeConsent, SoundOvertakeDanger, SoundOvertakePort, SoundOvertakeStarboard, 
-        SoundTest };
+        SoundTest, SoundHorn };
     count = sizeof(cmds) / sizeof(cmds[0]);
     return cmds;
 }
@@ -63,8 +65,7 @@ bool SoundCommandHandler::handleCommand(SerialCommandManager* sender, const Stri
     }
     else if (cmd == SoundIsActive)
     {
-        StringKeyValue param = { String(static_cast<uint8_t>(_soundManager->getCurrentSoundType())), String(static_cast<uint8_t>(_soundManager->getCurrentSoundState())) };
-        sendAckOk(sender, cmd, &param);
+        sendActiveState(sender);
     }
     else if (cmd == SoundDangerSos)
     {
@@ -121,6 +122,11 @@ bool SoundCommandHandler::handleCommand(SerialCommandManager* sender, const Stri
         _soundManager->playSound(SoundType::Test);
         sendAckOk(sender, cmd);
     }
+    else if (cmd == SoundHorn)
+    {
+        _soundManager->playSound(SoundType::Horn);
+        sendAckOk(sender, cmd);
+    }
     else
     {
         sendAckErr(sender, cmd, F("Unknown system command"));
@@ -131,6 +137,30 @@ bool SoundCommandHandler::handleCommand(SerialCommandManager* sender, const Stri
     return true;
 }
 
+void SoundCommandHandler::update()
+{
+    if (_soundManager == nullptr || _commandMgrLink == nullptr)
+        return;
+
+    SoundType soundType = _soundManager->getCurrentSoundType();
+    SoundState soundState = _soundManager->getCurrentSoundState();
+
+    if (soundType == _lastSoundType && soundState == _lastSoundState)
+        return;
+
+    // one message per transition, the panel shows each blast as it happens
+    // instead of replaying the pattern timings on the display
+    _lastSoundType = soundType;
+    _lastSoundState = soundState;
+    sendActiveState(_commandMgrLink);
+}
+
+void SoundCommandHandler::sendActiveState(SerialCommandManager* sender)
+{
+    StringKeyValue param = { String(static_cast<uint8_t>(_soundManager->getCurrentSoundType())), String(static_cast<uint8_t>(_soundManager->getCurrentSoundState())) };
+    sendAckOk(sender, SoundIsActive, &param);
+}
+
 void SoundCommandHandler::broadcast(const String& cmd, const StringKeyValue* param)
 {
     if (_commandMgrLink != nullptr)
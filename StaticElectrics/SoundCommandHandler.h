@@ -12,12 +12,18 @@ private:
     SerialCommandManager* _commandMgrComputer;
     SerialCommandManager* _commandMgrLink;
     SoundManager* _soundManager;
+    SoundType _lastSoundType;
+    SoundState _lastSoundState;
 
 public:
     SoundCommandHandler(SerialCommandManager* commandMgrComputer, SerialCommandManager* commandMgrLink, SoundManager* soundManager);
     bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
 
     const String* supportedCommands(size_t& count) const override;
+
+    // Pushes the H1 state to the link on every sound type or state change (blast on/gap), call from loop()
+    void update();
 private:
     void broadcast(const String& cmd, const StringKeyValue* param = nullptr);
+    void sendActiveState(SerialCommandManager* sender);
 };
@@ -24,6 +24,9 @@ const uint16_t PatternSos[] = {MorseCodeShortMs, MorseCodeShortMs, MorseCodeShor
 // Test pattern
 const uint16_t PatternTest[] = {SoundBlastShortMs};
 
+// Held horn, one blast cut short by H0 when the button is released
+const uint16_t PatternHorn[] = {SoundHornMaxMs};
+
 // Pattern lookup table
 const SoundPattern SoundPatterns[] = {
 	{nullptr, 0, NoRepeat, 0},                                  // None
@@ -37,7 +40,8 @@ const SoundPattern SoundPatterns[] = {
 	{PatternOvertakePort, 4, NoRepeat, SoundBlastGapMs},        // OvertakePort
 	{PatternOvertakeConsent, 4, NoRepeat, SoundBlastGapMs},     // OvertakeConsent
 	{PatternDanger, 5, NoRepeat, SoundBlastGapMs},              // OvertakeDanger
-	{PatternTest, 1, NoRepeat, SoundBlastGapMs}                 // Test
+	{PatternTest, 1, NoRepeat, SoundBlastGapMs},                // Test
+	{PatternHorn, 1, NoRepeat, SoundBlastGapMs}                 // Horn
 };
 
 SoundManager::SoundManager()
@@ -164,6 +168,39 @@ void SoundManager::update()
 	}
 }
 
+unsigned long SoundManager::msUntilNextEvent(unsigned long now) const
+{
+	if (!_isPlaying || !_currentPattern)
+		return NoPendingEvent;
+
+	unsigned long duration;
+
+	switch (_state)
+	{
+		case SoundState::StartDelay:
+			duration = _soundStartDelay;
+			break;
+
+		case SoundState::BlastOn:
+			duration = _currentPattern->durations[_currentBlastIndex];
+			break;
+
+		case SoundState::BlastGap:
+			duration = _currentPattern->gapDuration;
+			break;
+
+		case SoundState::WaitingRepeat:
+			duration = _currentPattern->repeatInterval;
+			break;
+
+		default:
+			return NoPendingEvent;
+	}
+
+	unsigned long elapsed = now - _stateStartTime;
+	return elapsed >= duration ? 0 : duration - elapsed;
+}
+
 void SoundManager::startPattern(const SoundPattern* pattern)
 {
 	_currentPattern = pattern;
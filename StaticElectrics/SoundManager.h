@@ -32,7 +32,8 @@ enum class SoundType : uint8_t
 	OvertakePort = 0x08,
 	OvertakeConsent = 0x09,
 	OvertakeDanger = 0x0A,
-	Test = 0x0B
+	Test = 0x0B,
+	Horn = 0x0C     // held horn, sounds until cancelled (H0) or SoundHornMaxMs
 };
 
 class SoundManager
@@ -60,6 +61,9 @@ public:
 	void playSound(const SoundType soundType);
 	bool isPlaying() const { return _isPlaying; }
 	void update();
+
+	// Milliseconds until update() has work to do, NoPendingEvent when idle
+	unsigned long msUntilNextEvent(unsigned long now) const;
 	SoundType getCurrentSoundType() const { return _soundType; }
 	SoundState getCurrentSoundState() const { return _state; }
 	void configUpdated(Config* config);
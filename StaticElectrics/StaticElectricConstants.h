@@ -20,9 +20,13 @@ constexpr uint8_t TotalRelays = 8;
 constexpr uint8_t Relays[TotalRelays] = { Relay1, Relay2, Relay3, Relay4, Relay5, Relay6, Relay7, Relay8 };
 
 constexpr char SystemInitialized[] = "F1";
-constexpr char SensorWaterLevel[] = "S6";
-constexpr char SensorTemperature[] = "S0";
-constexpr char SensorHumidity[] = "S1";
+constexpr char SystemTaskStats[] = "F6";
+
+// Warnings raised on the control panel, W4:<type>=<0|1>
+constexpr char WarningSetStatus[] = "W4";
+constexpr char WarningLowBattery[] = "0x04";
+constexpr char WarningSensorFailure[] = "0x05";
+constexpr char WarningRelayTripped[] = "0x07";
 
 constexpr unsigned long SerialInitTimeoutMs = 300;
 
@@ -32,6 +36,7 @@ constexpr uint16_t DefaultSoundStartDelayMs = 500;
 constexpr uint16_t SoundBlastShortMs = 1000;  // ~1 second (COLREGS Rule 34)
 constexpr uint16_t SoundBlastLongMs = 5000;   // 4-6 seconds (COLREGS Rule 34)
 constexpr uint16_t SoundBlastGapMs = 1500;    // Gap between blasts in COLREGS sequences
+constexpr uint16_t SoundHornMaxMs = 15000;    // held horn stops on its own if the release (H0) is lost
 
 // SOS-specific durations (Morse code timing for electronic signal)
 constexpr uint16_t MorseCodeShortMs = 500;         // Dot duration
@@ -42,3 +47,6 @@ constexpr uint16_t MorseCodeGapMs = 400;            // Gap between dots/dashes
 constexpr uint32_t FogRepeatMs = 120000;  // 2 minutes (COLREGS Rule 35)
 constexpr uint32_t SosRepeatMs = 10000;   // 10 seconds (distress signal)
 constexpr uint32_t NoRepeat = 0;           // One-shot signals
+
+// Returned by msUntilNextEvent() when nothing is scheduled
+constexpr unsigned long NoPendingEvent = 0xFFFFFFFFUL;
@@ -2,55 +2,104 @@
 #include <stdint.h>
 #include <UnoWiFiDevEd.h>
 #include <Adafruit_Sensor.h>
-#include <dht11.h>
 #include <SerialCommandManager.h>
+#include <TaskScheduler.h>
+#include <RingStats.h>
 
 #include "StaticElectricConstants.h"
 #include "Config.h"
 #include "ConfigManager.h"
 #include "ConfigCommandHandler.h"
-#include "Queue.h"
 #include "SoundManager.h"
 #include "SoundCommandHandler.h"
 #include "RelayCommandHandler.h"
 #include "BaseCommandHandler.h"
+#include "WaterLevelSensor.h"
+#include "DhtSensor.h"
+#include "BatteryMonitor.h"
+#include "CurrentMonitor.h"
+#include "SensorRegistry.h"
+#include "SensorPolicy.h"
+#include "SystemCommandHandler.h"
 
 
 #define COMPUTER_SERIAL Serial
 #define LINK_SERIAL Serial1
 
-constexpr int DefaultDelay = 5;
+// Sleep between events, false keeps the core spinning (e.g. while profiling)
+constexpr bool IdleSleepEnabled = true;
 
 constexpr uint8_t WaterSensorPin = A0;
 constexpr uint8_t WaterSensorActivePin = D8;
 
 constexpr unsigned long SensorCheckIntervalMs = 5000;
 
+// sensors are read at these intervals while their value is moving
+constexpr unsigned long WaterSensorFastIntervalMs = 1000;
+constexpr unsigned long DhtFastIntervalMs = 2000;
+constexpr unsigned long WaterSensorSettleMs = 10;
+constexpr uint8_t WaterSensorOversample = 8;
+
 constexpr unsigned long serialInitTimeoutMs = 300;
 constexpr unsigned long serialReconnectMs = 10000;
 
-constexpr uint8_t TempSensorPin = D9;
+// DHT11 frame edges are timed by a pin interrupt, only D2 and D3 have one on the UNO R4
+constexpr uint8_t TempSensorPin = D2;
+
+// battery sense divider, one conversion per task run, 64 per decimated reading
+constexpr uint8_t BatterySensePin = A1;
+constexpr unsigned long BatterySampleIntervalMs = 10;
+constexpr uint8_t BatteryExtraBits = 3;
+
+// relay current sensors on an MCP3208 (SPI), two channels per run so each
+// relay is sampled every 4ms and a trip lands within CurrentTripSamples of that,
+// or CurrentInrushBlankMs after the relay switched on at the earliest
+constexpr uint8_t CurrentAdcCsPin = D10;
+constexpr unsigned long CurrentScanIntervalMs = 1;
+constexpr uint8_t CurrentChannelsPerScan = 2;
 
 // forward declares
 void InitializeSerial(HardwareSerial& serialPort, unsigned long baudRate, bool waitForConnection = false);
 void onComputerCommandReceived(SerialCommandManager* mgr);
 void onLinkCommandReceived(SerialCommandManager* mgr);
+bool publishSensor(SensorId id, float value, unsigned long now, bool force = false);
 
 SerialCommandManager commandMgrComputer(&COMPUTER_SERIAL, onComputerCommandReceived, '\n', ':', '=', 500, 64);
 SerialCommandManager commandMgrLink(&LINK_SERIAL, onLinkCommandReceived, '\n', ':', '=', 500, 64);
 
+// sensor work runs as scheduler tasks, timing reported by F6
+TaskScheduler scheduler;
+int8_t waterLevelTaskId = InvalidTask;
+int8_t weatherTaskId = InvalidTask;
+
+BatteryMonitor batteryMonitor(BatterySensePin, BatteryExtraBits);
+bool batteryWarningSent = false;
+
+CurrentMonitor currentMonitor(CurrentAdcCsPin, TotalRelays, CurrentChannelsPerScan);
+unsigned long lastCurrentReport = 0;
+bool tripWarningSent = false;
+uint8_t relaysOn = 0;
+
+// readings are only sent when they move beyond the deadband or the heartbeat is due
+SensorPolicy sensorPolicy;
+
 SoundManager soundManager;
 
 RelayCommandHandler relayHandler(&commandMgrComputer, &commandMgrLink, Relays, TotalRelays);
 SoundCommandHandler soundHandler(&commandMgrComputer, &commandMgrLink, &soundManager);
-ConfigCommandHandler configHandler(&soundManager);
+ConfigCommandHandler configHandler(&soundManager, &batteryMonitor, &currentMonitor);
+SystemCommandHandler systemHandler(&scheduler);
+
+WaterLevelSensor waterLevelSensor(WaterSensorPin, WaterSensorActivePin, SensorCheckIntervalMs,
+	WaterSensorSettleMs, WaterSensorOversample);
+RingStats<int, 15, long> waterLevelStats;
 
-unsigned long nextWaterSensorCheck = 5000;
-Queue waterPumpQueue(15);
+// median of the last few readings drops a single bad frame that passed its checksum
+RingStats<float, 3> temperatureStats;
+RingStats<float, 3> humidityStats;
 
-dht11 dht11Sensor;
+DhtSensor dhtSensor(TempSensorPin, SensorCheckIntervalMs);
 
-unsigned long nextWeatherSensorCheck = 2500;
 unsigned long lastSerialConnectAttempt = 0;
 
 
@@ -60,20 +109,47 @@ void setup()
 	size_t linkHandlerCount = sizeof(linkHandlers) / sizeof(linkHandlers[0]);
 	commandMgrLink.registerHandlers(linkHandlers, linkHandlerCount);
 
-	ISerialCommandHandler* computerHandlers[] = { &relayHandler, &soundHandler, &configHandler };
+	ISerialCommandHandler* computerHandlers[] = { &relayHandler, &soundHandler, &configHandler, &systemHandler };
 	size_t computerHandlerCount = sizeof(computerHandlers) / sizeof(computerHandlers[0]);
 	commandMgrComputer.registerHandlers(computerHandlers, computerHandlerCount);
 
 	InitializeSerial(COMPUTER_SERIAL, 115200, true);
 	InitializeSerial(LINK_SERIAL, 9600, true);
 
+	// defaults are used when nothing valid has been saved
+	ConfigManager::load();
 	soundManager.configUpdated(ConfigManager::getConfigPtr());
+	batteryMonitor.configUpdated(ConfigManager::getConfigPtr());
+	currentMonitor.configUpdated(ConfigManager::getConfigPtr());
+
+	// water sensor, probe is only powered while it is being read
+	waterLevelSensor.begin(millis());
 
-	// water sensor
-	pinMode(WaterSensorActivePin, OUTPUT);
-	digitalWrite(WaterSensorActivePin, LOW);
+	// temperature/humidity, frame edges are timestamped by a pin interrupt
+	bool dhtReady = dhtSensor.begin(millis());
+	batteryMonitor.begin();
 	relayHandler.setup();
 
+	// relays are all off after setup(), so the sensors read their zero offset
+	currentMonitor.begin();
+
+	// one-shot tasks, each run re-arms itself for the sensor's next deadline
+	waterLevelTaskId = scheduler.addOneShot(getWaterSensorValue, waterLevelSensor.msUntilNextEvent(millis()), "water");
+
+	if (dhtReady)
+	{
+		weatherTaskId = scheduler.addOneShot(readDHT11Sensor, dhtSensor.msUntilNextEvent(millis()), "dht");
+	}
+	else
+	{
+		commandMgrComputer.sendError(F("DHT pin has no interrupt"), F("SETUP"));
+		StringKeyValue param = { WarningSensorFailure, "1" };
+		commandMgrLink.sendCommand(WarningSetStatus, "", "", &param, 1);
+	}
+
+	scheduler.addPeriodic(readBatteryVoltage, BatterySampleIntervalMs, "batt");
+	scheduler.addPeriodic(scanRelayCurrents, CurrentScanIntervalMs, "amps");
+
 	commandMgrComputer.sendCommand(SystemInitialized, "");
 }
 
@@ -83,51 +159,215 @@ void loop()
 	commandMgrComputer.readCommands();
 	commandMgrLink.readCommands();
 	soundManager.update();
+	soundHandler.update();
 
-	getWaterSensorValue(now);
-	readDHT11Sensor(now);
+	scheduler.run(now);
 
-	delay(DefaultDelay);
+	idleUntilNextEvent();
+}
+
+void idleUntilNextEvent()
+{
+	// commands already waiting are handled on the next pass
+	if (COMPUTER_SERIAL.available() > 0 || LINK_SERIAL.available() > 0)
+		return;
+
+	unsigned long now = millis();
+	unsigned long idleMs = soundManager.msUntilNextEvent(now);
+	idleMs = min(idleMs, scheduler.msUntilNextRun(now));
+
+	if (idleMs == 0 || !IdleSleepEnabled)
+		return;
+
+	// wait for the next interrupt, the millis tick bounds the sleep to 1ms so
+	// deadlines are met within a tick, while UART RX and the DHT edge interrupt
+	// wake the loop straight away
+#if defined(ARDUINO_ARCH_RENESAS)
+	__WFI();
+#endif
 }
 
 void getWaterSensorValue(unsigned long currTime)
 {
-	if (currTime > nextWaterSensorCheck)
+	// power on, settle, oversample and power off run as deadlines in the sensor
+	if (waterLevelSensor.update(currTime))
 	{
-		if (waterPumpQueue.isFull())
-		  waterPumpQueue.dequeue();
-
-		digitalWrite(WaterSensorActivePin, HIGH);
+		int sensorValue = waterLevelSensor.getValue();
+		waterLevelStats.push(sensorValue);
 
-		delay(10);
-		int sensorValue = analogRead(WaterSensorPin);
-		waterPumpQueue.enqueue(sensorValue);
+		int average = (int)waterLevelStats.mean();
 
-		digitalWrite(WaterSensorActivePin, LOW);
+		// read faster while the level is moving, e.g. the bilge filling
+		waterLevelSensor.setInterval(sensorPolicy.sampleIntervalMs(SensorId::WaterLevel, sensorValue,
+			SensorCheckIntervalMs, WaterSensorFastIntervalMs));
 
-		nextWaterSensorCheck = currTime + SensorCheckIntervalMs;
-		commandMgrLink.sendCommand(SensorWaterLevel, String(waterPumpQueue.average()));
+		publishSensor(SensorId::WaterLevel, average, currTime);
 
 		commandMgrComputer.sendDebug(String(sensorValue), F("WTRLVL"));
-		commandMgrComputer.sendDebug(String(waterPumpQueue.average()), F("WTRAVG"));
+		commandMgrComputer.sendDebug(String(average), F("WTRAVG"));
 	}
+
+	scheduler.schedule(waterLevelTaskId, waterLevelSensor.msUntilNextEvent(currTime));
 }
 
 void readDHT11Sensor(unsigned long currTime)
 {
-	if (currTime > nextWeatherSensorCheck)
+	// only readings that pass the checksum are sent on, failures are counted
+	uint32_t failures = dhtSensor.getFailureCount();
+
+	bool hasReading = dhtSensor.update(currTime);
+
+	if (!hasReading)
+	{
+		scheduler.schedule(weatherTaskId, dhtSensor.msUntilNextEvent(currTime));
+
+		if (dhtSensor.getFailureCount() != failures)
+			commandMgrComputer.sendDebug(String(dhtSensor.getFailureCount()), F("DHTFAIL"));
+
+		return;
+	}
+
+	temperatureStats.push(dhtSensor.getTemperature());
+	humidityStats.push(dhtSensor.getHumidity());
+
+	float humidity = humidityStats.median();
+	float tempCelsius = temperatureStats.median();
+
+	// fast while either value is moving, one reading gives both
+	unsigned long temperatureMs = sensorPolicy.sampleIntervalMs(SensorId::Temperature, tempCelsius,
+		SensorCheckIntervalMs, DhtFastIntervalMs);
+	unsigned long humidityMs = sensorPolicy.sampleIntervalMs(SensorId::Humidity, humidity,
+		SensorCheckIntervalMs, DhtFastIntervalMs);
+
+	dhtSensor.setInterval(min(temperatureMs, humidityMs));
+	scheduler.schedule(weatherTaskId, dhtSensor.msUntilNextEvent(currTime));
+
+	commandMgrComputer.sendDebug(String(humidity, 1), F("Humidity"));
+	commandMgrComputer.sendDebug(String(tempCelsius, 1), F("Temperature"));
+
+	publishSensor(SensorId::Temperature, tempCelsius, currTime);
+	publishSensor(SensorId::Humidity, humidity, currTime);
+}
+
+void readBatteryVoltage(unsigned long currTime)
+{
+	// a single conversion per run, the decimated reading completes every 64 runs
+	if (!batteryMonitor.update())
+		return;
+
+	bool low = batteryMonitor.isLow();
+	bool warningChanged = low != batteryWarningSent;
+
+	float volts = batteryMonitor.getVoltage();
+
+	// a warning change goes out with the voltage that caused it
+	if (!publishSensor(SensorId::BatteryVoltage, volts, currTime, warningChanged))
+		return;
+
+	commandMgrComputer.sendDebug(String(volts, 2), F("BATT"));
+
+	// pushed on change, and repeated with the heartbeat while low so a restarted panel picks it up again
+	if (warningChanged || low)
+	{
+		StringKeyValue param = { WarningLowBattery, low ? "1" : "0" };
+		commandMgrLink.sendCommand(WarningSetStatus, "", "", &param, 1);
+		batteryWarningSent = low;
+	}
+}
+
+void sendTripWarning(bool tripped)
+{
+	StringKeyValue param = { WarningRelayTripped, tripped ? "1" : "0" };
+	commandMgrLink.sendCommand(WarningSetStatus, "", "", &param, 1);
+	tripWarningSent = tripped;
+}
+
+void scanRelayCurrents(unsigned long currTime)
+{
+	// a relay that has just switched on gets its inrush window before trips count
+	for (uint8_t i = 0; i < TotalRelays; i++)
 	{
-		dht11Sensor.read(TempSensorPin);
-		commandMgrComputer.sendDebug(String(dht11Sensor.humidity, 1), F("Humidity"));
-		commandMgrComputer.sendDebug(String(dht11Sensor.temperature, 1), F("Temperature"));
-		float humidity = dht11Sensor.humidity;
-		float tempCelsius = dht11Sensor.temperature;
+		uint8_t bit = 1 << i;
+		bool on = relayHandler.getRelayStatus(i) == 1;
 
-		nextWeatherSensorCheck = currTime + SensorCheckIntervalMs;
+		if (on && (relaysOn & bit) == 0)
+			currentMonitor.blankInrush(i, currTime);
 
-		commandMgrLink.sendCommand(SensorTemperature, String(tempCelsius, 1));
-		commandMgrLink.sendCommand(SensorHumidity, String(humidity, 0));
+		relaysOn = on ? relaysOn | bit : relaysOn & ~bit;
 	}
+
+	uint8_t overLimit = currentMonitor.update(currTime);
+
+	for (uint8_t i = 0; overLimit != 0 && i < TotalRelays; i++)
+	{
+		if ((overLimit & (1 << i)) == 0)
+			continue;
+
+		// an off relay reading over the limit is a sensor fault, not a load to cut
+		if (relayHandler.getRelayStatus(i) == 1)
+			relayHandler.tripRelay(i, currentMonitor.getLastAmps(i));
+
+		currentMonitor.clearTrip(i);
+	}
+
+	bool tripped = relayHandler.getTrippedCount() > 0;
+
+	if (tripped != tripWarningSent)
+		sendTripWarning(tripped);
+
+	if (currTime - lastCurrentReport < sensorMinIntervalMs(SensorId::RelayCurrent))
+		return;
+
+	lastCurrentReport = currTime;
+
+	// RMS over the window since the last check, one channel per relay
+	float amps[TotalRelays];
+
+	for (uint8_t i = 0; i < TotalRelays; i++)
+		amps[i] = currentMonitor.getRmsAmps(i);
+
+	currentMonitor.resetWindow();
+
+	// repeated with the currents while tripped so a restarted panel picks it up again
+	if (publishSensorChannels(SensorId::RelayCurrent, amps, TotalRelays, currTime) && tripped)
+		sendTripWarning(tripped);
+}
+
+unsigned long sensorMinIntervalMs(SensorId id)
+{
+	const SensorDescriptor* descriptor = SensorRegistry::getDescriptor(id);
+	return descriptor != nullptr ? descriptor->minIntervalMs : 0;
+}
+
+bool publishSensor(SensorId id, float value, unsigned long now, bool force)
+{
+	// every S<n> leaves through here, encoded from the sensor table
+	if (!sensorPolicy.shouldPublish(id, value, now, force))
+		return false;
+
+	const SensorDescriptor* descriptor = SensorRegistry::getDescriptor(id);
+	commandMgrLink.sendCommand(SensorRegistry::commandName(id), SensorRegistry::formatValue(descriptor, value));
+	return true;
+}
+
+bool publishSensorChannels(SensorId id, const float* values, uint8_t count, unsigned long now)
+{
+	if (!sensorPolicy.shouldPublishChannels(id, values, count, now))
+		return false;
+
+	const SensorDescriptor* descriptor = SensorRegistry::getDescriptor(id);
+	StringKeyValue params[SensorMaxChannels];
+
+	count = min(count, SensorMaxChannels);
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		params[i].key = String(i);
+		params[i].value = SensorRegistry::formatValue(descriptor, values[i]);
+	}
+
+	commandMgrLink.sendCommand(SensorRegistry::commandName(id), "", "", params, count);
+	return true;
 }
 
 void onComputerCommandReceived(SerialCommandManager* mgr)
@@ -0,0 +1,65 @@
+#include "SystemCommandHandler.h"
+
+SystemCommandHandler::SystemCommandHandler(TaskScheduler* scheduler)
+    : _scheduler(scheduler)
+{
+}
+
+const String* SystemCommandHandler::supportedCommands(size_t& count) const
+{
+    static const String cmds[] = { SystemTaskStats };
+    count = sizeof(cmds) / sizeof(cmds[0]);
+    return cmds;
+}
+
+bool SystemCommandHandler::handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount)
+{
+    String cmd = command;
+    cmd.trim();
+
+    if (cmd == SystemTaskStats)
+    {
+        if (!_scheduler)
+        {
+            sendAckErr(sender, cmd, F("Scheduler not configured"));
+            return true;
+        }
+
+        sendTaskStats(sender, cmd);
+
+        // optional v=1 clears the statistics after reporting
+        if (paramCount > 0 && params[0].value == "1")
+        {
+            _scheduler->resetStats();
+        }
+
+        sendAckOk(sender, cmd);
+    }
+    else
+    {
+        sendAckErr(sender, cmd, F("Unknown system command"));
+    }
+
+    return true;
+}
+
+void SystemCommandHandler::sendTaskStats(SerialCommandManager* sender, const String& cmd)
+{
+    // one line per task
+    for (uint8_t i = 0; i < _scheduler->getTaskCount(); i++)
+    {
+        const ScheduledTask* task = _scheduler->getTask(i);
+        uint32_t meanMicros = task->runCount ? task->totalMicros / task->runCount : 0;
+
+        StringKeyValue params[] = {
+            { F("t"), String(task->name) },
+            { F("n"), String(task->runCount) },
+            { F("us"), String(meanMicros) },
+            { F("usmax"), String(task->maxMicros) },
+            { F("late"), String(task->maxLateMs) },
+            { F("o"), String(task->overrunCount) }
+        };
+
+        sender->sendCommand(cmd, "", "", params, sizeof(params) / sizeof(params[0]));
+    }
+}
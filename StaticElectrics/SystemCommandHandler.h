@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Arduino.h>
+#include <TaskScheduler.h>
+#include "BaseCommandHandler.h"
+#include "StaticElectricConstants.h"
+
+// system commands from the computer, task timing statistics
+class SystemCommandHandler : public BaseCommandHandler
+{
+private:
+	TaskScheduler* _scheduler;
+
+	void sendTaskStats(SerialCommandManager* sender, const String& cmd);
+public:
+	explicit SystemCommandHandler(TaskScheduler* scheduler);
+
+	bool handleCommand(SerialCommandManager* sender, const String command, const StringKeyValue params[], int paramCount) override;
+	const String* supportedCommands(size_t& count) const override;
+};
@@ -0,0 +1,101 @@
+#include "WaterLevelSensor.h"
+
+WaterLevelSensor::WaterLevelSensor(uint8_t sensorPin, uint8_t powerPin, unsigned long intervalMs,
+	unsigned long settleMs, uint8_t oversample)
+	: _sensorPin(sensorPin), _powerPin(powerPin), _intervalMs(intervalMs), _settleMs(settleMs),
+	  _oversample(oversample > 0 ? oversample : 1),
+	  _state(WaterLevelState::Idle), _stateStartTime(0), _nextReadingTime(0),
+	  _samplesTaken(0), _sampleSum(0), _value(0)
+{
+}
+
+void WaterLevelSensor::begin(unsigned long now)
+{
+	pinMode(_powerPin, OUTPUT);
+	digitalWrite(_powerPin, LOW);
+
+	_nextReadingTime = now + _intervalMs;
+	setState(WaterLevelState::Idle, now);
+}
+
+void WaterLevelSensor::setOversample(uint8_t oversample)
+{
+	// applied from the next reading, a reading in progress keeps its count
+	if (_state == WaterLevelState::Idle)
+		_oversample = oversample > 0 ? oversample : 1;
+}
+
+void WaterLevelSensor::setInterval(unsigned long intervalMs)
+{
+	if (_state == WaterLevelState::Idle)
+		_nextReadingTime = _nextReadingTime - _intervalMs + intervalMs;
+
+	_intervalMs = intervalMs;
+}
+
+void WaterLevelSensor::setState(WaterLevelState state, unsigned long now)
+{
+	_state = state;
+	_stateStartTime = now;
+}
+
+unsigned long WaterLevelSensor::msUntilNextEvent(unsigned long now) const
+{
+	switch (_state)
+	{
+		case WaterLevelState::Idle:
+			return (long)(now - _nextReadingTime) >= 0 ? 0 : _nextReadingTime - now;
+
+		case WaterLevelState::Settling:
+			return now - _stateStartTime >= _settleMs ? 0 : _settleMs - (now - _stateStartTime);
+
+		default:
+			return 0;
+	}
+}
+
+bool WaterLevelSensor::update(unsigned long now)
+{
+	switch (_state)
+	{
+		case WaterLevelState::Idle:
+			// wrap safe deadline check
+			if ((long)(now - _nextReadingTime) < 0)
+				return false;
+
+			digitalWrite(_powerPin, HIGH);
+			setState(WaterLevelState::Settling, now);
+			return false;
+
+		case WaterLevelState::Settling:
+			if (now - _stateStartTime < _settleMs)
+				return false;
+
+			_samplesTaken = 0;
+			_sampleSum = 0;
+			setState(WaterLevelState::Sampling, now);
+			return false;
+
+		case WaterLevelState::Sampling:
+			// one conversion per call keeps each loop iteration short
+			_sampleSum += analogRead(_sensorPin);
+			_samplesTaken++;
+
+			if (_samplesTaken < _oversample)
+				return false;
+
+			digitalWrite(_powerPin, LOW);
+			_value = (int)((_sampleSum + _samplesTaken / 2) / _samplesTaken);
+
+			_nextReadingTime += _intervalMs;
+
+			// resynchronise rather than catch up if readings fell behind
+			if ((long)(now - _nextReadingTime) >= 0)
+				_nextReadingTime = now + _intervalMs;
+
+			setState(WaterLevelState::Idle, now);
+			return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+enum class WaterLevelState : uint8_t
+{
+	Idle,       // probe unpowered, waiting for the next reading
+	Settling,   // probe powered, waiting for the reading to settle
+	Sampling    // taking oversampled readings, one per update
+};
+
+// Water level probe powered only while it is read, to limit electrolysis.
+// Each reading powers the probe, waits for it to settle, averages a number
+// of analog samples and powers it off again. All waits are deadlines checked
+// from update(), so loop() is never blocked.
+class WaterLevelSensor
+{
+private:
+	uint8_t _sensorPin;
+	uint8_t _powerPin;
+	unsigned long _intervalMs;
+	unsigned long _settleMs;
+	uint8_t _oversample;
+
+	WaterLevelState _state;
+	unsigned long _stateStartTime;
+	unsigned long _nextReadingTime;
+	uint8_t _samplesTaken;
+	uint32_t _sampleSum;
+	int _value;
+
+	void setState(WaterLevelState state, unsigned long now);
+
+public:
+	WaterLevelSensor(uint8_t sensorPin, uint8_t powerPin, unsigned long intervalMs,
+		unsigned long settleMs = 10, uint8_t oversample = 4);
+
+	void begin(unsigned long now);
+
+	// Advances the sampling state machine, returns true when a new reading is available
+	bool update(unsigned long now);
+
+	// Milliseconds until update() has work to do
+	unsigned long msUntilNextEvent(unsigned long now) const;
+
+	int getValue() const { return _value; }
+	WaterLevelState getState() const { return _state; }
+
+	void setOversample(uint8_t oversample);
+
+	// Changes the time between readings, a reading already waiting is moved
+	void setInterval(unsigned long intervalMs);
+};
@@ -0,0 +1,189 @@
+//
+// Host simulation of the fuse box sensor publish policy.
+//
+// Feeds simulated readings through SensorPolicy with the real sensor table
+// (deadband, minimum interval and heartbeat per sensor) and counts how many
+// S<n> messages reach the link compared with sending every reading:
+// - an hour of steady cabin temperature with +-0.1 C noise, read every 5 s
+// - a temperature step, sent on the next reading and sampled fast after it
+// - battery voltage falling under load, sent each time it passes the deadband
+// - relay currents, one channel moving sends all of them
+// Readings are simulated, not recorded, the counts show the policy and
+// not any particular boat.
+//
+
+#include "../SensorPolicy.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// As the sketch reads the DHT11 and battery while nothing is moving
+constexpr unsigned long SlowIntervalMs = 5000;
+constexpr unsigned long FastIntervalMs = 2000;
+constexpr unsigned long HourMs = 3600000UL;
+
+static int failures = 0;
+
+static void check(bool condition, const char* name, double value)
+{
+    if (!condition)
+    {
+        printf("FAIL: %s (%.3f)\n", name, value);
+        failures++;
+    }
+}
+
+// Repeatable noise in [-amplitude, amplitude]
+static uint32_t noiseState = 12345;
+
+static float noise(float amplitude)
+{
+    noiseState = noiseState * 1103515245UL + 12345UL;
+    float unit = ((noiseState >> 8) & 0xFFFF) / 65535.0f;
+    return (unit * 2.0f - 1.0f) * amplitude;
+}
+
+static void testSteadyHour()
+{
+    SensorPolicy policy;
+    uint32_t readings = 0;
+    uint32_t sent = 0;
+
+    for (unsigned long now = 0; now < HourMs; now += SlowIntervalMs)
+    {
+        readings++;
+
+        if (policy.shouldPublish(SensorId::Temperature, 21.5f + noise(0.1f), now))
+            sent++;
+    }
+
+    printf("  steady hour: %u of %u temperature readings sent\n", static_cast<unsigned>(sent), static_cast<unsigned>(readings));
+
+    // one per 60 s heartbeat, noise stays inside the 0.3 C deadband
+    check(readings == 720, "steady hour readings", readings);
+    check(sent == 60, "steady hour sends", sent);
+    check(policy.getSuppressedCount() == readings - sent, "steady hour suppressed", policy.getSuppressedCount());
+}
+
+static void testStep()
+{
+    SensorPolicy policy;
+    unsigned long now = 0;
+    unsigned long interval = SlowIntervalMs;
+    uint32_t sent = 0;
+    uint32_t fastReadings = 0;
+    unsigned long stepSentAt = 0;
+
+    // ten minutes at 18 C, then the heater comes on and it settles at 21 C
+    for (; now < 1200000UL; now += interval)
+    {
+        float temperature = now < 600000UL ? 18.0f : 21.0f;
+        temperature += noise(0.1f);
+
+        if (policy.shouldPublish(SensorId::Temperature, temperature, now))
+        {
+            sent++;
+
+            if (stepSentAt == 0 && now >= 600000UL)
+                stepSentAt = now;
+        }
+
+        interval = policy.sampleIntervalMs(SensorId::Temperature, temperature, SlowIntervalMs, FastIntervalMs);
+
+        if (interval == FastIntervalMs && now >= 600000UL)
+            fastReadings++;
+    }
+
+    printf("  step: sent %lu ms after the step, %u sends, %u fast readings\n",
+        stepSentAt - 600000UL, static_cast<unsigned>(sent), static_cast<unsigned>(fastReadings));
+
+    check(stepSentAt == 600000UL, "step sent on the first reading after it", stepSentAt);
+    check(fastReadings == SensorFastSampleCount, "fast readings after the step", fastReadings);
+    // heartbeats at 0..540 s, the step, then heartbeats from 660 s
+    check(sent == 20, "sends over twenty minutes with one step", sent);
+}
+
+static void testDrain()
+{
+    SensorPolicy policy;
+    uint32_t readings = 0;
+    uint32_t sent = 0;
+    float lastSent = 0;
+    float worstLag = 0;
+
+    // windlass on the house battery, 1 V down over ten minutes, 0.05 V deadband
+    constexpr unsigned long DrainMs = 600000UL;
+    constexpr float StepVolts = 1.0f * SlowIntervalMs / DrainMs;
+
+    for (unsigned long now = 0; now < DrainMs; now += SlowIntervalMs)
+    {
+        float volts = 12.6f - 1.0f * now / DrainMs;
+        readings++;
+
+        if (policy.shouldPublish(SensorId::BatteryVoltage, volts, now))
+        {
+            sent++;
+            lastSent = volts;
+        }
+
+        if (lastSent - volts > worstLag)
+            worstLag = lastSent - volts;
+    }
+
+    printf("  drain: %u of %u battery readings sent, panel at most %.3f V behind\n",
+        static_cast<unsigned>(sent), static_cast<unsigned>(readings), worstLag);
+
+    // one send per deadband crossed, the panel never further behind than that
+    check(sent >= 18 && sent <= 21, "drain sends", sent);
+    check(worstLag <= 0.05f + StepVolts, "panel within the deadband", worstLag);
+}
+
+static void testChannels()
+{
+    SensorPolicy policy;
+    float amps[SensorMaxChannels] = { 0, 1.2f, 0, 0, 4.0f, 0, 0, 0 };
+
+    check(policy.shouldPublishChannels(SensorId::RelayCurrent, amps, SensorMaxChannels, 0), "first currents sent", 0);
+
+    amps[1] += 0.1f;
+    check(!policy.shouldPublishChannels(SensorId::RelayCurrent, amps, SensorMaxChannels, 1000), "small change held", amps[1]);
+
+    amps[4] += 1.0f;
+    check(policy.shouldPublishChannels(SensorId::RelayCurrent, amps, SensorMaxChannels, 2000), "one channel moving sends", amps[4]);
+
+    check(!policy.shouldPublishChannels(SensorId::RelayCurrent, amps, SensorMaxChannels, 3000), "steady currents held", 3000);
+    check(policy.shouldPublishChannels(SensorId::RelayCurrent, amps, SensorMaxChannels, 32000), "currents heartbeat", 32000);
+}
+
+static void testForceAndFormat()
+{
+    SensorPolicy policy;
+
+    check(policy.shouldPublish(SensorId::BatteryVoltage, 12.6f, 0), "first battery sent", 0);
+    check(!policy.shouldPublish(SensorId::BatteryVoltage, 12.6f, 100), "repeat held", 100);
+    check(policy.shouldPublish(SensorId::BatteryVoltage, 12.6f, 100, true), "forced send", 100);
+
+    const SensorDescriptor* battery = SensorRegistry::getDescriptor(SensorId::BatteryVoltage);
+    const SensorDescriptor* water = SensorRegistry::getDescriptor(SensorId::WaterLevel);
+
+    check(SensorRegistry::formatValue(battery, 12.346f) == "12.35", "battery two decimals", 12.346);
+    check(SensorRegistry::formatValue(water, 511.6f) == "512", "water level whole number", 511.6);
+    check(SensorRegistry::commandName(SensorId::RelayCurrent) == "S11", "command name", 11);
+}
+
+int main()
+{
+    printf("SensorPolicyTest\n");
+
+    testSteadyHour();
+    testStep();
+    testDrain();
+    testChannels();
+    testForceAndFormat();
+
+    if (failures)
+        return EXIT_FAILURE;
+
+    printf("SensorPolicyTest passed\n");
+    return EXIT_SUCCESS;
+}
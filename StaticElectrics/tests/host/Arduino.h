@@ -0,0 +1,42 @@
+#pragma once
+
+//
+// Just enough of the Arduino core for the fuse box's pure C++ parts to
+// build on the host. Not used by the sketch.
+//
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+template <typename T, typename U>
+inline auto min(const T& a, const U& b) -> decltype(a < b ? a : b)
+{
+    return a < b ? a : b;
+}
+
+class String
+{
+public:
+    String() {}
+    String(const char* text) : _text(text) {}
+    explicit String(char c) : _text(1, c) {}
+    explicit String(int value) : _text(std::to_string(value)) {}
+    explicit String(unsigned char value) : _text(std::to_string(value)) {}
+    explicit String(long value) : _text(std::to_string(value)) {}
+    explicit String(float value, unsigned int decimals = 2)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), value);
+        _text = buffer;
+    }
+
+    String operator+(const String& other) const { return String((_text + other._text).c_str()); }
+    bool operator==(const char* text) const { return _text == text; }
+    const char* c_str() const { return _text.c_str(); }
+
+private:
+    std::string _text;
+};
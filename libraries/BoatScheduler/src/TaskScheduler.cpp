@@ -0,0 +1,147 @@
+#include "TaskScheduler.h"
+
+TaskScheduler::TaskScheduler()
+    : _taskCount(0)
+{
+}
+
+int8_t TaskScheduler::addPeriodic(TaskCallback callback, unsigned long periodMs, const char* name, unsigned long firstDelayMs)
+{
+    if (periodMs == 0)
+        return InvalidTask;
+
+    return addTask(callback, periodMs, firstDelayMs, name, true);
+}
+
+int8_t TaskScheduler::addOneShot(TaskCallback callback, unsigned long delayMs, const char* name)
+{
+    return addTask(callback, 0, delayMs, name, delayMs != NoScheduledTask);
+}
+
+int8_t TaskScheduler::addTask(TaskCallback callback, unsigned long periodMs, unsigned long delayMs, const char* name, bool active)
+{
+    if (!callback || _taskCount >= MaxScheduledTasks)
+        return InvalidTask;
+
+    ScheduledTask& task = _tasks[_taskCount];
+    task.callback = callback;
+    task.name = name;
+    task.periodMs = periodMs;
+    task.nextRunMs = millis() + (active ? delayMs : 0);
+    task.active = active;
+
+    clearStats(task);
+
+    return _taskCount++;
+}
+
+void TaskScheduler::schedule(int8_t taskId, unsigned long delayMs)
+{
+    if (taskId < 0 || taskId >= _taskCount)
+        return;
+
+    if (delayMs == NoScheduledTask)
+    {
+        _tasks[taskId].active = false;
+        return;
+    }
+
+    _tasks[taskId].nextRunMs = millis() + delayMs;
+    _tasks[taskId].active = true;
+}
+
+void TaskScheduler::cancel(int8_t taskId)
+{
+    if (taskId >= 0 && taskId < _taskCount)
+        _tasks[taskId].active = false;
+}
+
+void TaskScheduler::run(unsigned long now)
+{
+    for (uint8_t i = 0; i < _taskCount; i++)
+    {
+        ScheduledTask& task = _tasks[i];
+
+        // wrap safe, deadline reached once the signed difference is no longer negative
+        if (task.active && (long)(now - task.nextRunMs) >= 0)
+        {
+            runTask(task, now);
+        }
+    }
+}
+
+void TaskScheduler::runTask(ScheduledTask& task, unsigned long now)
+{
+    unsigned long lateMs = now - task.nextRunMs;
+
+    if (lateMs > task.maxLateMs)
+        task.maxLateMs = lateMs;
+
+    if (task.periodMs > 0)
+    {
+        // skip whole missed periods but keep the original phase
+        unsigned long periods = lateMs / task.periodMs + 1;
+        task.overrunCount += periods - 1;
+        task.nextRunMs += periods * task.periodMs;
+    }
+    else
+    {
+        // one-shot, idle unless the callback schedules it again
+        task.active = false;
+    }
+
+    unsigned long startUs = micros();
+    task.callback(now);
+    unsigned long elapsedUs = micros() - startUs;
+
+    task.runCount++;
+    task.totalMicros += elapsedUs;
+
+    if (elapsedUs > task.maxMicros)
+        task.maxMicros = elapsedUs;
+}
+
+unsigned long TaskScheduler::msUntilNextRun(unsigned long now) const
+{
+    unsigned long earliest = NoScheduledTask;
+
+    for (uint8_t i = 0; i < _taskCount; i++)
+    {
+        const ScheduledTask& task = _tasks[i];
+
+        if (!task.active)
+            continue;
+
+        long remaining = (long)(task.nextRunMs - now);
+
+        if (remaining <= 0)
+            return 0;
+
+        if ((unsigned long)remaining < earliest)
+            earliest = remaining;
+    }
+
+    return earliest;
+}
+
+void TaskScheduler::resetStats()
+{
+    for (uint8_t i = 0; i < _taskCount; i++)
+    {
+        clearStats(_tasks[i]);
+    }
+}
+
+void TaskScheduler::clearStats(ScheduledTask& task)
+{
+    task.runCount = 0;
+    task.overrunCount = 0;
+    task.totalMicros = 0;
+    task.maxMicros = 0;
+    task.maxLateMs = 0;
+}
+
+const ScheduledTask* TaskScheduler::getTask(uint8_t taskId) const
+{
+    return taskId < _taskCount ? &_tasks[taskId] : nullptr;
+}
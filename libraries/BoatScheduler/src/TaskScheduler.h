@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Task slots are statically allocated, increase if more tasks are added
+constexpr uint8_t MaxScheduledTasks = 8;
+
+constexpr int8_t InvalidTask = -1;
+
+// Returned by msUntilNextRun() when no task is scheduled
+constexpr unsigned long NoScheduledTask = 0xFFFFFFFFUL;
+
+typedef void (*TaskCallback)(unsigned long now);
+
+/**
+ * @struct ScheduledTask
+ * @brief One task slot with its timing and run time accounting.
+ */
+struct ScheduledTask
+{
+    TaskCallback callback;
+    const char* name;
+    unsigned long periodMs;         // 0 for a one-shot task
+    unsigned long nextRunMs;
+    bool active;
+
+    uint32_t runCount;
+    uint32_t overrunCount;          // periods skipped because the task ran late
+    uint32_t totalMicros;
+    unsigned long maxMicros;
+    unsigned long maxLateMs;        // worst delay between deadline and run
+};
+
+/**
+ * @class TaskScheduler
+ * @brief Cooperative deadline scheduler for periodic and one-shot tasks.
+ *
+ * Call run() from loop(), every task whose deadline has passed is run once
+ * per call in the order it was added. Periodic deadlines advance from the
+ * previous deadline rather than the run time so they do not drift; if a
+ * task falls more than a period behind the missed periods are counted as
+ * overruns and it resynchronises to its original phase. One-shot tasks run
+ * once and stay idle until schedule() is called again.
+ *
+ * All deadline comparisons are wrap safe, millis() rolling over after 49
+ * days does not stall or burst any task.
+ *
+ * Usage:
+ * @code
+ * TaskScheduler scheduler;
+ *
+ * void publishSensors(unsigned long now) { ... }
+ *
+ * void setup() {
+ *     scheduler.addPeriodic(publishSensors, 600, "ui");
+ * }
+ *
+ * void loop() {
+ *     scheduler.run(millis());
+ * }
+ * @endcode
+ */
+class TaskScheduler
+{
+public:
+    TaskScheduler();
+
+    /**
+     * @brief Add a task that runs every periodMs.
+     * @param callback Function called with the current millis()
+     * @param periodMs Time between runs, must be greater than zero
+     * @param name Short name used in the statistics report
+     * @param firstDelayMs Delay before the first run
+     * @return Task id, or InvalidTask if there is no free slot
+     */
+    int8_t addPeriodic(TaskCallback callback, unsigned long periodMs, const char* name, unsigned long firstDelayMs = 0);
+
+    /**
+     * @brief Add a task that runs once after delayMs.
+     * @return Task id, or InvalidTask if there is no free slot
+     */
+    int8_t addOneShot(TaskCallback callback, unsigned long delayMs, const char* name);
+
+    /**
+     * @brief (Re)arm a task to run delayMs from now, NoScheduledTask leaves it idle.
+     */
+    void schedule(int8_t taskId, unsigned long delayMs);
+
+    /**
+     * @brief Stop a task until it is scheduled again.
+     */
+    void cancel(int8_t taskId);
+
+    /**
+     * @brief Run every task that is due.
+     * @param now Current time in milliseconds (from millis())
+     */
+    void run(unsigned long now);
+
+    /**
+     * @brief Time until the earliest active task is due.
+     * @return Milliseconds, 0 if a task is due, NoScheduledTask if none are active
+     */
+    unsigned long msUntilNextRun(unsigned long now) const;
+
+    /**
+     * @brief Clear the run time and overrun statistics of all tasks.
+     */
+    void resetStats();
+
+    uint8_t getTaskCount() const { return _taskCount; }
+    const ScheduledTask* getTask(uint8_t taskId) const;
+
+private:
+    int8_t addTask(TaskCallback callback, unsigned long periodMs, unsigned long delayMs, const char* name, bool active);
+    void runTask(ScheduledTask& task, unsigned long now);
+    static void clearStats(ScheduledTask& task);
+
+    ScheduledTask _tasks[MaxScheduledTasks];
+    uint8_t _taskCount;
+};
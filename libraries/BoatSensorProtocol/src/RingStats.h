@@ -0,0 +1,210 @@
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+
+/**
+ * @class RingStats
+ * @brief Fixed size window of the last N samples with running statistics.
+ *
+ * Sum and sum of squares are kept as samples come and go so mean and
+ * variance are O(1). They are re-summed from the window each time it wraps
+ * so float rounding cannot build up. Min and max are tracked with monotonic
+ * deques, amortised O(1) per sample. Median sorts a copy of the window and
+ * is only worth calling for small N.
+ *
+ * @tparam T Sample type
+ * @tparam N Window size, storage is sized at compile time
+ * @tparam TSum Accumulator, must hold N * max(T)^2
+ */
+template <typename T, uint8_t N, typename TSum = float>
+class RingStats
+{
+private:
+    struct Entry
+    {
+        T value;
+        uint16_t seq;
+    };
+
+    // monotonic deque, values decreasing (max) or increasing (min) from the front
+    struct Deque
+    {
+        Entry entries[N];
+        uint8_t head;
+        uint8_t count;
+    };
+
+    T _values[N];
+    uint8_t _head;
+    uint8_t _count;
+    uint16_t _seq;
+
+    TSum _sum;
+    TSum _sumSquares;
+
+    Deque _max;
+    Deque _min;
+
+    static Entry& at(Deque& deque, uint8_t i)
+    {
+        return deque.entries[(deque.head + i) % N];
+    }
+
+    static const Entry& at(const Deque& deque, uint8_t i)
+    {
+        return deque.entries[(deque.head + i) % N];
+    }
+
+    void pushDeque(Deque& deque, T value, bool keepLarger)
+    {
+        // samples that have left the window drop off the front
+        while (deque.count > 0 && (uint16_t)(_seq - at(deque, 0).seq) >= N)
+        {
+            deque.head = (deque.head + 1) % N;
+            deque.count--;
+        }
+
+        // samples that can never be the extreme again drop off the back
+        while (deque.count > 0)
+        {
+            T back = at(deque, deque.count - 1).value;
+
+            if (keepLarger ? back > value : back < value)
+                break;
+
+            deque.count--;
+        }
+
+        Entry& entry = at(deque, deque.count);
+        entry.value = value;
+        entry.seq = _seq;
+        deque.count++;
+    }
+
+    void resum()
+    {
+        _sum = 0;
+        _sumSquares = 0;
+
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            _sum += _values[i];
+            _sumSquares += (TSum)_values[i] * _values[i];
+        }
+    }
+
+public:
+    RingStats()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        _head = 0;
+        _count = 0;
+        _seq = 0;
+        _sum = 0;
+        _sumSquares = 0;
+        _max.head = _max.count = 0;
+        _min.head = _min.count = 0;
+    }
+
+    void push(T value)
+    {
+        if (_count == N)
+        {
+            T oldest = _values[_head];
+            _sum -= oldest;
+            _sumSquares -= (TSum)oldest * oldest;
+        }
+        else
+        {
+            _count++;
+        }
+
+        _values[_head] = value;
+        _sum += value;
+        _sumSquares += (TSum)value * value;
+
+        _seq++;
+        pushDeque(_max, value, true);
+        pushDeque(_min, value, false);
+
+        _head = (_head + 1) % N;
+
+        if (_head == 0)
+            resum();
+    }
+
+    uint8_t count() const { return _count; }
+    bool isEmpty() const { return _count == 0; }
+    bool isFull() const { return _count == N; }
+
+    T last() const
+    {
+        return _count ? _values[(_head + N - 1) % N] : T();
+    }
+
+    float mean() const
+    {
+        return _count ? (float)_sum / _count : 0;
+    }
+
+    // population variance of the window
+    float variance() const
+    {
+        if (_count < 2)
+            return 0;
+
+        float average = mean();
+        float result = (float)_sumSquares / _count - average * average;
+        return result > 0 ? result : 0;
+    }
+
+    float stdDev() const
+    {
+        return sqrtf(variance());
+    }
+
+    T minimum() const
+    {
+        return _count ? at(_min, 0).value : T();
+    }
+
+    T maximum() const
+    {
+        return _count ? at(_max, 0).value : T();
+    }
+
+    // middle value of the window, mean of the middle two when the count is even
+    float median() const
+    {
+        if (_count == 0)
+            return 0;
+
+        T sorted[N];
+
+        for (uint8_t i = 0; i < _count; i++)
+        {
+            T value = _values[i];
+            uint8_t j = i;
+
+            while (j > 0 && sorted[j - 1] > value)
+            {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+
+            sorted[j] = value;
+        }
+
+        uint8_t middle = _count / 2;
+
+        if (_count & 1)
+            return sorted[middle];
+
+        return ((float)sorted[middle - 1] + sorted[middle]) / 2;
+    }
+};
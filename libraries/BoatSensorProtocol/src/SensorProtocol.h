@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+
+//
+// Sensor ids and value formats of the S<n> link, shared by the fuse box
+// (StaticElectrics, sender) and the control panel (BoatControlPanel,
+// receiver) so the two ends cannot drift apart. Each sketch keeps its own
+// SensorRegistry table for what only that end needs (names, units and
+// typed events on the panel, publish policy on the fuse box), and takes
+// the wire format columns of each row from SensorFormats below.
+//
+// Add new sensors at the end, the id is the number in the command.
+//
+
+enum class SensorId : uint8_t
+{
+    Temperature = 0,            // cabin temperature from the fuse box DHT11
+    Humidity = 1,               // cabin humidity from the fuse box DHT11
+    Bearing = 2,                // compass heading
+    Direction = 3,              // compass point text (N, NNE, ...)
+    Speed = 4,                  // speed over ground
+    CompassTemperature = 5,     // compass sensor die temperature
+    WaterLevel = 6,             // bilge probe reading
+    WaterPumpActive = 7,        // bilge pump running
+    HornActive = 8,             // horn sounding
+    RateOfTurn = 9,             // degrees per minute, positive to starboard
+    BatteryVoltage = 10,        // house battery from the fuse box
+    RelayCurrent = 11           // load current per relay from the fuse box
+};
+
+constexpr uint8_t SensorCount = 12;
+
+// Most channels a Channels sensor sends in one command
+constexpr uint8_t SensorMaxChannels = 8;
+
+enum class SensorValueType : uint8_t
+{
+    Number,     // decimal value, v=12.5
+    Flag,       // 0 or 1
+    Text,       // passed on as text, e.g. a compass point
+    Channels    // one <channel>=<value> param per channel
+};
+
+/**
+ * @struct SensorFormat
+ * @brief How a sensor's value is carried on the link.
+ */
+struct SensorFormat
+{
+    SensorValueType type;
+    uint8_t decimals;           // decimals sent, and worth showing
+    float scale;                // sent value * scale gives the unit value
+};
+
+// Indexed by SensorId. Only read in constant initialisers of the sketches'
+// tables, so it takes no RAM of its own.
+constexpr SensorFormat SensorFormats[SensorCount] =
+{
+    { SensorValueType::Number, 1, 1.0f },       // Temperature
+    { SensorValueType::Number, 0, 1.0f },       // Humidity
+    { SensorValueType::Number, 0, 1.0f },       // Bearing
+    { SensorValueType::Text, 0, 1.0f },         // Direction
+    { SensorValueType::Number, 1, 1.0f },       // Speed
+    { SensorValueType::Number, 1, 1.0f },       // CompassTemperature
+    { SensorValueType::Number, 0, 1.0f },       // WaterLevel
+    { SensorValueType::Flag, 0, 1.0f },         // WaterPumpActive
+    { SensorValueType::Flag, 0, 1.0f },         // HornActive
+    { SensorValueType::Number, 1, 1.0f },       // RateOfTurn
+    { SensorValueType::Number, 2, 1.0f },       // BatteryVoltage
+    { SensorValueType::Channels, 2, 1.0f }      // RelayCurrent
+};